@@ -0,0 +1,205 @@
+/**
+ * @file blg_binaryLog.c
+ *   Deferred binary logging. Formatting text with printf & co is expensive on an eight Bit
+ * controller and the formatting code, in particular the floating point support, consumes
+ * a lot of flash ROM. This module makes a task only record the address of the format
+ * string, which resides in flash ROM, and the raw bytes of the arguments in a ring
+ * buffer. This takes a few dozens of CPU clock cycles plus the time to copy the arguments.
+ * The contents of the buffer are read by a task of low priority, which sends them e.g. to
+ * Serial. The rendering of the text is done on the host: The decoder
+ * code/tools/binaryLogDecoder/blgDecoder.c reads the format strings from the ELF file of
+ * the application.\n
+ *   A record consists of the start byte #BLG_RECORD_START, the 16 Bit address of the
+ * format string (little endian) and the arguments. The decoder knows the size of the
+ * arguments from the format string.
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   blg_writeRecord
+ *   blg_readLog
+ *   blg_getNoLostRecords
+ * Local functions
+ */
+
+/*
+ * Include files
+ */
+
+#include <Arduino.h>
+#include "rtos.h"
+#include "rtos_assert.h"
+#include "blg_binaryLog.h"
+
+
+/*
+ * Defines
+ */
+
+#if (BLG_SIZE_OF_LOG_BUFFER & (BLG_SIZE_OF_LOG_BUFFER-1)) != 0
+# error BLG_SIZE_OF_LOG_BUFFER needs to be a power of two
+#endif
+
+/** The mask, which implements the wrap around of the indexes into the buffer. */
+#define IDX_MASK    (BLG_SIZE_OF_LOG_BUFFER-1)
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The ring buffer, which holds the log records. */
+static uint8_t _logBuffer[BLG_SIZE_OF_LOG_BUFFER];
+
+/** The index of the next byte to write and to read. Both are accessed only inside critical
+    sections. */
+static uint16_t _idxWrite = 0
+              , _idxRead = 0;
+
+/** The number of records, which didn't fit into the buffer. */
+static uint16_t _noLostRecords = 0;
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Write a record into the log. The function is normally not called directly but through
+ * the macros blg_log0, blg_log1, etc.\n
+ *   The function may be called from any task and from an interrupt service routine. It
+ * doesn't touch the global interrupt enable flag.
+ *   @param fmtString
+ * The format string, which resides in flash ROM. Its address identifies the record.
+ *   @param pArgs
+ * The arguments of the format string as they are copied into the log.
+ *   @param sizeOfArgs
+ * The number of Byte at \a pArgs.
+ *   @remark
+ * If the buffer hasn't enough space the record is dropped and counted, see
+ * blg_getNoLostRecords. A record is never partially written.
+ */
+
+void blg_writeRecord(const char *fmtString, const void *pArgs, uint8_t sizeOfArgs)
+{
+    const uint8_t *pByte = (const uint8_t*)pArgs;
+    const uint8_t sreg = SREG;
+    cli();
+
+    uint16_t idxWrite = _idxWrite;
+    if(((_idxRead - idxWrite - 1) & IDX_MASK) >= 3u + sizeOfArgs)
+    {
+        _logBuffer[idxWrite] = BLG_RECORD_START;
+        idxWrite = (idxWrite+1) & IDX_MASK;
+        _logBuffer[idxWrite] = (uint8_t)(uint16_t)fmtString;
+        idxWrite = (idxWrite+1) & IDX_MASK;
+        _logBuffer[idxWrite] = (uint8_t)((uint16_t)fmtString >> 8);
+        idxWrite = (idxWrite+1) & IDX_MASK;
+
+        while(sizeOfArgs-- > 0)
+        {
+            _logBuffer[idxWrite] = *pByte++;
+            idxWrite = (idxWrite+1) & IDX_MASK;
+        }
+        _idxWrite = idxWrite;
+    }
+    else if(_noLostRecords < 0xffffu)
+        ++ _noLostRecords;
+
+    SREG = sreg;
+
+} /* End of blg_writeRecord */
+
+
+
+
+/**
+ * Copy the contents of the log into a buffer of the caller, e.g. to send them to Serial.
+ * The function is intended to be called regularly by a task of low priority. It may be
+ * called from the idle task.
+ *   @return
+ * Get the number of bytes, which have been copied to \a pDest. The copied bytes are
+ * removed from the log. Records may be split across calls of this function.
+ *   @param pDest
+ * The bytes are copied to this buffer.
+ *   @param sizeOfDest
+ * The size of \a pDest in Byte.
+ */
+
+uint16_t blg_readLog(uint8_t *pDest, uint16_t sizeOfDest)
+{
+    uint16_t noBytes = 0
+           , idxRead
+           , idxWrite;
+
+    cli();
+    idxRead = _idxRead;
+    idxWrite = _idxWrite;
+    sei();
+
+    /* Only this function modifies the read index; the buffer contents between read and
+       write index don't change meanwhile. */
+    while(idxRead != idxWrite  &&  noBytes < sizeOfDest)
+    {
+        *pDest++ = _logBuffer[idxRead];
+        idxRead = (idxRead+1) & IDX_MASK;
+        ++ noBytes;
+    }
+
+    cli();
+    _idxRead = idxRead;
+    sei();
+
+    return noBytes;
+
+} /* End of blg_readLog */
+
+
+
+
+/**
+ * Get the number of log records, which were lost because the buffer was full.
+ *   @return
+ * Get the number of lost records. The counter saturates at its implementation limit.
+ *   @param doReset
+ * If true, the counter is reset to null after reading.
+ */
+
+uint16_t blg_getNoLostRecords(boolean doReset)
+{
+    cli();
+    uint16_t noLostRecords = _noLostRecords;
+    if(doReset)
+        _noLostRecords = 0;
+    sei();
+
+    return noLostRecords;
+
+} /* End of blg_getNoLostRecords */
+
+
+
+
@@ -0,0 +1,114 @@
+#ifndef BLG_BINARYLOG_INCLUDED
+#define BLG_BINARYLOG_INCLUDED
+/**
+ * @file blg_binaryLog.h
+ * Definition of global interface of module blg_binaryLog.c
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+
+/*
+ * Defines
+ */
+
+/** The size of the log buffer in Byte. The value needs to be a power of two. An
+    application may override the default in its rtos.config.h. */
+#ifndef BLG_SIZE_OF_LOG_BUFFER
+# define BLG_SIZE_OF_LOG_BUFFER 256
+#endif
+
+/** The byte, which starts each record in the log. It isn't a printable character; the
+    decoder passes all bytes outside of records as they are. This permits to have the log
+    and plain text in the same output stream. */
+#define BLG_RECORD_START        0xa5
+
+
+/** \cond The format string is placed in flash ROM; its address is the identification of
+    the record. The arguments are integer promoted by the unary plus, this way the decoder
+    can derive their size from the format string alone: 4 Byte for long integers and
+    floating point values and 2 Byte for all others. */
+#define BLG_DECLARE_FMT(fmtString)                                                      \
+            static const char fmt_[] PROGMEM = fmtString;
+/** \endcond */
+
+/** Write a log record without arguments. */
+#define blg_log0(fmtString)                                                             \
+    {                                                                                   \
+        BLG_DECLARE_FMT(fmtString)                                                      \
+        blg_writeRecord(fmt_, NULL, 0);                                                 \
+    }
+
+/** Write a log record with one argument. See #blg_log3 for details. */
+#define blg_log1(fmtString, a)                                                          \
+    {                                                                                   \
+        BLG_DECLARE_FMT(fmtString)                                                      \
+        const struct __attribute__((packed)) {__typeof__(+(a)) a_;} args_ = {+(a)};     \
+        blg_writeRecord(fmt_, &args_, sizeof(args_));                                   \
+    }
+
+/** Write a log record with two arguments. See #blg_log3 for details. */
+#define blg_log2(fmtString, a, b)                                                       \
+    {                                                                                   \
+        BLG_DECLARE_FMT(fmtString)                                                      \
+        const struct __attribute__((packed))                                            \
+            {__typeof__(+(a)) a_; __typeof__(+(b)) b_;} args_ = {+(a), +(b)};           \
+        blg_writeRecord(fmt_, &args_, sizeof(args_));                                   \
+    }
+
+/** Write a log record with three arguments. The format string needs to be a string
+    literal; it is placed in flash ROM and never evaluated by the target. Its syntax is
+    the one of printf. The arguments are copied as they are into the log. String arguments
+    (%s) are not supported; only the address of the string would be logged. */
+#define blg_log3(fmtString, a, b, c)                                                    \
+    {                                                                                   \
+        BLG_DECLARE_FMT(fmtString)                                                      \
+        const struct __attribute__((packed))                                            \
+            {__typeof__(+(a)) a_; __typeof__(+(b)) b_; __typeof__(+(c)) c_;} args_ =    \
+                                                                {+(a), +(b), +(c)};     \
+        blg_writeRecord(fmt_, &args_, sizeof(args_));                                   \
+    }
+
+
+/*
+ * Global type definitions
+ */
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+/** Write a record into the log. Normally called through the macros blg_logN. */
+void blg_writeRecord(const char *fmtString, const void *pArgs, uint8_t sizeOfArgs);
+
+/** Copy the contents of the log into a buffer, e.g. for transmission via Serial. */
+uint16_t blg_readLog(uint8_t *pDest, uint16_t sizeOfDest);
+
+/** Get the number of log records, which were lost because of a full buffer. */
+uint16_t blg_getNoLostRecords(boolean doReset);
+
+
+#endif  /* BLG_BINARYLOG_INCLUDED */
@@ -0,0 +1,164 @@
+/**
+ * @file dcf_decimationFilter.c
+ *   Integer decimation filters for sensor data, which is sampled at interrupt rate. A
+ * task, which processes each sample, would need one wake-up per sample. It's cheaper to
+ * filter and decimate the samples directly in the interrupt service routine and to notify
+ * the task only once per output period.\n
+ *   The filter is a cascaded integrator-comb (CIC) filter of order N, 1..#DCF_MAX_ORDER,
+ * with decimation ratio R and differential delay one: N integrator stages run at input
+ * rate and N comb (differentiator) stages run at output rate. The filter of order one is
+ * the boxcar filter, i.e. the sum of the last R input samples, output every R-th sample.
+ * Higher orders improve the attenuation of the frequencies, which alias into the pass
+ * band, on cost of a longer settling time: The impulse response has N*(R-1)+1 samples.\n
+ *   No multiplication or division is used. The arithmetics is done in 32 Bit unsigned
+ * integers and relies on the modulo behavior of overflows in the integrators. The result
+ * is correct as long as it fits into 32 Bit: The gain of the filter is R to the power of
+ * N, so the number of Bits of the input plus N*log2(R) must not exceed 32. A 10 Bit ADC
+ * result permits e.g. N=3 with R=64 or N=2 with R=255. If R is a power of two, the result
+ * can be normalized by a right shift.\n
+ *   Execution time: The figures are estimated from the instruction sequences, which
+ * avr-gcc generates for the implementation; they have not been measured. A call of
+ * dcf_filterSample takes about 30 + 25*N CPU clock cycles, the comb stages add about 15 +
+ * 25*N cycles in every R-th call. Averaged per input sample the boxcar filter costs about
+ * 55 cycles and a filter of order three about 110 cycles, which is 3.4 respectively 6.9
+ * µs at 16 MHz.
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   dcf_initFilter
+ *   dcf_filterSample
+ * Local functions
+ */
+
+/*
+ * Include files
+ */
+
+#include <Arduino.h>
+#include "rtos_assert.h"
+#include "dcf_decimationFilter.h"
+
+
+/*
+ * Defines
+ */
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Initialize a filter object. All states are reset to null.
+ *   @param pFilter
+ * The filter object to initialize.
+ *   @param order
+ * The order of the filter, 1..#DCF_MAX_ORDER. #DCF_ORDER_BOXCAR selects the boxcar
+ * filter.
+ *   @param decimation
+ * The decimation ratio R, 1..255. The filter produces a result every R-th input sample.
+ *   @remark
+ * The first N-1 results after initialization are incomplete, they are produced while the
+ * filter settles.
+ */
+
+void dcf_initFilter(dcf_filter_t *pFilter, uint8_t order, uint8_t decimation)
+{
+    uint8_t idxStage;
+
+    ASSERT(order >= 1  &&  order <= DCF_MAX_ORDER  &&  decimation >= 1);
+
+    pFilter->order = order;
+    pFilter->decimation = decimation;
+    pFilter->cntDecimation = decimation;
+    for(idxStage=0; idxStage<DCF_MAX_ORDER; ++idxStage)
+    {
+        pFilter->integratorAry[idxStage] = 0;
+        pFilter->combDelayAry[idxStage] = 0;
+    }
+} /* End of dcf_initFilter */
+
+
+
+
+/**
+ * Process the next input sample. The function is intended to be called from an interrupt
+ * service routine or a task of high priority on each new sample.
+ *   @return
+ * Get true if a new result has been written to \a *pResult. This happens every R-th
+ * call, R being the decimation ratio of the filter.
+ *   @param pFilter
+ * The filter object.
+ *   @param sample
+ * The new input sample.
+ *   @param pResult
+ * The filter result is returned by reference. The gain of the filter is R to the power of
+ * N. *\a pResult is not touched if the function returns false.
+ */
+
+boolean dcf_filterSample(dcf_filter_t *pFilter, uint16_t sample, uint32_t *pResult)
+{
+    uint32_t *pState = &pFilter->integratorAry[0];
+    uint32_t x = sample;
+    uint8_t noStages = pFilter->order;
+
+    /* The integrator stages run at input rate. */
+    do
+    {
+        x += *pState;
+        *pState++ = x;
+    }
+    while(--noStages > 0);
+
+    if(--pFilter->cntDecimation != 0)
+        return false;
+    pFilter->cntDecimation = pFilter->decimation;
+
+    /* The comb stages run at output rate. */
+    pState = &pFilter->combDelayAry[0];
+    noStages = pFilter->order;
+    do
+    {
+        const uint32_t xDelayed = *pState;
+        *pState++ = x;
+        x -= xDelayed;
+    }
+    while(--noStages > 0);
+
+    *pResult = x;
+    return true;
+
+} /* End of dcf_filterSample */
+
+
+
+
@@ -0,0 +1,85 @@
+#ifndef DCF_DECIMATIONFILTER_INCLUDED
+#define DCF_DECIMATIONFILTER_INCLUDED
+/**
+ * @file dcf_decimationFilter.h
+ * Definition of global interface of module dcf_decimationFilter.c
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+
+/*
+ * Defines
+ */
+
+/** The maximum order of a filter. The RAM consumption of each filter object is 8 Byte per
+    order. An application may override the default in its rtos.config.h. */
+#ifndef DCF_MAX_ORDER
+# define DCF_MAX_ORDER  3
+#endif
+
+/** The order of a filter, which is a boxcar filter: The sum of the last R input samples is
+    output every R-th input sample. */
+#define DCF_ORDER_BOXCAR    1
+
+
+/*
+ * Global type definitions
+ */
+
+/** The state of a decimation filter. The object is initialized by dcf_initFilter and then
+    owned by the one task or interrupt service routine, which feeds the samples into it. */
+typedef struct
+{
+    /** The order of the filter, 1..#DCF_MAX_ORDER. */
+    uint8_t order;
+
+    /** The decimation ratio R. A result is produced every R-th input sample. */
+    uint8_t decimation;
+
+    /** The count down of input samples till the next result. */
+    uint8_t cntDecimation;
+
+    /** The states of the integrator stages. */
+    uint32_t integratorAry[DCF_MAX_ORDER];
+
+    /** The delay elements of the comb stages. */
+    uint32_t combDelayAry[DCF_MAX_ORDER];
+
+} dcf_filter_t;
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+/** Initialize a filter object. */
+void dcf_initFilter(dcf_filter_t *pFilter, uint8_t order, uint8_t decimation);
+
+/** Process the next input sample; returns true every R-th sample, together with a result. */
+boolean dcf_filterSample(dcf_filter_t *pFilter, uint16_t sample, uint32_t *pResult);
+
+
+#endif  /* DCF_DECIMATIONFILTER_INCLUDED */
@@ -0,0 +1,228 @@
+/**
+ * @file fxp_fixedPoint.c
+ *   Formatting of fixed point numbers. A number is represented by a scaled 16 Bit integer
+ * and a number of fractional digits, e.g. the integer 4711 with three fractional digits
+ * is the value 4.711. The functions write the number as right aligned text into a field of
+ * fixed width, which is what a display typically needs. They replace printf with
+ * floating point formats like "%5.3f": No floating point operation is used and the stdio
+ * library with floating point support doesn't need to be linked.\n
+ *   The digits are computed by successive subtraction of powers of ten; there's no
+ * division, which would be expensive on an eight Bit controller. The execution time is
+ * about 300 CPU clock cycles in the worst case.
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   fxp_formatUInt16
+ *   fxp_formatInt16
+ * Local functions
+ *   formatNumber
+ */
+
+/*
+ * Include files
+ */
+
+#include <Arduino.h>
+#include "rtos_assert.h"
+#include "fxp_fixedPoint.h"
+
+
+/*
+ * Defines
+ */
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The powers of ten, which are subtracted to find the digits of a 16 Bit number. */
+static const uint16_t _powerOfTenAry[4] PROGMEM = {10000u, 1000u, 100u, 10u};
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Common implementation of the signed and unsigned format functions.
+ *   @return
+ * Get \a pStr.
+ *   @param pStr
+ * The text is written into this character array. It needs to have room for \a width
+ * characters plus the terminating zero.
+ *   @param width
+ * The width of the field. The number is right aligned and padded with blanks. If it
+ * doesn't fit into the field, the field is filled with '#'.
+ *   @param value
+ * The magnitude of the number as scaled integer.
+ *   @param noFractDigits
+ * The number of fractional digits, 0..#FXP_MAX_NO_FRACT_DIGITS. The value is \a value
+ * divided by 10 to the power of \a noFractDigits.
+ *   @param isNegative
+ * If true, a minus sign is put in front of the number.
+ */
+
+static char *formatNumber( char *pStr
+                         , uint8_t width
+                         , uint16_t value
+                         , uint8_t noFractDigits
+                         , boolean isNegative
+                         )
+{
+    char digitAry[5];
+    uint8_t noDigits = 0
+          , idxPower;
+
+    ASSERT(noFractDigits <= FXP_MAX_NO_FRACT_DIGITS);
+
+    for(idxPower=0; idxPower<sizeof(_powerOfTenAry)/sizeof(_powerOfTenAry[0]); ++idxPower)
+    {
+        const uint16_t powerOfTen = pgm_read_word(&_powerOfTenAry[idxPower]);
+        char digit = '0';
+        while(value >= powerOfTen)
+        {
+            value -= powerOfTen;
+            ++ digit;
+        }
+
+        /* Leading zeros are suppressed but we need at least one digit in front of the
+           decimal point. */
+        if(digit != '0'  ||  noDigits > 0  ||  4-idxPower <= noFractDigits)
+            digitAry[noDigits++] = digit;
+    }
+    digitAry[noDigits++] = '0' + (char)value;
+
+    const uint8_t lenNumber = noDigits + (noFractDigits > 0? 1: 0) + (isNegative? 1: 0);
+    char *pC = pStr;
+    if(lenNumber > width)
+    {
+        while(width-- > 0)
+            *pC++ = '#';
+    }
+    else
+    {
+        uint8_t idxDigit;
+
+        width -= lenNumber;
+        while(width-- > 0)
+            *pC++ = ' ';
+        if(isNegative)
+            *pC++ = '-';
+        for(idxDigit=0; idxDigit<noDigits; ++idxDigit)
+        {
+            if(idxDigit == noDigits-noFractDigits)
+                *pC++ = '.';
+            *pC++ = digitAry[idxDigit];
+        }
+    }
+    *pC = '\0';
+
+    return pStr;
+
+} /* End of formatNumber */
+
+
+
+
+/**
+ * Format an unsigned fixed point number as right aligned text.
+ *   @return
+ * Get \a pStr.
+ *   @param pStr
+ * The text is written into this character array. It needs to have room for \a width
+ * characters plus the terminating zero.
+ *   @param width
+ * The width of the field. The number is right aligned and padded with blanks. If it
+ * doesn't fit into the field, the field is filled with '#'.
+ *   @param value
+ * The number as scaled integer.
+ *   @param noFractDigits
+ * The number of fractional digits, 0..#FXP_MAX_NO_FRACT_DIGITS. The value is \a value
+ * divided by 10 to the power of \a noFractDigits. fxp_formatUInt16(s, 5, 4711, 3) yields
+ * the same text as sprintf(s, "%5.3f", 4.711).
+ */
+
+char *fxp_formatUInt16( char *pStr
+                      , uint8_t width
+                      , uint16_t value
+                      , uint8_t noFractDigits
+                      )
+{
+    return formatNumber(pStr, width, value, noFractDigits, /* isNegative */ false);
+
+} /* End of fxp_formatUInt16 */
+
+
+
+
+/**
+ * Format a signed fixed point number as right aligned text.
+ *   @return
+ * Get \a pStr.
+ *   @param pStr
+ * The text is written into this character array. It needs to have room for \a width
+ * characters plus the terminating zero.
+ *   @param width
+ * The width of the field, including the minus sign of negative numbers. See
+ * fxp_formatUInt16.
+ *   @param value
+ * The number as scaled integer.
+ *   @param noFractDigits
+ * The number of fractional digits, 0..#FXP_MAX_NO_FRACT_DIGITS.
+ */
+
+char *fxp_formatInt16( char *pStr
+                     , uint8_t width
+                     , int16_t value
+                     , uint8_t noFractDigits
+                     )
+{
+    if(value < 0)
+    {
+        /* The cast handles the most negative number correctly. */
+        return formatNumber( pStr
+                           , width
+                           , (uint16_t)-(uint16_t)value
+                           , noFractDigits
+                           , /* isNegative */ true
+                           );
+    }
+    else
+    {
+        return formatNumber( pStr
+                           , width
+                           , (uint16_t)value
+                           , noFractDigits
+                           , /* isNegative */ false
+                           );
+    }
+} /* End of fxp_formatInt16 */
+
+
+
+
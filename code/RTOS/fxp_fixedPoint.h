@@ -0,0 +1,65 @@
+#ifndef FXP_FIXEDPOINT_INCLUDED
+#define FXP_FIXEDPOINT_INCLUDED
+/**
+ * @file fxp_fixedPoint.h
+ * Definition of global interface of module fxp_fixedPoint.c
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+
+/*
+ * Defines
+ */
+
+/** The maximum number of fractional digits, which is supported by the format functions. */
+#define FXP_MAX_NO_FRACT_DIGITS 4
+
+
+/*
+ * Global type definitions
+ */
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+/** Format an unsigned scaled integer as right aligned decimal number. */
+char *fxp_formatUInt16( char *pStr
+                      , uint8_t width
+                      , uint16_t value
+                      , uint8_t noFractDigits
+                      );
+
+/** Format a signed scaled integer as right aligned decimal number. */
+char *fxp_formatInt16( char *pStr
+                     , uint8_t width
+                     , int16_t value
+                     , uint8_t noFractDigits
+                     );
+
+
+#endif  /* FXP_FIXEDPOINT_INCLUDED */
@@ -26,23 +26,76 @@
  *   rtos_initRTOS (internally called only)
  *   rtos_enableIRQTimerTic (callback with local default implementation)
  *   rtos_enableIRQUser00 (callback without default implementation)
- *   rtos_enableIRQUser00 (callback without default implementation)
+ *   rtos_enableIRQUser01 (callback without default implementation)
  *   ISR(RTOS_ISR_SYSTEM_TIMER_TIC)
  *   ISR(RTOS_ISR_USER_00)
  *   ISR(RTOS_ISR_USER_01)
+ *   ISRs of RTOS_APPL_INTERRUPT_LIST
  *   rtos_sendEvent
  *   rtos_waitForEvent
+ *   rtos_waitForNextScheduleSlot
+ *   rtos_sendEventWithData
+ *   rtos_setEventDataFromISR
+ *   rtos_waitForEventWithData
+ *   rtos_getNoPostedEvents
  *   rtos_getTaskOverrunCounter
  *   rtos_getStackReserve
+ *   rtos_getTime
+ *   rtos_getTimestamp
+ *   __wrap_micros
+ *   __wrap_millis
+ *   __wrap_delay
+ *   rtos_onStackGuardViolation (callback with local default implementation)
+ *   rtos_scanStackReserve
+ *   rtos_getCachedStackReserve
+ *   rtos_postDeferredWork
+ *   rtos_deferredWorkTask
+ *   rtos_getNoLostDeferredWork
+ *   rtos_setTaskPriority
+ *   rtos_suspendTask
+ *   rtos_resumeTask
+ *   rtos_restartTask
+ *   rtos_setTaskOverrunPolicy
+ *   rtos_onTaskOverrun (callback with local default implementation)
+ *   rtos_getTaskStatistics
+ *   rtos_setTaskDeadline
+ *   rtos_getTaskDeadlineMissCounter
  * Local functions
  *   prepareTaskStack
+ *   onStackGuardViolation
+ *   readSystemTimerCnt
+ *   resetTimeSpanStatistics
+ *   addTimeSpanSample
+ *   recordTaskRelease
+ *   onTaskStart
+ *   recordTaskSuspend
+ *   findNextDeadline
+ *   armTaskDeadline
+ *   disarmTaskDeadline
  *   checkTaskForActivation
  *   lookForActiveTask
+ *   notifyTaskOverrun
+ *   handleTaskOverrun
+ *   isTaskInScheduleTable
+ *   releaseScheduledTasks
+ *   notifyDeadlineMiss
+ *   checkTaskDeadlines
  *   onTimerTic
  *   sendEvent
+ *   sendEventFromISR
+ *   putTaskIntoDueList
+ *   takeTaskOutOfDueList
+ *   putTaskIntoSuspendedList
+ *   takeTaskOutOfSuspendedList
+ *   setTaskPriority
+ *   controlTask
+ *   swiControlTask
  *   acquireFreeSyncObjs
  *   storeResumeCondition
  *   waitForEvent
+ *   initializeTask
+ *   initializeTaskList
+ *   paintTaskStack
  */
 
 
@@ -68,13 +121,71 @@
 
 /** A bit mask, which selects all the mutex events in an event vector. */
 #define MASK_EVT_IS_MUTEX                                                   \
-        (((0x0001u<<(RTOS_NO_MUTEX_EVENTS+RTOS_NO_SEMAPHORE_EVENTS))-1u)    \
-         - (uint16_t)MASK_EVT_IS_SEMAPHORE                                  \
+        ((RTOS_EVT(RTOS_NO_MUTEX_EVENTS+RTOS_NO_SEMAPHORE_EVENTS)-1u)       \
+         - (uintEventVec_t)MASK_EVT_IS_SEMAPHORE                            \
         )
 
 /** A bit mask, which selects all timer events in a vector of events. */
 #define MASK_EVT_IS_TIMER (RTOS_EVT_ABSOLUTE_TIMER | RTOS_EVT_DELAY_TIMER)
 
+/** The minimum size of the stack area of a task in Byte. */
+#define MIN_STACK_SIZE  50
+
+#ifdef RTOS_TASK_LIST
+/** \cond The optional elements of an entry of the task list are present only if the related
+    features are configured. */
+# if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON
+#  define TASK_LIST_ROUND_ROBIN(timeRoundRobin)     (timeRoundRobin),
+# else
+#  define TASK_LIST_ROUND_ROBIN(timeRoundRobin)
+# endif
+# if RTOS_USE_EDF_PRIO_CLASS == RTOS_FEATURE_ON
+#  define TASK_LIST_DEADLINE(timeDeadline)          (timeDeadline),
+# else
+#  define TASK_LIST_DEADLINE(timeDeadline)
+# endif
+# if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON                                    \
+     &&  RTOS_USE_EDF_PRIO_CLASS == RTOS_FEATURE_ON
+#  define IS_VALID_ROUND_ROBIN(prioClass, timeRoundRobin)                                  \
+            ((prioClass) != RTOS_EDF_PRIO_CLASS  ||  (timeRoundRobin) == 0)
+# else
+#  define IS_VALID_ROUND_ROBIN(prioClass, timeRoundRobin)   true
+# endif
+/** \endcond */
+#endif
+
+/** \cond Access to the invariant data of a task, which is not used by the scheduler. If the
+    tasks are configured by #RTOS_TASK_LIST, the data is read from the task table in flash
+    ROM and it is not held in the RAM task objects. The stack area is an exception if the
+    stack guard is configured: The check is made in every context switch and it uses a
+    copy in RAM. */
+#ifdef RTOS_TASK_LIST
+# define GET_TASK_FUNCTION(idxTask)                                                         \
+            ((rtos_taskFunction_t)pgm_read_word(&_taskListAry[idxTask].taskFunction))
+# define GET_STACK_AREA(idxTask)                                                            \
+            ((uint8_t*)pgm_read_word(&_taskListAry[idxTask].pStackArea))
+# define GET_STACK_SIZE(idxTask)    pgm_read_word(&_taskListAry[idxTask].stackSize)
+#else
+# define GET_TASK_FUNCTION(idxTask) (_taskAry[idxTask].taskFunction)
+# define GET_STACK_AREA(idxTask)    (_taskAry[idxTask].pStackArea)
+# define GET_STACK_SIZE(idxTask)    (_taskAry[idxTask].stackSize)
+#endif
+/** \endcond */
+
+/** \cond The number of counted events, i.e. the number of set bits in
+    #RTOS_COUNTED_EVENT_MASK. */
+#define CNT_BIT(n) ((((uint32_t)(RTOS_COUNTED_EVENT_MASK))>>(n)) & 1)
+#define NO_COUNTED_EVENTS                                                   \
+        (CNT_BIT(0) + CNT_BIT(1) + CNT_BIT(2) + CNT_BIT(3) + CNT_BIT(4)     \
+         + CNT_BIT(5) + CNT_BIT(6) + CNT_BIT(7) + CNT_BIT(8) + CNT_BIT(9)   \
+         + CNT_BIT(10) + CNT_BIT(11) + CNT_BIT(12) + CNT_BIT(13)            \
+         + CNT_BIT(14) + CNT_BIT(15) + CNT_BIT(16) + CNT_BIT(17)            \
+         + CNT_BIT(18) + CNT_BIT(19) + CNT_BIT(20) + CNT_BIT(21)            \
+         + CNT_BIT(22) + CNT_BIT(23) + CNT_BIT(24) + CNT_BIT(25)            \
+         + CNT_BIT(26) + CNT_BIT(27) + CNT_BIT(28) + CNT_BIT(29)            \
+        )
+/** \endcond */
+
 /** A pattern byte, which is used as prefill byte of any task stack area. A simple and
     inexpensive stack usage check at runtime can be implemented by looking for up to where
     this pattern has been destroyed. Any value which is not the null and which is
@@ -82,6 +193,84 @@
     be. */
 #define UNUSED_STACK_PATTERN 0x29
 
+/** The number of stack bytes, which are filled with the pattern byte by the idle task in
+    one cycle if #RTOS_LAZY_STACK_PAINTING is on. The bytes are written with globally
+    disabled interrupts. */
+#define STACK_PAINTING_CHUNK_SIZE   32
+
+#if RTOS_USE_TASK_CONTROL == RTOS_FEATURE_ON
+/** \cond The operations of the pseudo-software interrupt swiControlTask. */
+#define TASK_CONTROL_SUSPEND    0
+#define TASK_CONTROL_RESUME     1
+#define TASK_CONTROL_RESTART    2
+/** \endcond */
+
+/** \cond The states of a task with respect to rtos_suspendTask: Not halted, halted while
+    it was due or halted while it was suspended and waiting for events. */
+#define TASK_NOT_HALTED         0
+#define TASK_HALTED_WHILE_DUE   1
+#define TASK_HALTED_WHILE_WAITING 2
+/** \endcond */
+#endif
+
+/** The task object has a relative and an absolute deadline if it is needed by the EDF
+    priority class or by the deadline monitor. */
+#define TASK_HAS_DEADLINE   (RTOS_USE_EDF_PRIO_CLASS == RTOS_FEATURE_ON                    \
+                             ||  RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_ON              \
+                            )
+
+#if RTOS_USE_TASK_STATISTICS == RTOS_FEATURE_ON
+/** \cond The states of a task with respect to the measurement of its timing statistics:
+    Suspended or not yet measured, made due but not yet active and active since the
+    release. */
+#define STAT_STATE_IDLE         0
+#define STAT_STATE_RELEASED     1
+#define STAT_STATE_STARTED      2
+/** \endcond */
+
+/** Take the start latency sample when a task becomes active after a suspend command. The
+    macro is used inside macro PUSH_RET_CODE_OF_CONTEXT_SWITCH. */
+# define RECORD_TASK_START      {onTaskStart();}
+#else
+# define RECORD_TASK_START
+#endif
+
+#ifdef RTOS_SCHEDULE_TABLE
+/** \cond The number of entries of the schedule table. */
+#define COUNT_SCHEDULE_ENTRY(offset, idxTask)   +1
+#define NO_SCHEDULE_ENTRIES     (0 RTOS_SCHEDULE_TABLE(COUNT_SCHEDULE_ENTRY))
+/** \endcond */
+
+/** \cond Access to the entries of the schedule table in flash ROM. */
+#define GET_SCHEDULE_OFFSET(idxEntry)   pgm_read_word(&_scheduleTableAry[idxEntry].offset)
+#define GET_SCHEDULE_TASK(idxEntry)     pgm_read_byte(&_scheduleTableAry[idxEntry].idxTask)
+/** \endcond */
+#endif
+
+/** \cond The registers, which hold an event vector, when it is passed into or out of a
+    function: The argument of rtos_sendEvent and of a task function and the return value of
+    rtos_waitForEvent. These registers are the last ones of a saved context, so that the
+    return value of a suspend command can be pushed on top of the context of a suspended
+    task. A 16 Bit event vector occupies r24/r25, a 32 Bit event vector r22..r25; in the
+    latter case r22/r23 are taken out of the ordinary context registers. */
+#if RTOS_EVENT_VECTOR_WIDTH == 32
+# define ASM_PUSH_R22R23_OF_CONTEXT ""
+# define ASM_POP_R22R23_OF_CONTEXT  ""
+# define ASM_PUSH_EVENT_VEC_REGS    "push r22 \n\t" "push r23 \n\t"                        \
+                                    "push r24 \n\t" "push r25 \n\t"
+# define ASM_POP_EVENT_VEC_REGS     "pop r25 \n\t" "pop r24 \n\t"                          \
+                                    "pop r23 \n\t" "pop r22 \n\t"
+# define ASM_LOAD_EVENT_VEC_OP0     "ldi r22, lo8(%0) \n\t" "ldi r23, hi8(%0) \n\t"        \
+                                    "ldi r24, hlo8(%0) \n\t" "ldi r25, hhi8(%0) \n\t"
+#else
+# define ASM_PUSH_R22R23_OF_CONTEXT "push r22 \n\t" "push r23 \n\t"
+# define ASM_POP_R22R23_OF_CONTEXT  "pop r23 \n\t" "pop r22 \n\t"
+# define ASM_PUSH_EVENT_VEC_REGS    "push r24 \n\t" "push r25 \n\t"
+# define ASM_POP_EVENT_VEC_REGS     "pop r25 \n\t" "pop r24 \n\t"
+# define ASM_LOAD_EVENT_VEC_OP0     "ldi r24, lo8(%0) \n\t" "ldi r25, hi8(%0) \n\t"
+#endif
+/** \endcond */
+
 /** An important code pattern, which is used in every interrupt routine, which can result
     in a context switch. The CPU context except for the program counter is saved by pushing
     it onto the stack of the given context. The program counter is not explicitly saved:
@@ -96,8 +285,7 @@
 #define PUSH_CONTEXT_ONTO_STACK                     \
     PUSH_CONTEXT_WITHOUT_R24R25_ONTO_STACK;         \
     asm volatile                                    \
-    ( "push r24 \n\t"                               \
-      "push r25 \n\t"                               \
+    ( ASM_PUSH_EVENT_VEC_REGS                       \
     );
 /* End of macro PUSH_CONTEXT_ONTO_STACK */
 
@@ -113,6 +301,8 @@
       @remark The function which uses this pattern must not be inlined, otherwise the PC
     would not be part of the saved context and the system would crash when trying to return
     to this context the next time!
+      @remark With 32 Bit event vectors, the return code occupies r22..r25 and r22/r23 are
+    not saved either.
       @remark This pattern needs to be changed only in strict accordance with the
     counterpart pattern, which pops the context from a stack back into the CPU. */
 #define PUSH_CONTEXT_WITHOUT_R24R25_ONTO_STACK         \
@@ -141,8 +331,7 @@
       "push r19 \n\t"                                  \
       "push r20 \n\t"                                  \
       "push r21 \n\t"                                  \
-      "push r22 \n\t"                                  \
-      "push r23 \n\t"                                  \
+      ASM_PUSH_R22R23_OF_CONTEXT                       \
       "push r26 \n\t"                                  \
       "push r27 \n\t"                                  \
       "push r28 \n\t"                                  \
@@ -166,16 +355,14 @@
     the inverse of each other. */
 #define POP_CONTEXT_FROM_STACK          \
     asm volatile                        \
-    ( "pop r25 \n\t"                    \
-      "pop r24 \n\t"                    \
+    ( ASM_POP_EVENT_VEC_REGS            \
       "pop r31 \n\t"                    \
       "pop r30 \n\t"                    \
       "pop r29 \n\t"                    \
       "pop r28 \n\t"                    \
       "pop r27 \n\t"                    \
       "pop r26 \n\t"                    \
-      "pop r23 \n\t"                    \
-      "pop r22 \n\t"                    \
+      ASM_POP_R22R23_OF_CONTEXT         \
       "pop r21 \n\t"                    \
       "pop r20 \n\t"                    \
       "pop r19 \n\t"                    \
@@ -237,6 +424,55 @@
 
 
 
+#if RTOS_CHECK_STACK_GUARD == RTOS_FEATURE_ON
+/** A code pattern, which is used in every interrupt routine immediately after macro
+    SWITCH_CONTEXT. The stack pointer of the left task has just been saved; it is compared
+    against the guard zone at the end of the stack area of this task. The idle task is not
+    checked: Its stack area is not known to the kernel and it is registered as NULL, which
+    makes the condition never be true.\n
+      Side effects: The left task is read from the global variable _pSuspendedTask.\n
+      The implementation must be compatible with a naked function. In particular, it must
+    not define any local data! */
+# define CHECK_STACK_GUARD_OF_SUSPENDED_TASK                                                \
+{                                                                                           \
+    if(_pSuspendedTask->stackPointer                                                        \
+       < (uint16_t)_pSuspendedTask->pStackArea + RTOS_STACK_GUARD_SIZE                      \
+      )                                                                                     \
+    {                                                                                       \
+        onStackGuardViolation();                                                            \
+    }                                                                                       \
+} /* End of macro CHECK_STACK_GUARD_OF_SUSPENDED_TASK */
+#else
+# define CHECK_STACK_GUARD_OF_SUSPENDED_TASK
+#endif
+
+
+
+/** \cond The variable, which passes the return code of a suspend command to the assembler
+    code, and the code, which pushes it at the context positions of the event vector
+    registers. */
+#if RTOS_EVENT_VECTOR_WIDTH == 32
+# define TMP_VAR_C_TO_ASM_EVENT_VEC _tmpVarCToAsm_u32
+# define ASM_PUSH_TMP_VAR_EVENT_VEC                                                         \
+          "lds r0, _tmpVarCToAsm_u32 \n\t"      /* Read low byte of return code. */         \
+          "push r0 \n\t"                        /* Push it at context position r22. */      \
+          "lds r0, _tmpVarCToAsm_u32+1 \n\t"                                                \
+          "push r0 \n\t"                        /* Push it at context position r23. */      \
+          "lds r0, _tmpVarCToAsm_u32+2 \n\t"                                                \
+          "push r0 \n\t"                        /* Push it at context position r24. */      \
+          "lds r0, _tmpVarCToAsm_u32+3 \n\t"    /* Read high byte of return code. */        \
+          "push r0 \n\t"                        /* Push it at context position r25. */
+#else
+# define TMP_VAR_C_TO_ASM_EVENT_VEC _tmpVarCToAsm_u16
+# define ASM_PUSH_TMP_VAR_EVENT_VEC                                                         \
+          "lds r0, _tmpVarCToAsm_u16 \n\t"      /* Read low byte of return code. */         \
+          "push r0 \n\t"                        /* Push it at context position r24. */      \
+          "lds r0, _tmpVarCToAsm_u16+1 \n\t"    /* Read high byte of return code. */        \
+          "push r0 \n\t"                        /* Push it at context position r25. */
+#endif
+/** \endcond */
+
+
 /** An important code pattern, which is used in every interrupt routine (including the
     suspend commands, which can be considered pseudo-software interrupts). Placed
     immediately after a context switch, the code fragment decides whether the task we
@@ -260,7 +496,10 @@
        a task is suspended it always pauses inside the suspend command. */                  \
     if(_pActiveTask->postedEventVec > 0)                                                    \
     {                                                                                       \
-        _tmpVarCToAsm_u16 = _pActiveTask->postedEventVec;                                   \
+        /* The task starts a new activation, this completes its start latency. */           \
+        RECORD_TASK_START                                                                   \
+                                                                                            \
+        TMP_VAR_C_TO_ASM_EVENT_VEC = _pActiveTask->postedEventVec;                          \
                                                                                             \
         /* Neither at state changes active -> ready, and nor at changes ready ->            \
            active, the event vector is touched. It'll be set only at state changes          \
@@ -273,10 +512,7 @@
            Place this value onto the new stack and let it be loaded by the restore          \
            context operation below. */                                                      \
         asm volatile                                                                        \
-        ( "lds r0, _tmpVarCToAsm_u16 \n\t"      /* Read low byte of return code. */         \
-          "push r0 \n\t"                        /* Push it at context position r24. */      \
-          "lds r0, _tmpVarCToAsm_u16+1 \n\t"    /* Read high byte of return code. */        \
-          "push r0 \n\t"                        /* Push it at context position r25. */      \
+        ( ASM_PUSH_TMP_VAR_EVENT_VEC                                                        \
         );                                                                                  \
     } /* if(Do we need to place a suspend command's return code onto the new stack?) */     \
                                                                                             \
@@ -293,6 +529,83 @@
 /** \endcond */
 
 
+/** A code pattern, which defines an interrupt service routine, which posts an event. The
+    ISR is a stub of five machine instructions: It saves the register pair r24/r25, loads
+    it with the event vector and jumps into the code, which is shared by all of these ISRs,
+    see sendEventFromISR. (With 32 Bit event vectors, the stub saves and loads r22..r25 and
+    has nine instructions.) Therefore, the flash ROM consumption grows only slightly with
+    the number of application interrupts.\n
+      The macro is expanded once for each entry of the list of application interrupts.
+      @param vector
+    The name of the interrupt vector, e.g. TIMER3_COMPA_vect.
+      @param eventVec
+    The vector of events, which is posted on each occurrence of the interrupt. Any
+    constant expression is possible.
+      @param enableFct
+    The application supplied function, which enables the interrupt source. It is not used
+    here but in rtos_initRTOS. */
+#define DEFINE_ISR_TO_EVENT(vector, eventVec, enableFct)                                    \
+    ISR(vector, ISR_NAKED)                                                                  \
+    {                                                                                       \
+        asm volatile                                                                        \
+        ( ASM_PUSH_EVENT_VEC_REGS                                                           \
+          ASM_LOAD_EVENT_VEC_OP0                                                            \
+          "jmp LabelEntrySendEventFromISR \n\t"                                             \
+          : /* No output */                                                                 \
+          : "i" ((uintEventVec_t)(eventVec))                                                \
+        );                                                                                  \
+    } /* End of macro DEFINE_ISR_TO_EVENT */
+
+
+/** A code pattern, which defines an interrupt service routine, which executes an
+    application supplied top half and posts the events returned by the top half. The ISR is
+    a stub like the one of #DEFINE_ISR_TO_EVENT but the register pair r24/r25 is loaded
+    with the address of the top half. (avr-gcc prints a function as immediate operand as
+    gs(topHalfFct), which is the word address as required by icall.)
+      @param vector
+    The name of the interrupt vector, e.g. TIMER3_COMPA_vect.
+      @param topHalfFct
+    The application supplied function uintEventVec_t topHalfFct(void).
+      @param enableFct
+    The application supplied function, which enables the interrupt source. */
+#define DEFINE_ISR_TO_TOP_HALF(vector, topHalfFct, enableFct)                               \
+    ISR(vector, ISR_NAKED)                                                                  \
+    {                                                                                       \
+        asm volatile                                                                        \
+        ( ASM_PUSH_EVENT_VEC_REGS                                                           \
+          "ldi r24, lo8(%0) \n\t"                                                           \
+          "ldi r25, hi8(%0) \n\t"                                                           \
+          "jmp LabelEntryTopHalfFromISR \n\t"                                               \
+          : /* No output */                                                                 \
+          : "i" (topHalfFct)                                                                \
+        );                                                                                  \
+    } /* End of macro DEFINE_ISR_TO_TOP_HALF */
+
+
+/** The list of all application interrupts, see #RTOS_APPL_INTERRUPT_LIST. The two
+    pre-configured interrupts are handled as the first elements of the list. */
+#if RTOS_USE_APPL_INTERRUPT_00 == RTOS_FEATURE_ON
+# define APPL_INTERRUPT_00(ISR_TO_EVENT)                                                    \
+            ISR_TO_EVENT(RTOS_ISR_USER_00, RTOS_EVT_ISR_USER_00, rtos_enableIRQUser00)
+#else
+# define APPL_INTERRUPT_00(ISR_TO_EVENT)
+#endif
+#if RTOS_USE_APPL_INTERRUPT_01 == RTOS_FEATURE_ON
+# define APPL_INTERRUPT_01(ISR_TO_EVENT)                                                    \
+            ISR_TO_EVENT(RTOS_ISR_USER_01, RTOS_EVT_ISR_USER_01, rtos_enableIRQUser01)
+#else
+# define APPL_INTERRUPT_01(ISR_TO_EVENT)
+#endif
+#define ALL_APPL_INTERRUPTS(ISR_TO_EVENT, ISR_TO_TOP_HALF)                                  \
+            APPL_INTERRUPT_00(ISR_TO_EVENT)                                                 \
+            APPL_INTERRUPT_01(ISR_TO_EVENT)                                                 \
+            RTOS_APPL_INTERRUPT_LIST(ISR_TO_EVENT, ISR_TO_TOP_HALF)
+
+/** A code pattern, which calls the enable function of an application interrupt. The macro
+    is expanded once for each entry of the list of application interrupts. */
+#define CALL_ENABLE_FCT(vector, eventVec, enableFct)    enableFct();
+
+
 /*
  * Local type definitions
  */
@@ -305,7 +618,9 @@
     parts of them could be placed into a second array such that the remaining data
     structure had a size which is a power of 2. (Maybe with a few padding bytes.) This
     would speed-up - and maybe significantly - the address computations the kernel often has
-    to do when accessing the task information. */
+    to do when accessing the task information.\n
+      If the tasks are configured by #RTOS_TASK_LIST then these elements are not part of
+    the struct; they are read from the constant task table in flash ROM. */
 typedef struct
 {
     /** The saved stack pointer of this task whenever it is not active.\n
@@ -318,10 +633,12 @@ typedef struct
         possible priority and the lower the value the lower the priority. */
     uint8_t prioClass;
 
+#ifndef RTOS_TASK_LIST
     /** The task function as a function pointer. It is used once and only once: The task
         function is invoked the first time the task becomes active and must never end. A
         return statement would cause an immediate reset of the controller. */
     rtos_taskFunction_t taskFunction;
+#endif
 
     /** The timer value triggering the task local absolute-timer event. */
     uintTime_t timeDueAt;
@@ -337,15 +654,40 @@ typedef struct
     uintTime_t timeRoundRobin;
 #endif
 
+#if TASK_HAS_DEADLINE
+    /** The relative deadline of the task. If the task belongs to the priority class
+        #RTOS_EDF_PRIO_CLASS, it is due at latest this number of system timer tics after it
+        became due. The deadline monitor checks it for all tasks; null means no deadline. */
+    uintTime_t timeDeadline;
+
+    /** The absolute deadline of the task. It is computed each time the task becomes due
+        and it determines the position of the task in the list of due tasks of the EDF
+        priority class. */
+    uintTime_t timeDeadlineAt;
+#endif
+
+#if RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_ON
+    /** The task has been made due and its deadline has not been checked yet. The flag is
+        reset when the task suspends or when a miss is recognized by the system timer. */
+    boolean isDeadlineArmed;
+
+    /** The number of recognized deadline misses. The counter saturates at 255. */
+    uint8_t cntDeadlineMiss;
+#endif
+
+#if !defined(RTOS_TASK_LIST)  ||  RTOS_CHECK_STACK_GUARD == RTOS_FEATURE_ON
     /** The pointer to the preallocated stack area of the task. The area needs to be
         available all the RTOS runtime. Therefore dynamic allocation won't pay off. Consider
         to use the address of any statically defined array. There's no alignment
         constraint. */
     uint8_t *pStackArea;
+#endif
 
+#ifndef RTOS_TASK_LIST
     /** The size in Byte of the memory area \a *pStackArea, which is reserved as stack for
         the task. Each task may have an individual stack size. */
     uint16_t stackSize;
+#endif
 
     /** The timer tic decremented counter triggering the task local delay-timer event.\n
           The initial value determines at which system timer tic the task becomes due the
@@ -361,10 +703,10 @@ typedef struct
 #endif
 
     /** The events posted to this task. */
-    uint16_t postedEventVec;
+    uintEventVec_t postedEventVec;
 
     /** The mask of events which will make this task due. */
-    uint16_t eventMask;
+    uintEventVec_t eventMask;
 
     /** Do we need to wait for the first posted event or for all events? */
     boolean waitForAnyEvent;
@@ -379,32 +721,172 @@ typedef struct
         discussion in the documentation of type uintTime_t. */
     uint8_t cntOverrun;
 
+#if RTOS_INCREMENTAL_STACK_SCAN == RTOS_FEATURE_ON
+    /** The number of still unused stack bytes as found by the last complete scan of the
+        stack area of this task. Written only by the idle task. */
+    uint16_t stackReserve;
+#endif
+
+#if RTOS_COUNTED_EVENT_MASK != 0
+    /** The values of the global post counters of the counted events at the last recent
+        query by this task, see \a rtos_getNoPostedEvents. */
+    uint8_t cntSeenEventAry[NO_COUNTED_EVENTS];
+#endif
+
+#if RTOS_USE_EVENT_DATA == RTOS_FEATURE_ON
+    /** The mailbox of the task. It holds the data word of the last recent call of \a
+        rtos_sendEventWithData, which posted an event to the task while it was suspended. */
+    uint16_t eventData;
+#endif
+
+#if RTOS_USE_TASK_CONTROL == RTOS_FEATURE_ON
+    /** Has the task been taken out of scheduling by \a rtos_suspendTask? A halted task is
+        neither in the lists of due tasks nor in the list of suspended tasks. The value
+        records, which list it had been taken from. */
+    uint8_t haltState;
+
+    /** The system time, when the task had been halted while waiting for events. It is
+        evaluated at resume to find out whether the due time of the absolute timer has
+        passed meanwhile. */
+    uintTime_t timeHaltedAt;
+#endif
+
+#ifdef RTOS_SCHEDULE_TABLE
+    /** A time-triggered task has called \a rtos_waitForNextScheduleSlot and it waits for
+        its next entry in the schedule table. The flag is reset when the task is released.
+        If it is not set at an entry of the task, the task is still busy and an overrun is
+        counted. */
+    boolean isWaitingForScheduleSlot;
+#endif
+
+#if RTOS_USE_OVERRUN_POLICY == RTOS_FEATURE_ON
+    /** The reaction on a task overrun, see \a rtos_setTaskOverrunPolicy. */
+    uint8_t overrunPolicy;
+#endif
+
+#if RTOS_USE_TASK_STATISTICS == RTOS_FEATURE_ON
+    /** The time stamp of the point in time, when the task has been made due last time. */
+    uint32_t tiRelease;
+
+    /** Which time span of the current activation is still to be measured? One out of
+        STAT_STATE_IDLE, STAT_STATE_RELEASED and STAT_STATE_STARTED. */
+    uint8_t statState;
+#endif
+
 } task_t;
 
 
+#if RTOS_USE_DEFERRED_WORK == RTOS_FEATURE_ON
+/** An element of the deferred work queue. */
+typedef struct
+{
+    /** The function to execute. */
+    rtos_deferredWorkFunction_t workFunction;
+
+    /** The argument of the function. */
+    uint16_t arg;
+
+} deferredWork_t;
+#endif
+
+
+#ifdef RTOS_TASK_LIST
+/** An entry of the table of tasks, which is generated from #RTOS_TASK_LIST. It holds the
+    arguments of \a rtos_initializeTask for one task. */
+typedef struct
+{
+    /** The task function. */
+    rtos_taskFunction_t taskFunction;
+
+    /** The stack area of the task and its size in Byte. */
+    uint8_t *pStackArea;
+    uint16_t stackSize;
+
+    /** The priority class of the task. */
+    uint8_t prioClass;
+
+#if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON
+    /** The maximum execution time in round robin mode. */
+    uintTime_t timeRoundRobin;
+#endif
+
+#if RTOS_USE_EDF_PRIO_CLASS == RTOS_FEATURE_ON
+    /** The relative deadline of the task. */
+    uintTime_t timeDeadline;
+#endif
+
+    /** The start condition of the task. */
+    uintEventVec_t startEventMask;
+    boolean startByAllEvents;
+    uintTime_t startTimeout;
+
+} taskListEntry_t;
+#endif
+
+
+#ifdef RTOS_SCHEDULE_TABLE
+/** An entry of the schedule table, which is generated from #RTOS_SCHEDULE_TABLE. */
+typedef struct
+{
+    /** The phase in the hyperperiod in system timer tics, at which the task is released. */
+    uint16_t offset;
+
+    /** The index of the released task. */
+    uint8_t idxTask;
+
+} scheduleEntry_t;
+#endif
+
+
 
 /*
  * Local prototypes
  */
 
 RTOS_DEFAULT_FCT void rtos_enableIRQTimerTic(void);
+#if RTOS_PROVIDE_ARDUINO_TIME == RTOS_FEATURE_ON
+extern "C" unsigned long __real_micros(void);
+extern "C" unsigned long __real_millis(void);
+#endif
+#if RTOS_CHECK_STACK_GUARD == RTOS_FEATURE_ON
+RTOS_DEFAULT_FCT void rtos_onStackGuardViolation(uint8_t idxTask);
+static RTOS_TRUE_FCT void onStackGuardViolation(void);
+#endif
+#if RTOS_USE_OVERRUN_POLICY == RTOS_FEATURE_ON
+RTOS_DEFAULT_FCT void rtos_onTaskOverrun(uint8_t idxTask);
+#endif
+#if RTOS_USE_TASK_STATISTICS == RTOS_FEATURE_ON
+static RTOS_TRUE_FCT void onTaskStart(void);
+#endif
 static RTOS_TRUE_FCT boolean onTimerTic(void);
-static RTOS_TRUE_FCT boolean sendEvent(uint16_t eventVec);
-RTOS_NAKED_FCT void rtos_sendEvent(uint16_t eventVec);
+static RTOS_TRUE_FCT boolean sendEvent(uintEventVec_t eventVec);
+static RTOS_NAKED_FCT RTOS_TRUE_FCT void sendEventFromISR(uintEventVec_t eventVec);
+RTOS_NAKED_FCT void rtos_sendEvent(uintEventVec_t eventVec);
+#if RTOS_USE_SET_TASK_PRIORITY == RTOS_FEATURE_ON
+static RTOS_TRUE_FCT boolean setTaskPriority(uint8_t idxTask, uint8_t prioClass);
+RTOS_NAKED_FCT void rtos_setTaskPriority(uint8_t idxTask, uint8_t prioClass);
+#endif
+#if RTOS_USE_TASK_CONTROL == RTOS_FEATURE_ON
+static RTOS_TRUE_FCT boolean controlTask(uint8_t idxTask, uint8_t operation);
+static RTOS_NAKED_FCT RTOS_TRUE_FCT void swiControlTask(uint8_t idxTask, uint8_t operation);
+#endif
 
 #if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
-static RTOS_TRUE_FCT boolean waitForEvent( uint16_t eventMask
+static RTOS_TRUE_FCT boolean waitForEvent( uintEventVec_t eventMask
                                            , boolean all
                                            , uintTime_t timeout
                                            );
 #else
-static RTOS_TRUE_FCT void waitForEvent(uint16_t eventMask, boolean all, uintTime_t timeout);
+static RTOS_TRUE_FCT void waitForEvent( uintEventVec_t eventMask
+                                       , boolean all
+                                       , uintTime_t timeout
+                                       );
 #endif
 
-RTOS_NAKED_FCT uint16_t rtos_waitForEvent( uint16_t eventMask
-                                         , boolean all
-                                         , uintTime_t timeout
-                                         );
+RTOS_NAKED_FCT uintEventVec_t rtos_waitForEvent( uintEventVec_t eventMask
+                                               , boolean all
+                                               , uintTime_t timeout
+                                               );
 
 
 /*
@@ -413,7 +895,7 @@ RTOS_NAKED_FCT uint16_t rtos_waitForEvent( uint16_t eventMask
 
 /** The RTuinOS startup message is placed in the flash ROM. Here, memory is not expensive.
     Consider to use \a Serial.println or \a puts_progmem to print such a string in the
-    Arduino console window. Or Please refer to tc12/stdout.c, test case tc12, for more.\n
+    Arduino console window. Or Please refer to stdout.c, used by test case tc12, for more.\n
       See http://gcc.gnu.org/bugzilla/show_bug.cgi?id=34734 why not using PROGMEM for the
     declaration and #RTOS_PROGMEM_SECTION for a valid substitute.
       @see int puts_progmem(const char *) */
@@ -427,6 +909,28 @@ RTOS_PROGMEM_SECTION const char rtos_rtuinosStartupMsg[] = "\r" RTOS_RTUINOS_STA
     which is transparent and predictable for the application. */
 static uintTime_t _time = (uintTime_t)-1;
 
+#if RTOS_USE_CTC_SYSTEM_TIMER == RTOS_FEATURE_ON
+/** The time stamp at the beginning of the current system timer tic. The unit is the clock
+    tic of the system timer, see #RTOS_TIMESTAMP_UNIT. The counter is interrupt driven and
+    cyclic. */
+static uint32_t _timestampAtTic = 0;
+#endif
+
+#if RTOS_PROVIDE_ARDUINO_TIME == RTOS_FEATURE_ON
+/** The Arduino time functions are taken over by RTuinOS when the system timer is started.
+    Before, the original implementation is used. */
+static boolean _isArduinoTimeProvided = false;
+
+/** The Arduino time in us at the beginning of the current system timer tic. */
+static uint32_t _microsAtTic;
+
+/** The Arduino time in ms at the beginning of the current system timer tic. */
+static uint32_t _millisAtTic;
+
+/** The fraction of a millisecond, which is not yet accounted in _millisAtTic. Unit is us. */
+static uint16_t _fractMillisAtTic;
+#endif
+
 /** Array of all the task objects. The array has one additional element to store the
     information about the implicitly defined idle task. (Although most fields of the task
     object are irrelevant for the idle task. Here is potential to save memory space.)\n
@@ -462,13 +966,198 @@ static uint8_t _noSuspendedTasks;
 #if RTOS_USE_MUTEX == RTOS_FEATURE_ON
 /** All of the mutex events are combined in a bit vector. The mutexes are initially
     released, all according bits are set. All remaining bits are don't care bits. */
-static uint16_t _mutexVec = MASK_EVT_IS_MUTEX;
+static uintEventVec_t _mutexVec = MASK_EVT_IS_MUTEX;
 #endif
 
 /** Temporary data, internally used to pass information between assembly and C code. */
 volatile uint16_t _tmpVarAsmToC_u16;
 /** Temporary data, internally used to pass information between C and assembly code. */
 volatile uint16_t _tmpVarCToAsm_u16;
+#if RTOS_EVENT_VECTOR_WIDTH == 32
+/** Temporary data, internally used to pass a 32 Bit event vector to assembly code. */
+volatile uint32_t _tmpVarCToAsm_u32;
+#endif
+
+#if RTOS_INCREMENTAL_STACK_SCAN == RTOS_FEATURE_ON
+/** The index of the task, whose stack is currently inspected by the stack usage monitor. */
+static uint8_t _idxTaskStackScan = 0;
+
+/** The position inside the stack area of task _idxTaskStackScan, where the stack usage
+    monitor continues its scan at next invocation. */
+static uint16_t _offsStackScan = 0;
+#endif
+
+#if RTOS_LAZY_STACK_PAINTING == RTOS_FEATURE_ON
+/** The stacks are filled with the pattern byte in order of the task index. All tasks with
+    lower index than this one have a completely filled stack area. */
+static uint8_t _idxTaskStackPaint = 0;
+
+/** The position inside the stack area of task _idxTaskStackPaint, where the filling
+    continues in the next cycle of the idle task. */
+static uint16_t _offsStackPaint = 0;
+#endif
+
+#ifdef RTOS_SCHEDULE_TABLE
+/** The current phase in the hyperperiod of the schedule table. The first system timer tic
+    advances it to null. */
+static uint16_t _phaseSchedule = RTOS_SCHEDULE_HYPERPERIOD-1;
+
+/** The index of the next entry of the schedule table, which will release a task. */
+static uint8_t _idxScheduleEntry = 0;
+#endif
+
+#if RTOS_USE_OVERRUN_POLICY == RTOS_FEATURE_ON
+/** The event #RTOS_EVT_TASK_OVERRUN, if a task overrun has been recognized and not yet
+    been received by any task, or null otherwise. The event is posted by the system timer
+    interrupt; it is kept pending until at least one suspended task waits for it. */
+static uintEventVec_t _overrunEventToPost = 0;
+#endif
+
+#if RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_ON
+/** The event #RTOS_EVT_DEADLINE_MISS, if a deadline miss has been recognized and not yet
+    been received by any task, or null otherwise. The event is posted by the system timer
+    interrupt; it is kept pending until at least one suspended task waits for it. */
+static uintEventVec_t _deadlineMissEventToPost = 0;
+
+/** The task with the earliest armed deadline or NULL if no deadline is armed. It is
+    maintained only if #RTOS_EVT_DEADLINE_MISS is configured; the system timer interrupt
+    then needs to check only this single deadline. */
+static task_t *_pTaskNextDeadline = NULL;
+#endif
+
+#if RTOS_USE_TASK_STATISTICS == RTOS_FEATURE_ON
+/** The timing statistics of all tasks. They are updated with globally disabled interrupts
+    and read by \a rtos_getTaskStatistics. */
+static rtos_taskStatistics_t _taskStatisticsAry[RTOS_NO_TASKS];
+#endif
+
+#if RTOS_USE_DEFERRED_WORK == RTOS_FEATURE_ON
+/** The ring buffer of pending work items. */
+static deferredWork_t _deferredWorkQueue[RTOS_DEFERRED_WORK_QUEUE_SIZE];
+
+/** The index of the next element to write and to read. The write index is shared between
+    all posting contexts and accessed only with globally disabled interrupts; the read
+    index is owned by the worker task. */
+static volatile uint8_t _idxWriteDeferredWork = 0
+                      , _idxReadDeferredWork = 0;
+
+/** The number of work items, which couldn't be posted because of a full queue. */
+static uint8_t _noLostDeferredWork = 0;
+#endif
+
+#if RTOS_COUNTED_EVENT_MASK != 0
+/** The free running post counters of the counted events. Element i belongs to the i-th
+    set bit of #RTOS_COUNTED_EVENT_MASK. The counters are incremented regardless of the
+    state of the receiving tasks; each task keeps its own copy of the values it has already
+    seen. */
+static volatile uint8_t _cntPostedEventAry[NO_COUNTED_EVENTS];
+#endif
+
+#if RTOS_USE_EVENT_DATA == RTOS_FEATURE_ON
+/** The data word, which is passed from \a rtos_sendEventWithData to sendEvent, and the
+    flag, which tells sendEvent that the current call has a data word at all. Both are
+    accessed only with globally disabled interrupts. */
+static uint16_t _eventDataToPost;
+static boolean _isEventDataToPost = false;
+#endif
+
+#ifdef RTOS_TASK_LIST
+/** \cond The stack areas of the tasks of #RTOS_TASK_LIST. */
+#define TASK_STACK( taskFunction, prioClass, timeRoundRobin, timeDeadline, stackSize       \
+                  , startEventMask, startByAllEvents, startTimeout                         \
+                  )                                                                        \
+            static uint8_t _taskStack_##taskFunction[stackSize];
+RTOS_TASK_LIST(TASK_STACK)
+#undef TASK_STACK
+
+/* The task list is validated at compile time. A violated condition leads to an array of
+   negative size; the name of the array tells what's wrong with which task. The number of
+   tasks per priority class can't be checked this way, see initializeTaskList. */
+#define CHECK_TASK( taskFunction, prioClass, timeRoundRobin, timeDeadline, stackSize       \
+                  , startEventMask, startByAllEvents, startTimeout                         \
+                  )                                                                        \
+            typedef char prioClassOutOfRange_##taskFunction                                \
+                    [(prioClass) < RTOS_NO_PRIO_CLASSES? 1: -1];                           \
+            typedef char stackAreaTooSmall_##taskFunction                                  \
+                    [(stackSize) >= MIN_STACK_SIZE? 1: -1];                                \
+            typedef char badStartCondition_##taskFunction                                  \
+                    [(startEventMask) != 0                                                 \
+                     &&  ((startEventMask) & (MASK_EVT_IS_MUTEX | MASK_EVT_IS_SEMAPHORE))  \
+                         == 0                                                              \
+                     &&  ((startEventMask) & MASK_EVT_IS_TIMER) != MASK_EVT_IS_TIMER       \
+                     ? 1: -1                                                               \
+                    ];                                                                     \
+            typedef char roundRobinInEdfClass_##taskFunction                               \
+                    [IS_VALID_ROUND_ROBIN(prioClass, timeRoundRobin)? 1: -1];
+RTOS_TASK_LIST(CHECK_TASK)
+#undef CHECK_TASK
+
+/* The initializer expression of the table of tasks. */
+#define TASK_LIST_ENTRY( taskFunction, prioClass, timeRoundRobin, timeDeadline, stackSize  \
+                       , startEventMask, startByAllEvents, startTimeout                    \
+                       )                                                                   \
+            { /* taskFunction */     taskFunction                                          \
+            , /* pStackArea */       &_taskStack_##taskFunction[0]                         \
+            , /* stackSize */        (stackSize)                                           \
+            , /* prioClass */        (prioClass)                                           \
+            , TASK_LIST_ROUND_ROBIN(timeRoundRobin)                                        \
+              TASK_LIST_DEADLINE(timeDeadline)                                             \
+              /* startEventMask */   (startEventMask)                                      \
+            , /* startByAllEvents */ (startByAllEvents)                                    \
+            , /* startTimeout */     (startTimeout)                                        \
+            },
+/** \endcond */
+
+/** The table of all tasks of #RTOS_TASK_LIST. It is constant and placed in the flash ROM;
+    \a rtos_initRTOS initializes the task objects from this table prior to calling \a
+    setup. */
+static RTOS_PROGMEM_SECTION const taskListEntry_t _taskListAry[RTOS_NO_TASKS] =
+    { RTOS_TASK_LIST(TASK_LIST_ENTRY) };
+#undef TASK_LIST_ENTRY
+#endif
+
+#ifdef RTOS_SCHEDULE_TABLE
+/* The schedule table is validated at compile time. A violated condition leads to an array
+   of negative size. */
+#define COUNT_BAD_SCHEDULE_ENTRY(offset, idxTask)                                          \
+            + ((offset) >= RTOS_SCHEDULE_HYPERPERIOD  ||  (idxTask) >= RTOS_NO_TASKS)
+typedef char scheduleHyperperiodOutOfRange
+             [RTOS_SCHEDULE_HYPERPERIOD >= 1  &&  RTOS_SCHEDULE_HYPERPERIOD <= 0xffff
+              &&  (uintTime_t)(RTOS_SCHEDULE_HYPERPERIOD) == RTOS_SCHEDULE_HYPERPERIOD
+              ? 1: -1
+             ];
+typedef char scheduleEntryOffsetOrTaskOutOfRange
+             [(0 RTOS_SCHEDULE_TABLE(COUNT_BAD_SCHEDULE_ENTRY)) == 0? 1: -1];
+typedef char tooManyScheduleEntries[NO_SCHEDULE_ENTRIES <= 255? 1: -1];
+#undef COUNT_BAD_SCHEDULE_ENTRY
+
+/* The entries need to be sorted by offset; only the next entry is compared with the phase
+   of the hyperperiod. The table is folded into a nested conditional expression, which
+   carries the offset of the previous entry. An entry out of order replaces it with the
+   hyperperiod, which is greater than any valid offset and which is kept till the end. */
+#define OPEN_SCHEDULE_ENTRY(offset, idxTask)    (
+#define FOLD_SCHEDULE_ENTRY(offset, idxTask)                                               \
+            <= (offset)? (offset): RTOS_SCHEDULE_HYPERPERIOD)
+typedef char scheduleEntriesNotSortedByOffset
+             [(RTOS_SCHEDULE_TABLE(OPEN_SCHEDULE_ENTRY) 0
+               RTOS_SCHEDULE_TABLE(FOLD_SCHEDULE_ENTRY)
+              ) < RTOS_SCHEDULE_HYPERPERIOD
+              ? 1: -1
+             ];
+#undef OPEN_SCHEDULE_ENTRY
+#undef FOLD_SCHEDULE_ENTRY
+
+/** \cond The initializer expression of the schedule table. */
+#define SCHEDULE_TABLE_ENTRY(offset, idxTask)                                              \
+            { /* offset */ (offset), /* idxTask */ (idxTask) },
+/** \endcond */
+
+/** The schedule table of the time-triggered tasks. It is constant and placed in the flash
+    ROM. */
+static RTOS_PROGMEM_SECTION const scheduleEntry_t _scheduleTableAry[NO_SCHEDULE_ENTRIES] =
+    { RTOS_SCHEDULE_TABLE(SCHEDULE_TABLE_ENTRY) };
+#undef SCHEDULE_TABLE_ENTRY
+#endif
 
 
 /*
@@ -557,9 +1246,14 @@ static uint8_t *prepareTaskStack( uint8_t * const pEmptyTaskStack
        contexts of suspended tasks (including this one, which is a new one), the registers
        r25/r25 are not part of the context: The values of these registers will be loaded
        explicitly with the result of the suspend command immediately before the return to
-       the task. */
+       the task. The same holds for r22/r23 if the event vector has 32 Bit. */
+#if RTOS_EVENT_VECTOR_WIDTH == 32
+    for(r=2; r<=21; ++r)
+        * sp-- = 0;
+#else
     for(r=2; r<=23; ++r)
         * sp-- = 0;
+#endif
     for(r=26; r<=31; ++r)
         * sp-- = 0;
 
@@ -568,12 +1262,8 @@ static uint8_t *prepareTaskStack( uint8_t * const pEmptyTaskStack
        stack pointer. */
     retCode = sp;
 
-    /* The rest of the stack area doesn't matter. Nonetheless, we fill it with a specific
-       pattern, which will permit to run a (a bit guessing) stack usage routine later on:
-       We can look up to where the pattern has been destroyed. */
-    while(sp >= pEmptyTaskStack)
-        * sp-- = UNUSED_STACK_PATTERN;
-
+    /* The rest of the stack area doesn't matter. It is filled with the pattern byte for
+       the stack usage functions by the caller. */
     return retCode;
 
 } /* End of prepareTaskStack. */
@@ -585,6 +1275,9 @@ static uint8_t *prepareTaskStack( uint8_t * const pEmptyTaskStack
 /**
  * Start the interrupt which clocks the system time. Timer 2 is used as interrupt source
  * with a period time of about 2 ms or a frequency of 490.1961 Hz respectively.\n
+ *   If #RTOS_USE_CTC_SYSTEM_TIMER is on, the 16 Bit timer #RTOS_CTC_TIMER is used instead
+ * in CTC mode. Its period time is #RTOS_CTC_TIC_PERIOD_US, rounded to the resolution of
+ * the timer, see #RTOS_CTC_TIC.\n
  *   This is the default implementation of the routine, which can be overloaded by the
  * application code if another interrupt or other interrupt settings should be used.
  */
@@ -593,6 +1286,24 @@ RTOS_DEFAULT_FCT void rtos_enableIRQTimerTic(void)
 
 {
 #ifdef __AVR_ATmega2560__
+# if RTOS_USE_CTC_SYSTEM_TIMER == RTOS_FEATURE_ON
+    /* Arduino (wiring.c, init()) has put the 16 Bit timers into 8 Bit phase correct PWM
+       mode. We reconfigure the selected timer. The PWM outputs, which are connected to
+       this timer, can't be used by the application any more. The settings are:
+         WGM = %0100, CTC mode, the counter is reset to zero when it matches OCRnA. The 4
+       Bit word is partly found in TCCRnA and partly in TCCRnB.
+         COM = 0, the output compare pins are disconnected from the timer.
+         CS = RTOS_CTC_CS_BITS, the prescaler, which had been determined at compile time.
+         OCRnA = RTOS_CTC_OCR_VALUE, the period time is OCRnA+1 timer clock tics. */
+    RTOS_CTC_TCCRB = 0;                 /* Stop the timer during reconfiguration. */
+    RTOS_CTC_TCCRA = 0;
+    RTOS_CTC_TCNT  = 0;
+    RTOS_CTC_OCRA  = RTOS_CTC_OCR_VALUE;
+    RTOS_CTC_TIFR  = _BV(RTOS_CTC_OCFA); /* Clear a pending compare match. */
+    RTOS_CTC_TCCRB = _BV(RTOS_CTC_WGM2) | RTOS_CTC_CS_BITS;
+
+    RTOS_CTC_TIMSK |= _BV(RTOS_CTC_OCIEA);
+# else
     /* Initialization of the system timer: Arduino (wiring.c, init()) has initialized
        timer2 to count up and down (phase correct PWM mode) with prescaler 64 and no TOP
        value (i.e. it counts from 0 till MAX=255). This leads to a call frequency of
@@ -603,6 +1314,7 @@ RTOS_DEFAULT_FCT void rtos_enableIRQTimerTic(void)
         here and to enable the related interrupt. In which case you have to alter the name
         of the interrupt vector in use. Modify #RTOS_ISR_SYSTEM_TIMER_TIC to do so. */
     TIMSK2 |= _BV(TOIE2);
+# endif
 #else
 # error Modification of code for other AVR CPU required
 #endif
@@ -612,1234 +1324,3579 @@ RTOS_DEFAULT_FCT void rtos_enableIRQTimerTic(void)
 
 
 
+#if RTOS_CHECK_STACK_GUARD == RTOS_FEATURE_ON
 /**
- * When an event has been posted to a currently suspended task, it might easily be that
- * this task is resumed and becomes due. This routine checks a suspended task for resume
- * and moves it into the due task lists if it is resumed.
- *   @return
- * The Boolean information whether the task is resumed and becomes due is returned.
- *   @param idxSuspTask
- * The index of the investigated task. It is the index in the global list
- * \a _pSuspendedTaskAry of suspended tasks.
+ * Callback, which is invoked by the kernel if the stack pointer of a task has reached
+ * the guard zone at the end of its stack area. The check is made at each context switch,
+ * when the stack pointer of the left task is saved.\n
+ *   The function is called from within the interrupt, which performs the context switch.
+ * The global interrupts are disabled and the stack pointer already points to the stack of
+ * the new task. The implementation must therefore be short, it must not use any RTuinOS
+ * API and it must not enable the interrupts.\n
+ *   This is the default implementation of the routine, which can be overloaded by the
+ * application code. It fires an assertion in DEBUG compilation and does nothing
+ * otherwise.
+ *   @param idxTask
+ * The index of the affected task. The index is the same as used when initializing the
+ * tasks (see rtos_initializeTask).
+ *   @see #RTOS_STACK_GUARD_SIZE
  */
 
-static inline boolean checkTaskForActivation(uint8_t idxSuspTask)
+RTOS_DEFAULT_FCT void rtos_onStackGuardViolation(uint8_t idxTask)
+
 {
-    task_t * const pT = _pSuspendedTaskAry[idxSuspTask];
-    uint16_t eventVec;
-    boolean taskBecomesDue;
+    ASSERT(false);
 
-    /* Check if the task becomes due because of the events posted prior to calling this
-       function. The optimally supported case is the more probable OR combination of
-       events.
-         The AND operation is less straight forward as the timeout character of the
-       timer events needs to be retained: AND only refers to the postable events but
-       does not include the timer events. All postable events need to be set in both
-       the mask and the vector of posted events OR any of the timer events in the mask
-       are set in the vector of posted events. */
-    eventVec = pT->postedEventVec;
-    if((pT->waitForAnyEvent &&  eventVec != 0)
-       ||  (!pT->waitForAnyEvent
-            &&  (((eventVec ^ pT->eventMask) & ~MASK_EVT_IS_TIMER) == 0
-                 ||  (eventVec & pT->eventMask & MASK_EVT_IS_TIMER) != 0
-                )
-           )
-      )
-    {
-        uint8_t u
-              , prio = pT->prioClass;
+} /* End of rtos_onStackGuardViolation */
 
-        /* This task becomes due. */
 
-#if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON
-        /* If a round robin task voluntarily suspends it gets the right for a complete
-           new time slice. Reload the counter. */
-        pT->cntRoundRobin = pT->timeRoundRobin;
-#endif
-        /* Move the task from the list of suspended tasks to the list of due tasks of
-           its priority class. */
-        _pDueTaskAryAry[prio][_noDueTasksAry[prio]++] = pT;
-        -- _noSuspendedTasks;
-        for(u=idxSuspTask; u<_noSuspendedTasks; ++u)
-            _pSuspendedTaskAry[u] = _pSuspendedTaskAry[u+1];
 
-        /* Since a task became due there might be a change of the active task. */
-        taskBecomesDue = true;
-    }
-    else
-        taskBecomesDue = false;
-    
-    return taskBecomesDue;
-    
-} /* End of checkTaskForActivation */
+
+/**
+ * Report a stack guard violation of the task, which has just been left, to the
+ * application.\n
+ *   The action is placed into an own function in order to let the compiler generate the
+ * stack frame required for the computation of the task index. It is called from the naked
+ * interrupt functions, see macro CHECK_STACK_GUARD_OF_SUSPENDED_TASK.
+ */
+
+static RTOS_TRUE_FCT void onStackGuardViolation(void)
+{
+    rtos_onStackGuardViolation((uint8_t)(_pSuspendedTask - &_taskAry[0]));
+
+} /* End of onStackGuardViolation */
+#endif
 
 
 
 
+#if RTOS_USE_TASK_STATISTICS == RTOS_FEATURE_ON
 /**
- * After posting an event to one or more currently suspended tasks, it might easily be that
- * one such task is resumed and becomes due - active because of its higher priority. To
- * find out, this function needs to be called after posting the events. It determines which
- * task is now the active task.
- *   @return
- * The Boolean information wheather the active task now is another task is returned.\n
- *   If the function returns true, references to the old and the new active task are
- * reported by side effect: They are written into the global variables \a _pSuspendedTask and
- * \a _pActiveTask.
+ * Reset the statistics of one kind of time span. The minimum is set above the maximum,
+ * which indicates that no time span has been measured yet.
+ *   @param pStat
+ * The reset statistics.
  */
- 
-static inline boolean lookForActiveTask()
+
+static void resetTimeSpanStatistics(rtos_timeSpanStatistics_t * const pStat)
 {
-    /* The calling interrupt service routine will do a context switch only if we return
-       true. Otherwise it'll simply do a "reti" to the interrupted context and continue
-       it. */
-       
-    int8_t idxPrio;
+    pStat->min = 0xffffffffu;
+    pStat->max = 0;
+    memset( /* dest */ pStat->histogramAry
+          , /* val */ 0x00
+          , /* len */ sizeof(pStat->histogramAry)
+          );
+} /* End of resetTimeSpanStatistics */
 
-    /* Look for the task we will return to. It's the first entry in the highest
-       non-empty priority class. The loop requires a signed index. */
-    for(idxPrio=RTOS_NO_PRIO_CLASSES-1; idxPrio>=0; --idxPrio)
-    {
-        if(_noDueTasksAry[idxPrio] > 0)
-        {
-            _pSuspendedTask = _pActiveTask;
-            _pActiveTask    = _pDueTaskAryAry[idxPrio][0];
 
-            /* If we only entered the outermost if clause we made at least one task
-               due; these statements are thus surely reached. As the due becoming task
-               might however be of lower priority it can easily be that we nonetheless
-               don't have a task switch. */
-            return _pActiveTask != _pSuspendedTask;
-        }
+
+
+/**
+ * Add a measured time span to its statistics.
+ *   @param pStat
+ * The updated statistics.
+ *   @param timeSpan
+ * The measured time span in the unit of the time stamps, see #RTOS_TIMESTAMP_UNIT.
+ *   @remark
+ * The function must be called with globally disabled interrupts.
+ */
+
+static void addTimeSpanSample(rtos_timeSpanStatistics_t * const pStat, uint32_t timeSpan)
+{
+    if(timeSpan < pStat->min)
+        pStat->min = timeSpan;
+    if(timeSpan > pStat->max)
+        pStat->max = timeSpan;
+
+    /* The bin is the number of significant bits of the scaled time span. The loop is left
+       after a few cycles for the typical, short time spans. */
+    uint8_t idxBin = 0;
+    timeSpan >>= RTOS_TASK_STATISTICS_SCALE;
+    while(timeSpan != 0  &&  idxBin < RTOS_TASK_STATISTICS_NO_BINS-1)
+    {
+        ++ idxBin;
+        timeSpan >>= 1;
     }
 
-    /* We never get here. This function is called under the precondition that a task was
-       put into a due list, so the search above will surely have found one. */
-    ASSERT(false);
-    return false;
+    /* The counters saturate. */
+    uint16_t * const pCnt = &pStat->histogramAry[idxBin];
+    if(*pCnt < 0xffff)
+        ++ *pCnt;
 
-} /* End of lookForActiveTask */
+} /* End of addTimeSpanSample */
 
 
 
 
 /**
- * This function is called from the system interrupt triggered by the main clock. The
- * timers of all due tasks are served and - in case they elapse - timer events are
- * generated. These events may then resume some of the tasks. If so, they are placed in
- * the appropriate list of due tasks. Finally, the longest due task in the highest none
- * empty priority class is activated.
- *   @return
- * The Boolean information is returned whether we have or not have a task switch. In most
- * invocations we won't have and therefore it's worth to optimize the code for this case:
- * Don't do the expensive switch of the stack pointers.\n
- *   The most important result of the function, the reference to the active task after
- * leaving the function, is returned by side effect: The global variable _pActiveTask is
- * updated.
+ * A task is made due. Record the point in time for the later measurement of start latency
+ * and response time. If the task has been released by the absolute timer, then its
+ * release jitter is measured, too.
+ *   @param pT
+ * The released task.
+ *   @param eventVec
+ * The events, which have released the task.
+ *   @remark
+ * The function must be called with globally disabled interrupts.
  */
 
-static RTOS_TRUE_FCT boolean onTimerTic(void)
+static void recordTaskRelease(task_t * const pT, uintEventVec_t eventVec)
 {
-    /* Clock the system time. Cyclic overrun is intended. */
-    ++ _time;
+    const uint32_t tiNow = rtos_getTimestamp();
 
-    boolean activeTaskMayChange = false;
+    pT->tiRelease = tiNow;
+    pT->statState = STAT_STATE_RELEASED;
 
-    /* Check for all suspended tasks if a timer event has to be posted. */
-    uint8_t idxSuspTask = 0;
-    while(idxSuspTask<_noSuspendedTasks)
+    if((eventVec & RTOS_EVT_ABSOLUTE_TIMER) != 0)
     {
-        task_t * const pT = _pSuspendedTaskAry[idxSuspTask];
-        
-        /* Remember the received events before (possibly) getting some more in this
-           timer tic: Only if this set changes it is necessary to check for a state
-           transition of the task. */
-        const uint16_t postedEventVecBefore = pT->postedEventVec;
-        
-        /* Check for absolute timer event. */
-        if(_time == pT->timeDueAt)
-        {
-            /* Setting the absolute timer event when it already is set looks like a task
-               overrun indication. It isn't for the following reason. The absolute timer
-               event can't be AND combined with other events, so the event will immediately
-               change the status to due (see checkForTaskActivation), so that setting it a
-               second time will never occur. */
-            pT->postedEventVec |= (RTOS_EVT_ABSOLUTE_TIMER & pT->eventMask);
-        }
+        /* The nominal release is at the beginning of the tic timeDueAt. This is the current
+           tic unless the task is late and released outside the system timer interrupt. */
+        const uint32_t tiNominal = _timestampAtTic
+                                   - (uint32_t)(uintTime_t)(_time - pT->timeDueAt)
+                                     * (RTOS_CTC_OCR_VALUE + 1ul);
+        addTimeSpanSample( &_taskStatisticsAry[pT - &_taskAry[0]].releaseJitter
+                         , tiNow - tiNominal
+                         );
+    }
+} /* End of recordTaskRelease */
 
-        /* Check for delay timer event. The code here should optimally support the standard
-           situation that the counter is constantly 0. */
-        if(pT->cntDelay != 0)
-        {
-            if(-- pT->cntDelay == 0)
-                pT->postedEventVec |= (RTOS_EVT_DELAY_TIMER & pT->eventMask);
-        }
 
-        /* Check if this suspended task becomes due because of a timer event, which was
-           posted to it. */
-        if(postedEventVecBefore != pT->postedEventVec  && checkTaskForActivation(idxSuspTask))
-        {
-            /* The task becomes due, which may cause a task switch. */
-            activeTaskMayChange = true;
 
-            /* Check next suspended task, which is in this case found in the array
-               element with same index: The task which became due has been removed into the
-               due list of its priority class. */
-        }
-        else
-        {
-            /* The task remains suspended. */
 
-            /* Check next suspended task, which is in this case found in the next array
-               element. */
-            ++ idxSuspTask;
+/**
+ * A task becomes active after a suspend command. If it has been released since, then its
+ * start latency is measured.\n
+ *   The action is placed into an own function in order to let the compiler generate the
+ * stack frame required for the computation. It is called from the naked interrupt
+ * functions, see macro PUSH_RET_CODE_OF_CONTEXT_SWITCH.
+ */
 
-        } /* End if(Did this suspended task become due?) */
+static RTOS_TRUE_FCT void onTaskStart(void)
+{
+    task_t * const pT = _pActiveTask;
+    if(pT->statState == STAT_STATE_RELEASED)
+    {
+        addTimeSpanSample( &_taskStatisticsAry[pT - &_taskAry[0]].startLatency
+                         , rtos_getTimestamp() - pT->tiRelease
+                         );
+        pT->statState = STAT_STATE_STARTED;
+    }
+} /* End of onTaskStart */
 
-    } /* End while(All suspended tasks) */
 
 
-#if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON
-    /* Round-robin: Applies only to the active task. It can become inactive, however not
-       undue, or suspended respectively. If its time slice is elapsed it is put at the end
-       of the due list in its priority class. */
-    if(_pActiveTask->cntRoundRobin != 0)
-    {
-        if(--_pActiveTask->cntRoundRobin == 0)
-        {
-            /* Time slice of active task has elapsed. Reload the counter. */
-            _pActiveTask->cntRoundRobin = _pActiveTask->timeRoundRobin;
 
-            uint8_t prio = _pActiveTask->prioClass
-                  , noTasks = _noDueTasksAry[prio];
+/**
+ * The active task suspends. This completes its current activation and its response time
+ * is measured.
+ *   @param pT
+ * The suspending task.
+ *   @remark
+ * The function must be called with globally disabled interrupts.
+ */
 
-            /* If there are more due tasks in the same class the next one will be made the
-               active one by a cyclic move of the positions in the list. */
-            if(noTasks-- > 1)
-            {
-                uint8_t idxTask;
+static inline void recordTaskSuspend(task_t * const pT)
+{
+    if(pT->statState == STAT_STATE_STARTED)
+    {
+        addTimeSpanSample( &_taskStatisticsAry[pT - &_taskAry[0]].responseTime
+                         , rtos_getTimestamp() - pT->tiRelease
+                         );
+    }
+    pT->statState = STAT_STATE_IDLE;
 
-                /* The list of due tasks in the active priority class is rolled by one task.
-                   The next due task will become active.
-                     Note: noTasks has been decremented before in the if. */
-                for(idxTask=0; idxTask<noTasks; ++idxTask)
-                    _pDueTaskAryAry[prio][idxTask] = _pDueTaskAryAry[prio][idxTask+1];
-                _pDueTaskAryAry[prio][idxTask] = _pActiveTask;
+} /* End of recordTaskSuspend */
+#endif
 
-                /* Force check for new active task - even if no suspended task should have been
-                   resumed. */
-                activeTaskMayChange = true;
 
-            } /* if(Did the task loose against another due one?) */
 
-        } /* if(Did the round robin time of the task elapse?) */
 
-    } /* if(Do we have a round robin task?) */
-#endif
+/**
+ * Put a task into the list of due tasks of its priority class. It is appended to the list,
+ * i.e. it becomes active after all other due tasks of the class. In the EDF class the
+ * task is inserted according to its absolute deadline, which needs to be set before.
+ *   @param pT
+ * The task, which becomes due.
+ */
 
-    /* Check if another task becomes active because of the possibly occurred timer events.
-         activeTaskMayChange: We do the search for the new active task only if at least one
-       suspended task was resumed. If round robin is compiled it depends. Always look for a
-       new active task if the round robin time has elapsed.
-         The function has side effects: If there's a task which was suspended before and
-       which is resumed because of the timer events and which is of higher priority than
-       the one being active so far, the refernces to the old and newly active task are
-       written into global variables _pSuspendedTask and _pActiveTask. */
-    return activeTaskMayChange && lookForActiveTask();
+static inline void putTaskIntoDueList(task_t * const pT)
+{
+    const uint8_t prio = pT->prioClass;
+    uint8_t u = _noDueTasksAry[prio]++;
 
-} /* End of onTimerTic. */
+    /* The application is in charge not to exceed the capacity of the lists. */
+    ASSERT(u < RTOS_MAX_NO_TASKS_IN_PRIO_CLASS);
 
+#if RTOS_USE_EDF_PRIO_CLASS == RTOS_FEATURE_ON
+    if(prio == RTOS_EDF_PRIO_CLASS)
+    {
+        /* The list of due tasks of the EDF class is sorted by rising absolute deadline.
+           Insert the task behind all tasks with same or earlier deadline. This is a cyclic
+           time, the comparison needs to be signed. */
+        task_t ** const pDueTaskAry = &_pDueTaskAryAry[prio][0];
+        while(u > 0  &&  (intTime_t)(pT->timeDeadlineAt - pDueTaskAry[u-1]->timeDeadlineAt) < 0)
+        {
+            pDueTaskAry[u] = pDueTaskAry[u-1];
+            -- u;
+        }
+        pDueTaskAry[u] = pT;
+    }
+    else
+#endif
+        _pDueTaskAryAry[prio][u] = pT;
 
+} /* End of putTaskIntoDueList */
 
 
 
 
 /**
- * Each call of this function cyclically increments the system time of the kernel by one.\n
- *   Incrementing the system timer is an important system event. The routine will always
- * include an inspection of all suspended tasks, whether they could become due again.
- *   The cycle time of the system time is low (typically implemented as 0..255) and
- * determines the maximum delay time or timeout for a task which suspends itself and the
- * ratio of the task periods of the fastest and the slowest regular task. Furthermore it
- * determines the reliability of task overrun recognition. Task overrun events in the
- * magnitude of half the cycle time won't be recognized as such.\n
- *   The unit of the time is defined only by the it triggering source and doesn't matter at
- * all for the kernel. The time even don't need to be regular.\n
- *   @remark
- * The function needs to be called by an interrupt and can easily end with a context change,
- * i.e. the interrupt will return to another task as the one it had interrupted.
- *   @remark
- * The connected interrupt is defined by macro #RTOS_ISR_SYSTEM_TIMER_TIC. This interrupt
- * needs to be disabled/enabled by the implementation of \a enterCriticalSection and \a
- * leaveCriticalSection.
- *   @remark
- * The cycle time of the system time can be influenced by the typedef of uintTime_t. Find a
- * discussion of pros and cons at the location of this typedef.
- *   @see boolean onTimerTic(void)
- *   @see #rtos_enterCriticalSection
+ * Take a task out of the list of due tasks of its priority class if it is found in this
+ * list. The execution time is bounded by #RTOS_MAX_NO_TASKS_IN_PRIO_CLASS.
+ *   @return
+ * Get true if the task had been due, false if it is not in the list.
+ *   @param pT
+ * The task to remove.
  */
 
-ISR(RTOS_ISR_SYSTEM_TIMER_TIC, ISR_NAKED)
+static inline boolean takeTaskOutOfDueList(task_t * const pT)
 {
-    /* An ISR must not occur while we're updating the global data and checking for a
-       possible task switch. To be more precise: The call of onTimerTic would just require
-       to inhibit all those interrupts which might initiate a task switch. As long as no
-       user defined interrupts are configured to set an RTOS event, this is only the single
-       timer interrupt driving the system time. However, at latest when a task switch
-       really is initiated we would need to lock all interrupts globally (as we modify the
-       stack pointer in non-atomic operation). It doesn't matter to have locked all
-       interrupts globally already here. */
+    const uint8_t prio = pT->prioClass
+                , noDueTasks = _noDueTasksAry[prio];
+    task_t ** const pDueTaskAry = &_pDueTaskAryAry[prio][0];
+    uint8_t u;
 
-    /* Save context onto the stack of the interrupted active task. */
-    PUSH_CONTEXT_ONTO_STACK
-
-	/* We must not exclude that the zero_reg is temporarily altered in the arbitrarily
-       interrupted code. To make the local code here running, we need to anticipate this
-       situation and clear the register. */
-    asm volatile
-    ("clr __zero_reg__ \n\t"
-    );
-
-    /* Check for all suspended tasks if this change in time is an event for them. */
-    if(onTimerTic())
+    for(u=0; u<noDueTasks; ++u)
     {
-        /* Yes, another task becomes active with this timer tic. Switch the stack pointer
-           to the (saved) stack pointer of that task. */
-        SWITCH_CONTEXT
-        PUSH_RET_CODE_OF_CONTEXT_SWITCH
+        if(pDueTaskAry[u] == pT)
+        {
+            _noDueTasksAry[prio] = noDueTasks - 1;
+            for(; u<noDueTasks-1; ++u)
+                pDueTaskAry[u] = pDueTaskAry[u+1];
+            return true;
+        }
     }
+    return false;
 
-    /* The highly critical operation of modifying the stack pointer is done. From now on,
-       all interrupts could safely operate on the new stack, the stack of the new task. This
-       includes such an interrupt which would cause another task switch. However, early
-       releasing the global interrupts here could lead to higher use of stack area if many
-       task switches appear one after another. Therefore we will reenable the interrupts
-       only with the final reti command. The disadvantage is probably minor (some clock
-       tics less of responsiveness of the system). */
+} /* End of takeTaskOutOfDueList */
 
-    /* The stack pointer points to the now active task (which will often be still the same
-       as at function entry). The CPU context to continue with is popped from this stack. If
-       there's no change in active task the entire routine call is just like any ordinary
-       interrupt. */
-    POP_CONTEXT_FROM_STACK
 
-    /* The global interrupt enable flag is not saved across task switches, but always set
-       on entry into the new or same context by using a reti rather than a ret.
-         If we return to the same context, this will not mean that we harmfully change the
-       state of a running context without the context knowing or willing it: If the context
-       had reset the bit we would never have got here, as this is an ISR controlled by the
-       bit. */
-    asm volatile
-    ( "reti \n\t"
-    );
 
-} /* End of ISR to increment the system time by one tic. */
 
+/**
+ * Put a task into the list of suspended tasks. If mutexes or semaphores are in use this
+ * list is sorted with decreasing priority; the task is inserted behind all tasks of same or
+ * higher priority, as if it had just started waiting.
+ *   @return
+ * Get the index of the task in the list \a _pSuspendedTaskAry.
+ *   @param pT
+ * The task, which is suspended.
+ */
+
+static inline uint8_t putTaskIntoSuspendedList(task_t * const pT)
+{
+#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
+    int8_t idxPos, i;
+    for(idxPos=0; idxPos<_noSuspendedTasks; ++idxPos)
+        if(_pSuspendedTaskAry[idxPos]->prioClass < pT->prioClass)
+            break;
+
+    /* Shift rest of the list one to the end. This loop requires a signed index. */
+    for(i=_noSuspendedTasks++ - 1; i>=idxPos; --i)
+        _pSuspendedTaskAry[i+1] = _pSuspendedTaskAry[i];
 
+    _pSuspendedTaskAry[idxPos] = pT;
+    return idxPos;
+#else
+    _pSuspendedTaskAry[_noSuspendedTasks] = pT;
+    return _noSuspendedTasks++;
+#endif
+} /* End of putTaskIntoSuspendedList */
 
 
 
 
 /**
- * Actual implementation of routine \a rtos_sendEvent. The task posts a set of events and the
- * scheduler is asked which task is the one to be activated now.\n
- *   The action of this SW interrupt is placed into an own function in order to let the
- * compiler generate the stack frame required for all local data. (The stack frame
- * generation of the SW interrupt entry point needs to be inhibited in order to permit the
- * implementation of saving/restoring the task context).
+ * Take a task out of the list of suspended tasks if it is found in this list. The
+ * execution time is bounded by #RTOS_NO_TASKS.
  *   @return
- * The function determines which task is to be activated and records which task is left
- * (i.e. the task calling this routine) in the global variables _pActiveTask and
- * _pSuspendedTask.\n
+ * Get true if the task had been suspended, false if it is not in the list.
+ *   @param pT
+ * The task to remove.
+ */
+
+static inline boolean takeTaskOutOfSuspendedList(task_t * const pT)
+{
+    uint8_t u;
+    for(u=0; u<_noSuspendedTasks; ++u)
+    {
+        if(_pSuspendedTaskAry[u] == pT)
+        {
+            -- _noSuspendedTasks;
+            for(; u<_noSuspendedTasks; ++u)
+                _pSuspendedTaskAry[u] = _pSuspendedTaskAry[u+1];
+            return true;
+        }
+    }
+    return false;
+
+} /* End of takeTaskOutOfSuspendedList */
+
+
+
+
+#if RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_ON
+/**
+ * Look for the task with the earliest armed deadline and store it in \a
+ * _pTaskNextDeadline. The execution time is bounded by #RTOS_NO_TASKS.
+ *   @remark
+ * This function is called with globally disabled interrupts. It is called only when the
+ * task with the earliest deadline is disarmed, not in every system timer tic.
+ */
+
+static void findNextDeadline(void)
+{
+    task_t *pNext = NULL;
+    uint8_t idxTask;
+    for(idxTask=0; idxTask<RTOS_NO_TASKS; ++idxTask)
+    {
+        task_t * const pT = &_taskAry[idxTask];
+        
+        /* The deadlines are cyclic times, the comparison needs to be signed. */
+        if(pT->isDeadlineArmed
+           &&  (pNext == NULL
+                ||  (intTime_t)(pT->timeDeadlineAt - pNext->timeDeadlineAt) < 0
+               )
+          )
+        {
+            pNext = pT;
+        }
+    }
+    _pTaskNextDeadline = pNext;
+
+} /* End of findNextDeadline */
+
+
+
+
+/**
+ * Arm the deadline of a task, which is made due, if it has a deadline at all. Its absolute
+ * deadline needs to be set before.
+ *   @param pT
+ * The task object of the task, which is made due.
+ *   @remark
+ * This function is called with globally disabled interrupts. It is inlined for
+ * performance reasons.
+ */
+
+static inline void armTaskDeadline(task_t * const pT)
+{
+    pT->isDeadlineArmed = pT->timeDeadline > 0;
+    
+    /* Only an earlier deadline can replace the earliest one. */
+    if(RTOS_EVT_DEADLINE_MISS != 0
+       &&  pT->isDeadlineArmed
+       &&  (_pTaskNextDeadline == NULL
+            ||  (intTime_t)(pT->timeDeadlineAt - _pTaskNextDeadline->timeDeadlineAt) < 0
+           )
+      )
+    {
+        _pTaskNextDeadline = pT;
+    }
+} /* End of armTaskDeadline */
+
+
+
+
+/**
+ * Disarm the deadline of a task, which suspends, is halted or has missed its deadline.
+ *   @param pT
+ * The task object of the task.
+ *   @remark
+ * This function is called with globally disabled interrupts. It is inlined for
+ * performance reasons.
+ */
+
+static inline void disarmTaskDeadline(task_t * const pT)
+{
+    pT->isDeadlineArmed = false;
+    
+    /* The earliest deadline needs to be looked for again only if it is the deadline of
+       this task. */
+    if(RTOS_EVT_DEADLINE_MISS != 0  &&  pT == _pTaskNextDeadline)
+        findNextDeadline();
+
+} /* End of disarmTaskDeadline */
+#endif
+
+
+
+
+/**
+ * When an event has been posted to a currently suspended task, it might easily be that
+ * this task is resumed and becomes due. This routine checks a suspended task for resume
+ * and moves it into the due task lists if it is resumed.
+ *   @return
+ * The Boolean information whether the task is resumed and becomes due is returned.
+ *   @param idxSuspTask
+ * The index of the investigated task. It is the index in the global list
+ * \a _pSuspendedTaskAry of suspended tasks.
+ */
+
+static inline boolean checkTaskForActivation(uint8_t idxSuspTask)
+{
+    task_t * const pT = _pSuspendedTaskAry[idxSuspTask];
+    uintEventVec_t eventVec;
+    boolean taskBecomesDue;
+
+    /* Check if the task becomes due because of the events posted prior to calling this
+       function. The optimally supported case is the more probable OR combination of
+       events.
+         The AND operation is less straight forward as the timeout character of the
+       timer events needs to be retained: AND only refers to the postable events but
+       does not include the timer events. All postable events need to be set in both
+       the mask and the vector of posted events OR any of the timer events in the mask
+       are set in the vector of posted events. */
+    eventVec = pT->postedEventVec;
+    if((pT->waitForAnyEvent &&  eventVec != 0)
+       ||  (!pT->waitForAnyEvent
+            &&  (((eventVec ^ pT->eventMask) & ~MASK_EVT_IS_TIMER) == 0
+                 ||  (eventVec & pT->eventMask & MASK_EVT_IS_TIMER) != 0
+                )
+           )
+      )
+    {
+        uint8_t u;
+
+        /* This task becomes due. */
+
+#if RTOS_USE_TASK_STATISTICS == RTOS_FEATURE_ON
+        recordTaskRelease(pT, eventVec);
+#endif
+#if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON
+        /* If a round robin task voluntarily suspends it gets the right for a complete
+           new time slice. Reload the counter. */
+        pT->cntRoundRobin = pT->timeRoundRobin;
+#endif
+        /* Move the task from the list of suspended tasks to the list of due tasks of
+           its priority class. */
+#if TASK_HAS_DEADLINE
+# if RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_OFF
+        if(pT->prioClass == RTOS_EDF_PRIO_CLASS)
+# endif
+        {
+            /* The task becomes due at the nominal time if it has been resumed by the
+               absolute timer, otherwise now. Its absolute deadline is relative to this
+               point in time. */
+            pT->timeDeadlineAt = ((eventVec & RTOS_EVT_ABSOLUTE_TIMER) != 0? pT->timeDueAt: _time)
+                                 + pT->timeDeadline;
+        }
+#endif
+#if RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_ON
+        armTaskDeadline(pT);
+#endif
+        putTaskIntoDueList(pT);
+
+        -- _noSuspendedTasks;
+        for(u=idxSuspTask; u<_noSuspendedTasks; ++u)
+            _pSuspendedTaskAry[u] = _pSuspendedTaskAry[u+1];
+
+        /* Since a task became due there might be a change of the active task. */
+        taskBecomesDue = true;
+    }
+    else
+        taskBecomesDue = false;
+    
+    return taskBecomesDue;
+    
+} /* End of checkTaskForActivation */
+
+
+
+
+/**
+ * After posting an event to one or more currently suspended tasks, it might easily be that
+ * one such task is resumed and becomes due - active because of its higher priority. To
+ * find out, this function needs to be called after posting the events. It determines which
+ * task is now the active task.
+ *   @return
+ * The Boolean information wheather the active task now is another task is returned.\n
+ *   If the function returns true, references to the old and the new active task are
+ * reported by side effect: They are written into the global variables \a _pSuspendedTask and
+ * \a _pActiveTask.
+ */
+ 
+static inline boolean lookForActiveTask()
+{
+    /* The calling interrupt service routine will do a context switch only if we return
+       true. Otherwise it'll simply do a "reti" to the interrupted context and continue
+       it. */
+       
+    int8_t idxPrio;
+
+    /* Look for the task we will return to. It's the first entry in the highest
+       non-empty priority class. The loop requires a signed index. */
+    for(idxPrio=RTOS_NO_PRIO_CLASSES-1; idxPrio>=0; --idxPrio)
+    {
+        if(_noDueTasksAry[idxPrio] > 0)
+        {
+            _pSuspendedTask = _pActiveTask;
+            _pActiveTask    = _pDueTaskAryAry[idxPrio][0];
+
+            /* If we only entered the outermost if clause we made at least one task
+               due; these statements are thus surely reached. As the due becoming task
+               might however be of lower priority it can easily be that we nonetheless
+               don't have a task switch. */
+            return _pActiveTask != _pSuspendedTask;
+        }
+    }
+
+    /* We never get here. This function is called under the precondition that a task was
+       put into a due list, so the search above will surely have found one. */
+    ASSERT(false);
+    return false;
+
+} /* End of lookForActiveTask */
+
+
+
+
+#if RTOS_USE_OVERRUN_POLICY == RTOS_FEATURE_ON
+/**
+ * Record a recognized overrun of a task and notify the application as demanded by the
+ * overrun policy of the task: The callback \a rtos_onTaskOverrun is invoked and the event
+ * #RTOS_EVT_TASK_OVERRUN is made pending. It is posted by the system timer interrupt: In
+ * the next tic if the overrun is recognized in a suspend command, in the same tic if it is
+ * recognized at an entry of the schedule table, and in any case not before a task waits
+ * for it.
+ *   @param pT
+ * The task object of the overrunning task.
+ *   @remark
+ * This function is called with globally disabled interrupts. It is inlined for
+ * performance reasons.
+ */
+
+static inline void notifyTaskOverrun(task_t * const pT)
+{
+    if(pT->cntOverrun < 0xff)
+        ++ pT->cntOverrun;
+
+    if((pT->overrunPolicy & RTOS_OVERRUN_CALL_HOOK) != 0)
+        rtos_onTaskOverrun((uint8_t)(pT - &_taskAry[0]));
+
+    if((pT->overrunPolicy & RTOS_OVERRUN_SEND_EVENT) != 0)
+        _overrunEventToPost = RTOS_EVT_TASK_OVERRUN;
+
+} /* End of notifyTaskOverrun */
+
+
+
+
+/**
+ * Apply the overrun policy of a task, which has just recognized an overrun in its call of
+ * \a rtos_suspendTaskTillTime: Its due time, which has been advanced by the task period,
+ * is already over.
+ *   @return
+ * Get true if the task is due immediately, i.e. it must not be suspended. This is the
+ * case for policy #RTOS_OVERRUN_POLICY_CATCH_UP.
+ *   @param pT
+ * The task object of the overrunning task. Its due time is the missed point in time on
+ * its time grid.
+ *   @param period
+ * The task period, i.e. the timeout argument of the suspend command.
+ *   @remark
+ * This function is called with globally disabled interrupts. It is inlined for
+ * performance reasons.
+ */
+
+static inline boolean handleTaskOverrun(task_t * const pT, uintTime_t period)
+{
+    notifyTaskOverrun(pT);
+
+    if((pT->overrunPolicy & RTOS_OVERRUN_POLICY_CATCH_UP) != 0)
+    {
+        /* The missed due time is kept, the time grid is not shifted. The task will see the
+           absolute timer event without suspending. */
+        return true;
+    }
+    else if((pT->overrunPolicy & RTOS_OVERRUN_POLICY_SKIP) != 0  &&  period > 0)
+    {
+        /* Advance the due time by as many periods as needed to get into the future again.
+           A division is cheaper than the loop in case of many missed periods. */
+        pT->timeDueAt += ((uintTime_t)(_time - pT->timeDueAt) / period + 1) * period;
+    }
+    else
+    {
+        /* Default policy: Same reaction as without overrun policies, see
+           storeResumeCondition. */
+#if RTOS_OVERRUN_TASK_IS_IMMEDIATELY_DUE == RTOS_FEATURE_ON
+        pT->timeDueAt = _time+1;
+#endif
+    }
+
+    return false;
+
+} /* End of handleTaskOverrun */
+#endif
+
+
+
+
+#if defined(RTOS_SCHEDULE_TABLE)  &&  defined(DEBUG)
+/**
+ * Check if a task has at least one entry in the schedule table. A time-triggered task,
+ * which doesn't, would wait for its next slot forever.
+ *   @return
+ * Get true if the task is released by the schedule table.
+ *   @param pT
+ * The task object of the task.
+ *   @remark
+ * The function is used for double-checking in DEBUG compilation only. The execution time
+ * grows with the number of entries in the table.
+ */
+
+static boolean isTaskInScheduleTable(const task_t * const pT)
+{
+    uint8_t idxEntry;
+    for(idxEntry=0; idxEntry<NO_SCHEDULE_ENTRIES; ++idxEntry)
+    {
+        if(&_taskAry[GET_SCHEDULE_TASK(idxEntry)] == pT)
+            return true;
+    }
+    return false;
+
+} /* End of isTaskInScheduleTable */
+#endif
+
+
+
+
+#ifdef RTOS_SCHEDULE_TABLE
+/**
+ * Advance the phase in the hyperperiod of the schedule table by one system timer tic and
+ * release all time-triggered tasks, which have an entry at the new phase. The entries are
+ * sorted by offset, only the next entry is compared with the phase. The work per tic is
+ * constant besides the number of entries at the same phase.\n
+ *   A task is released by setting its absolute timer to the current time. The absolute
+ * timer event is then posted by the caller in the same tic. A task, which doesn't wait for
+ * its entry, is still busy with the previous one. The entry is skipped and the overrun
+ * counter of the task is incremented. If overrun policies are configured, the notifications
+ * of the policy of the task are done, too.
+ *   @remark
+ * This function is called from the system timer interrupt only. It is inlined for
+ * performance reasons.
+ */
+
+static inline void releaseScheduledTasks(void)
+{
+    if(++_phaseSchedule >= RTOS_SCHEDULE_HYPERPERIOD)
+        _phaseSchedule = 0;
+
+    while(GET_SCHEDULE_OFFSET(_idxScheduleEntry) == _phaseSchedule)
+    {
+        task_t * const pT = &_taskAry[GET_SCHEDULE_TASK(_idxScheduleEntry)];
+        if(pT->isWaitingForScheduleSlot)
+        {
+            pT->isWaitingForScheduleSlot = false;
+            pT->timeDueAt = _time;
+        }
+        else
+        {
+#if RTOS_USE_OVERRUN_POLICY == RTOS_FEATURE_ON
+            notifyTaskOverrun(pT);
+#else
+            if(pT->cntOverrun < 0xff)
+                ++ pT->cntOverrun;
+#endif
+        }
+
+        /* The first entry belongs to the next hyperperiod, even if it has the same
+           phase. */
+        if(++_idxScheduleEntry >= NO_SCHEDULE_ENTRIES)
+        {
+            _idxScheduleEntry = 0;
+            break;
+        }
+    } /* End while(All entries at this phase) */
+
+} /* End of releaseScheduledTasks */
+#endif
+
+
+
+
+#if RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_ON
+/**
+ * Record a recognized deadline miss of a task and make the event #RTOS_EVT_DEADLINE_MISS
+ * pending. It is posted by the system timer interrupt: In the next tic if the miss is
+ * recognized when the task suspends, in the same tic if it is recognized by the interrupt
+ * itself, and in any case not before a task waits for it.
+ *   @param pT
+ * The task object of the late task.
+ *   @remark
+ * This function is called with globally disabled interrupts. It is inlined for
+ * performance reasons.
+ */
+
+static inline void notifyDeadlineMiss(task_t * const pT)
+{
+    if(pT->cntDeadlineMiss < 0xff)
+        ++ pT->cntDeadlineMiss;
+
+    _deadlineMissEventToPost = RTOS_EVT_DEADLINE_MISS;
+
+} /* End of notifyDeadlineMiss */
+
+
+
+
+/**
+ * Check the deadlines of all tasks, which are due or active and which have not suspended
+ * since they were made due. A task is late if the tic of its absolute deadline has passed.
+ * The deadline of a late task is not checked again when it suspends.\n
+ *   The check is done in every system timer tic only if the event #RTOS_EVT_DEADLINE_MISS
+ * is configured. Only the earliest armed deadline is compared with the time; the other
+ * tasks are considered only if a deadline has been missed.
+ *   @remark
+ * This function is called from the system timer interrupt. It is inlined for
+ * performance reasons.
+ */
+
+static inline void checkTaskDeadlines(void)
+{
+    while(_pTaskNextDeadline != NULL
+          &&  (intTime_t)(_time - _pTaskNextDeadline->timeDeadlineAt) > 0
+         )
+    {
+        task_t * const pT = _pTaskNextDeadline;
+        disarmTaskDeadline(pT);
+        notifyDeadlineMiss(pT);
+    }
+} /* End of checkTaskDeadlines */
+#endif
+
+
+
+
+/**
+ * This function is called from the system interrupt triggered by the main clock. The
+ * timers of all due tasks are served and - in case they elapse - timer events are
+ * generated. These events may then resume some of the tasks. If so, they are placed in
+ * the appropriate list of due tasks. Finally, the longest due task in the highest none
+ * empty priority class is activated.
+ *   @return
+ * The Boolean information is returned whether we have or not have a task switch. In most
+ * invocations we won't have and therefore it's worth to optimize the code for this case:
+ * Don't do the expensive switch of the stack pointers.\n
+ *   The most important result of the function, the reference to the active task after
+ * leaving the function, is returned by side effect: The global variable _pActiveTask is
+ * updated.
+ */
+
+static RTOS_TRUE_FCT boolean onTimerTic(void)
+{
+    /* Clock the system time. Cyclic overrun is intended. */
+    ++ _time;
+#if RTOS_USE_CTC_SYSTEM_TIMER == RTOS_FEATURE_ON
+    _timestampAtTic += RTOS_CTC_OCR_VALUE + 1ul;
+#endif
+#if RTOS_PROVIDE_ARDUINO_TIME == RTOS_FEATURE_ON
+    /* Clock the substitutes of the Arduino time functions. The tic period is an integral
+       number of microseconds, the operations are done with compile time constants. */
+    _microsAtTic += RTOS_CTC_TIC_PERIOD_US;
+    _millisAtTic += RTOS_CTC_TIC_PERIOD_US / 1000u;
+    if((_fractMillisAtTic += RTOS_CTC_TIC_PERIOD_US % 1000u) >= 1000u)
+    {
+        _fractMillisAtTic -= 1000u;
+        ++ _millisAtTic;
+    }
+#endif
+
+    boolean activeTaskMayChange = false;
+
+#ifdef RTOS_SCHEDULE_TABLE
+    /* The time-triggered tasks get their absolute timer events in the loop below. */
+    releaseScheduledTasks();
+#endif
+#if RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_ON
+    /* The deadlines are enforced if a miss is reported to a supervising task. The event
+       is posted in the loop below. */
+    if(RTOS_EVT_DEADLINE_MISS != 0)
+        checkTaskDeadlines();
+#endif
+
+    /* Check for all suspended tasks if a timer event has to be posted. */
+#if RTOS_USE_OVERRUN_POLICY == RTOS_FEATURE_ON
+    boolean isOverrunEventReceived = false;
+#endif
+#if RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_ON
+    boolean isDeadlineMissEventReceived = false;
+#endif
+    uint8_t idxSuspTask = 0;
+    while(idxSuspTask<_noSuspendedTasks)
+    {
+        task_t * const pT = _pSuspendedTaskAry[idxSuspTask];
+        
+        /* Remember the received events before (possibly) getting some more in this
+           timer tic: Only if this set changes it is necessary to check for a state
+           transition of the task. */
+        const uintEventVec_t postedEventVecBefore = pT->postedEventVec;
+        
+#if RTOS_USE_OVERRUN_POLICY == RTOS_FEATURE_ON
+        /* Post the pending event, which reports a task overrun to a supervising task. */
+        if((_overrunEventToPost & pT->eventMask) != 0)
+        {
+            pT->postedEventVec |= _overrunEventToPost;
+            isOverrunEventReceived = true;
+        }
+#endif
+#if RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_ON
+        /* Post the pending event, which reports a deadline miss to a supervising task. */
+        if(RTOS_EVT_DEADLINE_MISS != 0  &&  (_deadlineMissEventToPost & pT->eventMask) != 0)
+        {
+            pT->postedEventVec |= _deadlineMissEventToPost;
+            isDeadlineMissEventReceived = true;
+        }
+#endif
+
+        /* Check for absolute timer event. */
+        if(_time == pT->timeDueAt)
+        {
+            /* Setting the absolute timer event when it already is set looks like a task
+               overrun indication. It isn't for the following reason. The absolute timer
+               event can't be AND combined with other events, so the event will immediately
+               change the status to due (see checkForTaskActivation), so that setting it a
+               second time will never occur. */
+            pT->postedEventVec |= (RTOS_EVT_ABSOLUTE_TIMER & pT->eventMask);
+        }
+
+        /* Check for delay timer event. The code here should optimally support the standard
+           situation that the counter is constantly 0. */
+        if(pT->cntDelay != 0)
+        {
+            if(-- pT->cntDelay == 0)
+                pT->postedEventVec |= (RTOS_EVT_DELAY_TIMER & pT->eventMask);
+        }
+
+        /* Check if this suspended task becomes due because of a timer event, which was
+           posted to it. */
+        if(postedEventVecBefore != pT->postedEventVec  && checkTaskForActivation(idxSuspTask))
+        {
+            /* The task becomes due, which may cause a task switch. */
+            activeTaskMayChange = true;
+
+            /* Check next suspended task, which is in this case found in the array
+               element with same index: The task which became due has been removed into the
+               due list of its priority class. */
+        }
+        else
+        {
+            /* The task remains suspended. */
+
+            /* Check next suspended task, which is in this case found in the next array
+               element. */
+            ++ idxSuspTask;
+
+        } /* End if(Did this suspended task become due?) */
+
+    } /* End while(All suspended tasks) */
+
+#if RTOS_USE_OVERRUN_POLICY == RTOS_FEATURE_ON
+    /* The event has been posted to all tasks, which wait for it. If there's none, it stays
+       pending; a supervising task, which is busy, will get it when it waits again. */
+    if(isOverrunEventReceived)
+        _overrunEventToPost = 0;
+#endif
+#if RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_ON
+    /* Same for the deadline miss event. */
+    if(isDeadlineMissEventReceived)
+        _deadlineMissEventToPost = 0;
+#endif
+
+
+#if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON
+    /* Round-robin: Applies only to the active task. It can become inactive, however not
+       undue, or suspended respectively. If its time slice is elapsed it is put at the end
+       of the due list in its priority class. */
+    if(_pActiveTask->cntRoundRobin != 0)
+    {
+        if(--_pActiveTask->cntRoundRobin == 0)
+        {
+            /* Time slice of active task has elapsed. Reload the counter. */
+            _pActiveTask->cntRoundRobin = _pActiveTask->timeRoundRobin;
+
+            uint8_t prio = _pActiveTask->prioClass
+                  , noTasks = _noDueTasksAry[prio];
+
+            /* If there are more due tasks in the same class the next one will be made the
+               active one by a cyclic move of the positions in the list. */
+            if(noTasks-- > 1)
+            {
+                uint8_t idxTask;
+
+                /* The list of due tasks in the active priority class is rolled by one task.
+                   The next due task will become active.
+                     Note: noTasks has been decremented before in the if. */
+                for(idxTask=0; idxTask<noTasks; ++idxTask)
+                    _pDueTaskAryAry[prio][idxTask] = _pDueTaskAryAry[prio][idxTask+1];
+                _pDueTaskAryAry[prio][idxTask] = _pActiveTask;
+
+                /* Force check for new active task - even if no suspended task should have been
+                   resumed. */
+                activeTaskMayChange = true;
+
+            } /* if(Did the task loose against another due one?) */
+
+        } /* if(Did the round robin time of the task elapse?) */
+
+    } /* if(Do we have a round robin task?) */
+#endif
+
+    /* Check if another task becomes active because of the possibly occurred timer events.
+         activeTaskMayChange: We do the search for the new active task only if at least one
+       suspended task was resumed. If round robin is compiled it depends. Always look for a
+       new active task if the round robin time has elapsed.
+         The function has side effects: If there's a task which was suspended before and
+       which is resumed because of the timer events and which is of higher priority than
+       the one being active so far, the refernces to the old and newly active task are
+       written into global variables _pSuspendedTask and _pActiveTask. */
+    return activeTaskMayChange && lookForActiveTask();
+
+} /* End of onTimerTic. */
+
+
+
+
+
+
+/**
+ * Each call of this function cyclically increments the system time of the kernel by one.\n
+ *   Incrementing the system timer is an important system event. The routine will always
+ * include an inspection of all suspended tasks, whether they could become due again.
+ *   The cycle time of the system time is low (typically implemented as 0..255) and
+ * determines the maximum delay time or timeout for a task which suspends itself and the
+ * ratio of the task periods of the fastest and the slowest regular task. Furthermore it
+ * determines the reliability of task overrun recognition. Task overrun events in the
+ * magnitude of half the cycle time won't be recognized as such.\n
+ *   The unit of the time is defined only by the it triggering source and doesn't matter at
+ * all for the kernel. The time even don't need to be regular.\n
+ *   @remark
+ * The function needs to be called by an interrupt and can easily end with a context change,
+ * i.e. the interrupt will return to another task as the one it had interrupted.
+ *   @remark
+ * The connected interrupt is defined by macro #RTOS_ISR_SYSTEM_TIMER_TIC. This interrupt
+ * needs to be disabled/enabled by the implementation of \a enterCriticalSection and \a
+ * leaveCriticalSection.
+ *   @remark
+ * The cycle time of the system time can be influenced by the typedef of uintTime_t. Find a
+ * discussion of pros and cons at the location of this typedef.
+ *   @see boolean onTimerTic(void)
+ *   @see #rtos_enterCriticalSection
+ */
+
+ISR(RTOS_ISR_SYSTEM_TIMER_TIC, ISR_NAKED)
+{
+    /* An ISR must not occur while we're updating the global data and checking for a
+       possible task switch. To be more precise: The call of onTimerTic would just require
+       to inhibit all those interrupts which might initiate a task switch. As long as no
+       user defined interrupts are configured to set an RTOS event, this is only the single
+       timer interrupt driving the system time. However, at latest when a task switch
+       really is initiated we would need to lock all interrupts globally (as we modify the
+       stack pointer in non-atomic operation). It doesn't matter to have locked all
+       interrupts globally already here. */
+
+    /* Save context onto the stack of the interrupted active task. */
+    PUSH_CONTEXT_ONTO_STACK
+
+	/* We must not exclude that the zero_reg is temporarily altered in the arbitrarily
+       interrupted code. To make the local code here running, we need to anticipate this
+       situation and clear the register. */
+    asm volatile
+    ("clr __zero_reg__ \n\t"
+    );
+
+    /* Check for all suspended tasks if this change in time is an event for them. */
+    if(onTimerTic())
+    {
+        /* Yes, another task becomes active with this timer tic. Switch the stack pointer
+           to the (saved) stack pointer of that task. */
+        SWITCH_CONTEXT
+        CHECK_STACK_GUARD_OF_SUSPENDED_TASK
+        PUSH_RET_CODE_OF_CONTEXT_SWITCH
+    }
+
+    /* The highly critical operation of modifying the stack pointer is done. From now on,
+       all interrupts could safely operate on the new stack, the stack of the new task. This
+       includes such an interrupt which would cause another task switch. However, early
+       releasing the global interrupts here could lead to higher use of stack area if many
+       task switches appear one after another. Therefore we will reenable the interrupts
+       only with the final reti command. The disadvantage is probably minor (some clock
+       tics less of responsiveness of the system). */
+
+    /* The stack pointer points to the now active task (which will often be still the same
+       as at function entry). The CPU context to continue with is popped from this stack. If
+       there's no change in active task the entire routine call is just like any ordinary
+       interrupt. */
+    POP_CONTEXT_FROM_STACK
+
+    /* The global interrupt enable flag is not saved across task switches, but always set
+       on entry into the new or same context by using a reti rather than a ret.
+         If we return to the same context, this will not mean that we harmfully change the
+       state of a running context without the context knowing or willing it: If the context
+       had reset the bit we would never have got here, as this is an ISR controlled by the
+       bit. */
+    asm volatile
+    ( "reti \n\t"
+    );
+
+} /* End of ISR to increment the system time by one tic. */
+
+
+
+
+
+
+/**
+ * Actual implementation of routine \a rtos_sendEvent. The task posts a set of events and the
+ * scheduler is asked which task is the one to be activated now.\n
+ *   The action of this SW interrupt is placed into an own function in order to let the
+ * compiler generate the stack frame required for all local data. (The stack frame
+ * generation of the SW interrupt entry point needs to be inhibited in order to permit the
+ * implementation of saving/restoring the task context).
+ *   @return
+ * The function determines which task is to be activated and records which task is left
+ * (i.e. the task calling this routine) in the global variables _pActiveTask and
+ * _pSuspendedTask.\n
+ *   If there is a task switch the function reports this by a return value true. If there
+ * is no task switch it returns false and the global variables _pActiveTask and
+ * _pSuspendedTask are not touched.
+ *   @param postedEventVec
+ * See software interrupt \a rtos_sendEvent.
+ *   @see
+ * void rtos_sendEvent(uintEventVec_t)
+ *   @remark
+ * This function and particularly passing the return codes via a global variable will
+ * operate only if all interrupts are disabled.
+ */
+
+static RTOS_TRUE_FCT boolean sendEvent(uintEventVec_t postedEventVec)
+{
+    /* Avoid inlining under all circumstances. See attributes also. */
+    asm("");
+
+    boolean activeTaskMayChange = false;
+    
+    /* The timer events must not be set manually. */
+    ASSERT((postedEventVec & MASK_EVT_IS_TIMER) == 0);
+
+#if RTOS_COUNTED_EVENT_MASK != 0
+    /* Count the posts of the counted events. The mask is a compile time constant, the
+       loop is cheap if no counted event is posted. */
+    uintEventVec_t countedEventVec = postedEventVec & (RTOS_COUNTED_EVENT_MASK);
+    if(countedEventVec != 0)
+    {
+        uintEventVec_t maskCounted = RTOS_COUNTED_EVENT_MASK;
+        uint8_t idxCnt = 0;
+        do
+        {
+            if((maskCounted & 0x01) != 0)
+            {
+                if((countedEventVec & 0x01) != 0)
+                    ++ _cntPostedEventAry[idxCnt];
+                ++ idxCnt;
+            }
+            maskCounted >>= 1;
+            countedEventVec >>= 1;
+        }
+        while(countedEventVec != 0);
+    }
+#endif
+
+    /* We keep track of all semaphores and mutexes, which have to be posted (released)
+       exactly once - to the first task, which is waiting for them. This task is done,
+       when the related mask, semaphoreToReleaseVec or mutexToReleaseVec becomes null. */
+#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
+    uint8_t semaphoreToReleaseVec = postedEventVec & MASK_EVT_IS_SEMAPHORE;
+#endif
+#if RTOS_USE_MUTEX == RTOS_FEATURE_ON
+    uintEventVec_t mutexToReleaseVec = postedEventVec & MASK_EVT_IS_MUTEX;
+# ifdef DEBUG
+    uintEventVec_t dbg_allMutexesToReleaseVec = mutexToReleaseVec;
+# endif
+#endif
+#if RTOS_USE_MUTEX == RTOS_FEATURE_ON  ||  RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
+    /* The implementation makes a distinction between synchronization objects (mutex and
+       semaphores) and ordinary, broadcasted events. */
+    postedEventVec &= ~(MASK_EVT_IS_MUTEX | MASK_EVT_IS_SEMAPHORE);
+#endif
+
+    /* Post ordinary events to all suspended tasks which are waiting for it.
+         Pass mutexes and semaphores to a single task each, those task, which is of highest
+       priority and waits the longest for it. This loop is the reason, why we need to have
+       the list of suspended tasks always sorted, when at least one semaphore or mutex is in
+       use. */
+    uint8_t idxSuspTask = 0;
+    while(idxSuspTask<_noSuspendedTasks)
+    {
+        task_t * const pT = _pSuspendedTaskAry[idxSuspTask];
+        
+        /* Remember the received events before (possibly) getting some more by this
+           sendEvent: Only if this set changes it is necessary to check for a state
+           transition of the task. */
+        const uintEventVec_t postedEventVecBefore = pT->postedEventVec;
+
+#if RTOS_USE_MUTEX == RTOS_FEATURE_ON
+        /* Mutexes are Boolean and can't be posted twice to a task. This is easily possible
+           but an application error. This assertion fires if the application doesn't
+           properly keep track of who owns which mutex. */
+        ASSERT((pT->postedEventVec & dbg_allMutexesToReleaseVec) == 0);
+
+        /* The vector of all events this task will receive. */
+        uintEventVec_t gotEvtVec = (postedEventVec | mutexToReleaseVec) & pT->eventMask;
+
+        /* Collect the events in the task object. */
+        pT->postedEventVec |= gotEvtVec;
+
+        /* Subtract the given mutexes from the vector of all, which are to release in this
+           call. It doesn't matter that the mask also contains ordinary events - all these
+           bits can do is to reset already reset bits. */
+        mutexToReleaseVec &= ~gotEvtVec;
+#else
+        pT->postedEventVec |= (postedEventVec & pT->eventMask);
+
+#endif /* RTOS_USE_MUTEX == RTOS_FEATURE_ON */
+
+#if RTOS_USE_EVENT_DATA == RTOS_FEATURE_ON
+        /* The data word is delivered to all tasks, which receive an ordinary event. A
+           second post before the task is resumed overwrites the mailbox; the task will see
+           the newest data. */
+        if(_isEventDataToPost  &&  (postedEventVec & pT->eventMask) != 0)
+            pT->eventData = _eventDataToPost;
+#endif
+
+#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
+        /* Now pass all released semaphores to tasks waiting for them. This can't be done
+           all at once as semaphores are not simply a bit. We need a second loop to do so.
+             Remark: The implementation of the loops here and down below is the reason why
+           we (arbitrarily) restrict the maximum number to eight: We can use native CPU
+           machine codes for most operations instead of much more expensive 16 Bit
+           operations. */
+        uint8_t semMask = 0x01;
+        while(semaphoreToReleaseVec != 0  &&  (semMask & MASK_EVT_IS_SEMAPHORE) != 0)
+        {
+            /* Check if this task is waiting for this semaphore but didn't get it yet (i.e.
+               in an earlier call of this routine). */
+            if((semaphoreToReleaseVec & semMask & pT->eventMask & ~pT->postedEventVec) != 0)
+            {
+                /* The semaphore release operation is handled by passing the semaphore to
+                   the task. */
+                pT->postedEventVec    |= semMask;
+                semaphoreToReleaseVec &= ~semMask;
+            }
+
+            /* Shift mask one Bit to the left to test next semaphore in next cycle. */
+            semMask <<= 1;
+        }
+#endif
+
+        /* Check if this suspended task becomes due because of an event, which was posted
+           to it. */
+        if(postedEventVecBefore != pT->postedEventVec  && checkTaskForActivation(idxSuspTask))
+        {
+            /* The task becomes due. */
+            activeTaskMayChange = true;
+
+            /* Check next suspended task, which is in this case found in the array
+               element with same index: The task which became due has been removed into the
+               due list of its priority class. */
+        }
+        else
+        {
+            /* The task remains suspended. */
+
+            /* Check next suspended task, which is in this case found in the next array
+               element. */
+            ++ idxSuspTask;
+
+        } /* End if(Did this suspended task become due?) */
+
+    } /* End while(All suspended tasks) */
+
+#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
+    /* The remaining semaphores (more precise: semaphore counter values) are accumulated in
+       the global semaphore storage for later acquisition. */
+    uint8_t idxSem = 0;
+    while(semaphoreToReleaseVec)
+    {
+        if((semaphoreToReleaseVec & 0x01) != 0)
+        {
+            ++ rtos_semaphoreAry[idxSem];
+
+            /* The assertion validates the application code. It fires if the application
+               releases/produces more semaphore counter values as fit into the data type of
+               the semphore. This is harmless with respect to the stability of the RTOS but
+               probably a design error in the application. */
+            ASSERT(rtos_semaphoreAry[idxSem] != 0);
+        }
+
+        /* Test next semaphore in next cycle. */
+        semaphoreToReleaseVec >>= 1;
+
+        /* The next event/semaphore bit is related to the next array entry. */
+        ++ idxSem;
+    }
+#endif
+#if RTOS_USE_MUTEX == RTOS_FEATURE_ON
+    /* The remaining mutexes are returned to the global storage for later acquisition.
+         The assertion validates application code. It fires if the application releases
+       a mutex, which was not acquired. This is harmless with respect to the stability of
+       the RTOS but probably a design error in the application. Maybe, you have to
+       consider using a semaphore. */
+    ASSERT((_mutexVec & dbg_allMutexesToReleaseVec) == 0);
+    _mutexVec |= mutexToReleaseVec;
+#endif /* RTOS_USE_MUTEX == RTOS_FEATURE_ON */
+
+#if RTOS_USE_EVENT_DATA == RTOS_FEATURE_ON
+    /* The data word belongs to this call only. */
+    _isEventDataToPost = false;
+#endif
+
+
+    /* Check if another task becomes active because of the posted events.
+         activeTaskMayChange: We do the search for the new active task only if at least one
+       suspended task was resumed.
+         The function has side effects: If there's a task which was suspended before and
+       which is resumed because of an event and which is of higher priority than the one
+       being active so far, the refernces to the old and newly active task are written into
+       global variables _pSuspendedTask and _pActiveTask. */
+    return activeTaskMayChange && lookForActiveTask();
+    
+} /* End of sendEvent */
+
+
+
+
+
+/**
+ * The code, which is shared by all application interrupts: The interrupt posts an event
+ * to the tasks and initiates a task switch if a task of higher priority is resumed by the
+ * event.\n
+ *   The function is not called but entered by a jump from the ISR stubs, which are
+ * generated by macro #DEFINE_ISR_TO_EVENT. A stub has saved the register pair r24/r25 of
+ * the interrupted context and loaded the pair with the event vector.\n
+ *   The stubs generated by #DEFINE_ISR_TO_TOP_HALF enter at a second entry point. They
+ * have loaded r24/r25 with the address of an application supplied top half. The top half
+ * is called after saving the registers and its return value is the event vector to
+ * post.\n
+ *   Most interrupts will not cause a task switch. Therefore, the function saves only those
+ * registers, which are not preserved by the compiler generated code of sendEvent. If no
+ * task switch results, these few registers are restored and the ISR returns; the cost is
+ * less than half of saving and restoring the complete context. Only in case of a task
+ * switch, the registers are restored and the complete context of the interrupted task is
+ * saved onto its stack.
+ *   @param eventVec
+ * The posted event vector, it is received in register pair r24/r25 (r22..r25 with 32 Bit
+ * event vectors).
+ *   @remark
+ * The application interrupts are of global influence. There's only one ISR for each
+ * interrupt source. If you'd e.g. use TIMER0_OVF_vect, you'd disable the time measurement
+ * routines of Arduino. Functions like \a millis() or \a delay() would no longer work.
+ *   @remark
+ * The stacked registers, which are saved for the call of sendEvent, need to be maintained
+ * in strict accordance with the ISR stubs generated by #DEFINE_ISR_TO_EVENT.
+ *   @see
+ * void rtos_sendEvent(uintEventVec_t)
+ */
+
+static RTOS_NAKED_FCT RTOS_TRUE_FCT void sendEventFromISR(uintEventVec_t eventVec)
+{
+    /* Save all registers, which are not preserved by a called C function. r24/r25 (and
+       r22/r23 with 32 Bit event vectors) have already been saved by the ISR stub. We must
+       not exclude that the zero_reg is temporarily altered in the arbitrarily interrupted
+       code. To make the local code here running, we need to anticipate this situation and
+       clear the register. */
+#define ASM_SAVE_CALL_CLOBBERED_REGISTERS   \
+      "push r0 \n\t"                        \
+      "in r0, __SREG__ \n\t"                \
+      "push r0 \n\t"                        \
+      "push r1 \n\t"                        \
+      "clr __zero_reg__ \n\t"               \
+      "push r18 \n\t"                       \
+      "push r19 \n\t"                       \
+      "push r20 \n\t"                       \
+      "push r21 \n\t"                       \
+      ASM_PUSH_R22R23_OF_CONTEXT            \
+      "push r26 \n\t"                       \
+      "push r27 \n\t"                       \
+      "push r30 \n\t"                       \
+      "push r31 \n\t"
+
+    /* The entry for the top half ISRs: After saving the registers, the top half is called
+       through the pointer in r24/r25. Its return value, the event vector, is received in
+       the same registers, where the C code below expects the function argument. */
+    asm volatile
+    ( "LabelEntryTopHalfFromISR: \n\t"
+      ASM_SAVE_CALL_CLOBBERED_REGISTERS
+      "movw r30, r24 \n\t"
+      "icall \n\t"
+      "rjmp 1f \n\t"
+      "LabelEntrySendEventFromISR: \n\t"
+      ASM_SAVE_CALL_CLOBBERED_REGISTERS
+      "1: \n\t"
+    );
+#undef ASM_SAVE_CALL_CLOBBERED_REGISTERS
+
+/** \cond The inverse of the register saving code at function entry. The r24/r25 of the
+    ISR stub are restored, too. */
+#define RESTORE_CALL_CLOBBERED_REGISTERS    \
+    asm volatile                            \
+    ( "pop r31 \n\t"                        \
+      "pop r30 \n\t"                        \
+      "pop r27 \n\t"                        \
+      "pop r26 \n\t"                        \
+      ASM_POP_R22R23_OF_CONTEXT             \
+      "pop r21 \n\t"                        \
+      "pop r20 \n\t"                        \
+      "pop r19 \n\t"                        \
+      "pop r18 \n\t"                        \
+      "pop r1 \n\t"                         \
+      "pop r0 \n\t"                         \
+      "out __SREG__, r0 \n\t"               \
+      "pop r0 \n\t"                         \
+      ASM_POP_EVENT_VEC_REGS                \
+    );
+/** \endcond */
+
+    if(eventVec != 0  &&  sendEvent(eventVec))
+    {
+        /* A task of higher priority becomes active because of the posted events. Now the
+           complete context of the interrupted task is required: Restore the interrupted
+           state of the registers and push all of them in the normal context order. The
+           global interrupt flag stays reset; it is not set in the SREG value, which has
+           been saved inside the ISR. */
+        RESTORE_CALL_CLOBBERED_REGISTERS
+        PUSH_CONTEXT_ONTO_STACK
+        asm volatile
+        ("clr __zero_reg__ \n\t"
+        );
+
+        /* Switch the stack pointer to the (saved) stack pointer of the new active task. */
+        SWITCH_CONTEXT
+        CHECK_STACK_GUARD_OF_SUSPENDED_TASK
+        PUSH_RET_CODE_OF_CONTEXT_SWITCH
+
+        /* The CPU context to continue with is popped from the stack of the new task. */
+        POP_CONTEXT_FROM_STACK
+        asm volatile
+        ( "reti \n\t"
+        );
+    }
+
+#if RTOS_USE_EVENT_DATA == RTOS_FEATURE_ON
+    /* A top half may have set a data word by rtos_setEventDataFromISR but returned no
+       event. sendEvent has not been called and the word must not go with a later post. */
+    _isEventDataToPost = false;
+#endif
+
+    /* Fast exit: The interrupted task stays the active task. Only the saved registers are
+       restored. */
+    RESTORE_CALL_CLOBBERED_REGISTERS
+    asm volatile
+    ( "reti \n\t"
+    );
+
+#undef RESTORE_CALL_CLOBBERED_REGISTERS
+} /* End of sendEventFromISR */
+
+
+
+
+/* Define the stubs of all configured application interrupt service routines, see
+   #RTOS_USE_APPL_INTERRUPT_00, #RTOS_USE_APPL_INTERRUPT_01 and #RTOS_APPL_INTERRUPT_LIST. */
+ALL_APPL_INTERRUPTS(DEFINE_ISR_TO_EVENT, DEFINE_ISR_TO_TOP_HALF)
+
+
+
+
+
+/**
+ * A task (including the idle task) may post an event. The event is broadcasted to all
+ * suspended tasks which are waiting for it. An event is not saved beyond that. If a task
+ * suspends and starts waiting for an event which has been posted by another task just
+ * before, it'll wait forever and never be resumed.\n
+ *   The posted event may resume another task, which may be of higher priority as the
+ * event posting task. In this case \a sendEvent will cause a task switch. The calling task
+ * stays due but stops to be the active task. It does not become suspended (this is why
+ * even the idle task may call this function). The activated task will resume by coming out
+ * of the suspend command it had been invoked to wait for this event. The return value of
+ * this suspend command will then tell about the event set here.\n
+ *   If no task of higher priority is resumed by the posted event the calling task will be
+ * continued immediately after execution of this method. In this case \a sendEvent behaves
+ * like any ordinary sub-routine.
+ *   @param eventVec
+ * A bit vector of posted events. Known events are defined in rtos.h. The timer events
+ * RTOS_EVT_ABSOLUTE_TIMER and RTOS_EVT_DELAY_TIMER cannot be posted.
+ *   @see
+ * uintEventVec_t rtos_waitForEvent(uintEventVec_t, boolean, uintTime_t)
+ *   @remark
+ * It is absolutely essential that this routine is implemented as naked and noinline. See
+ * http://gcc.gnu.org/onlinedocs/gcc/Function-Attributes.html for details
+ *   @remark
+ * In optimization level 0 GCC has a problem with code generation for naked functions. See
+ * function #rtos_suspendTaskTillTime for details.
+ *   @remark
+ * The application interrupt service routines don't use this function but share the code
+ * of sendEventFromISR.
+ */
+#ifndef __OPTIMIZE__
+# error This code must not be compiled with optimization off. See source code comments for more
+#endif
+
+RTOS_NAKED_FCT void rtos_sendEvent(uintEventVec_t eventVec)
+{
+    /* This function is a pseudo-software interrupt. A true interrupt had reset the global
+       interrupt enable flag, we inhibit any interrupts now. */
+    asm volatile
+    ( "cli \n\t"
+    );
+
+    /* The program counter as first element of the context is already on the stack (by
+       calling this function). Save rest of context onto the stack of the interrupted
+       active task. sendEvent does not return anything; we push register pair r24/25 and
+       this will be restored on function exit. */
+    PUSH_CONTEXT_ONTO_STACK
+
+    /* Check for all suspended tasks if the posted events will resume them.
+         The actual implementation of the function's logic is placed into a sub-routine in
+       order to benefit from the compiler generated stack frame for local variables (in
+       this naked function we must not have declared any). */
+    if(sendEvent(eventVec))
+    {
+        /* Yes, another task becomes active because of the posted events. Switch the stack
+           pointer to the (saved) stack pointer of that task. */
+        SWITCH_CONTEXT
+        CHECK_STACK_GUARD_OF_SUSPENDED_TASK
+        PUSH_RET_CODE_OF_CONTEXT_SWITCH
+    }
+
+    /* The stack pointer points to the now active task (which will often be still the same
+       as at function entry). The CPU context to continue with is popped from this stack. If
+       there's no change in active task the entire routine call is just like any ordinary
+       interrupt. */
+    POP_CONTEXT_FROM_STACK
+
+    /* The global interrupt enable flag is not saved across task switches, but always set
+       on entry into the new or same context by using a reti rather than a ret. */
+    asm volatile
+    ( "reti \n\t"
+    );
+
+} /* End of rtos_sendEvent */
+
+
+
+
+#if RTOS_USE_SET_TASK_PRIORITY == RTOS_FEATURE_ON
+/**
+ * Implementation of the priority change of a task, which is invoked from the
+ * pseudo-software interrupt \a rtos_setTaskPriority. The task is moved from the lists of
+ * its old priority class into the lists of the new one.\n
+ *   A due task is taken out of the list of due tasks of its old class and appended to the
+ * list of its new class; in the EDF class it is inserted according to its deadline. A
+ * suspended task stays in the list of suspended tasks. If mutexes or semaphores are in use
+ * this list is sorted by priority and the task is moved to the end of the tasks of its new
+ * class, as if it had just started waiting.\n
+ *   The execution time is bounded: Not more than #RTOS_MAX_NO_TASKS_IN_PRIO_CLASS list
+ * elements are moved if the task is due and not more than #RTOS_NO_TASKS elements if it
+ * is suspended.
+ *   @return
+ * The function determines which task is to be activated and records which task is left
+ * (i.e. the task calling this routine) in the global variables _pActiveTask and
+ * _pSuspendedTask.\n
  *   If there is a task switch the function reports this by a return value true. If there
- * is no task switch it returns false and the global variables _pActiveTask and
- * _pSuspendedTask are not touched.
- *   @param postedEventVec
- * See software interrupt \a rtos_sendEvent.
+ * is no task switch it returns false and _pActiveTask is unchanged. _pSuspendedTask may
+ * have been overwritten with the active task in this case; the caller must not evaluate
+ * it.
+ *   @param idxTask
+ * See software interrupt \a rtos_setTaskPriority.
+ *   @param prioClass
+ * See software interrupt \a rtos_setTaskPriority.
+ *   @see
+ * void rtos_setTaskPriority(uint8_t, uint8_t)
+ *   @remark
+ * This function and particularly passing the return codes via a global variable will
+ * operate only if all interrupts are disabled.
+ */
+
+static RTOS_TRUE_FCT boolean setTaskPriority(uint8_t idxTask, uint8_t prioClass)
+{
+    /* Avoid inlining under all circumstances. See attributes also. */
+    asm("");
+
+    ASSERT(idxTask < RTOS_NO_TASKS  &&  prioClass < RTOS_NO_PRIO_CLASSES);
+#if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON  \
+    &&  RTOS_USE_EDF_PRIO_CLASS == RTOS_FEATURE_ON
+    /* The tasks of the EDF class must not have a round robin time slice. */
+    ASSERT(prioClass != RTOS_EDF_PRIO_CLASS  ||  _taskAry[idxTask].timeRoundRobin == 0);
+#endif
+
+    task_t * const pT = &_taskAry[idxTask];
+
+    if(prioClass == pT->prioClass)
+        return false;
+
+#if RTOS_USE_EDF_PRIO_CLASS == RTOS_FEATURE_ON
+# if RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_OFF
+    /* A due task had no absolute deadline in its old class. It is due from now on. (For a
+       suspended task the deadline is computed again when it becomes due.) */
+    if(prioClass == RTOS_EDF_PRIO_CLASS)
+        pT->timeDeadlineAt = _time + pT->timeDeadline;
+# else
+    /* The deadline monitor has computed the absolute deadline of a due task when it
+       became due, regardless of its class. This deadline is kept: It is checked by the
+       monitor and it determines the position of the task in the EDF class. */
+# endif
+#endif
+
+    /* The search in the list of due tasks needs to be done with the old class. The active
+       task is the first element of the list of its class. */
+    if(takeTaskOutOfDueList(pT))
+    {
+        pT->prioClass = prioClass;
+        putTaskIntoDueList(pT);
+
+        /* The active task may change: Either the changed task is now of higher priority
+           than the active task or the active task has been lowered in priority. The
+           search can't fail, the changed task is due. */
+        return lookForActiveTask();
+    }
+    else
+    {
+        pT->prioClass = prioClass;
+
+#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
+        /* The task is suspended. The list of suspended tasks is sorted by decreasing
+           priority; it decides, which task gets a released mutex or semaphore. Move the
+           task to its new position. */
+        if(takeTaskOutOfSuspendedList(pT))
+            putTaskIntoSuspendedList(pT);
+#endif
+        /* A suspended task doesn't compete for the CPU, the active task doesn't change. */
+        return false;
+    }
+} /* End of setTaskPriority */
+
+
+
+
+/**
+ * Change the priority class of a task at runtime. The priority class had been set at
+ * initialization time of the task, either by \a rtos_initializeTask or in the task list
+ * #RTOS_TASK_LIST. A typical use case is a task, which becomes urgent in some situations,
+ * e.g. a logging task with a nearly full buffer.\n
+ *   The function may be called by any task for any task including itself. It may also be
+ * called by the idle task. The change becomes effective immediately: If a due task gets a
+ * higher priority than the calling task or if the calling task lowers its own priority
+ * below the one of another due task, then the calling task is preempted inside this
+ * function call. It stays due and is continued later, like after a preemption by an
+ * interrupt.\n
+ *   A due task is put at the end of the list of due tasks of its new priority class. It
+ * will be activated after the other due tasks of the class, which are waiting longer. The
+ * same holds for a suspended task and the distribution of mutexes and semaphores. If the
+ * new class is the EDF class, #RTOS_EDF_PRIO_CLASS, the absolute deadline of a due task is
+ * computed from now on. If #RTOS_USE_DEADLINE_MONITOR is on, the task keeps the absolute
+ * deadline, which has been armed when it became due, and it is sorted into the EDF class
+ * accordingly; the monitored deadline is not moved by the change of priority.\n
+ *   The execution time is bounded and it doesn't depend on the application state
+ * otherwise. Interrupts are globally disabled while not more than
+ * #RTOS_MAX_NO_TASKS_IN_PRIO_CLASS (task is due) or #RTOS_NO_TASKS (task is suspended)
+ * list elements are moved.
+ *   @param idxTask
+ * The index of the task to change. The index is the same as used when initializing the
+ * tasks (see rtos_initializeTask).
+ *   @param prioClass
+ * The new priority class, 0..#RTOS_NO_PRIO_CLASSES-1.
+ *   @remark
+ * The number of tasks, which belong to a priority class, must never exceed
+ * #RTOS_MAX_NO_TASKS_IN_PRIO_CLASS; this holds after a change of priority, too. It's the
+ * responsibility of the application. The kernel double-checks this in DEBUG compilation
+ * only and only for due tasks.
+ *   @remark
+ * A task with round robin time slice must not be moved into the EDF class.
+ *   @remark
+ * The function must not be called from an interrupt service routine.
+ *   @remark
+ * It is absolutely essential that this routine is implemented as naked and noinline. See
+ * http://gcc.gnu.org/onlinedocs/gcc/Function-Attributes.html for details
+ *   @remark
+ * In optimization level 0 GCC has a problem with code generation for naked functions. See
+ * function #rtos_suspendTaskTillTime for details.
+ */
+
+RTOS_NAKED_FCT void rtos_setTaskPriority(uint8_t idxTask, uint8_t prioClass)
+{
+    /* This function is a pseudo-software interrupt. A true interrupt had reset the global
+       interrupt enable flag, we inhibit any interrupts now. */
+    asm volatile
+    ( "cli \n\t"
+    );
+
+    /* The program counter as first element of the context is already on the stack (by
+       calling this function). Save rest of context onto the stack of the interrupted
+       active task. The function doesn't return anything; we push register pair r24/25 and
+       this will be restored on function exit. */
+    PUSH_CONTEXT_ONTO_STACK
+
+    /* The actual implementation of the function's logic is placed into a sub-routine in
+       order to benefit from the compiler generated stack frame for local variables (in
+       this naked function we must not have declared any). */
+    if(setTaskPriority(idxTask, prioClass))
+    {
+        /* Yes, another task becomes active because of the priority change. Switch the
+           stack pointer to the (saved) stack pointer of that task. */
+        SWITCH_CONTEXT
+        CHECK_STACK_GUARD_OF_SUSPENDED_TASK
+        PUSH_RET_CODE_OF_CONTEXT_SWITCH
+    }
+
+    /* The stack pointer points to the now active task. The CPU context to continue with
+       is popped from this stack. */
+    POP_CONTEXT_FROM_STACK
+
+    /* The global interrupt enable flag is not saved across task switches, but always set
+       on entry into the new or same context by using a reti rather than a ret. */
+    asm volatile
+    ( "reti \n\t"
+    );
+
+} /* End of rtos_setTaskPriority */
+#endif
+
+
+
+
+#if RTOS_USE_TASK_CONTROL == RTOS_FEATURE_ON
+/**
+ * Implementation of the task control operations, which is invoked from the
+ * pseudo-software interrupt \a swiControlTask. See \a rtos_suspendTask, \a rtos_resumeTask
+ * and \a rtos_restartTask for the meaning of the operations.\n
+ *   The execution time is bounded: Not more than #RTOS_MAX_NO_TASKS_IN_PRIO_CLASS plus
+ * #RTOS_NO_TASKS list elements are inspected and moved and a restart writes the initial
+ * context of about 35 Byte onto the stack of the task.
+ *   @return
+ * The function determines which task is to be activated and records which task is left
+ * (i.e. the task calling this routine) in the global variables _pActiveTask and
+ * _pSuspendedTask.\n
+ *   If there is a task switch the function reports this by a return value true. If there
+ * is no task switch it returns false and _pActiveTask is unchanged. _pSuspendedTask may
+ * have been overwritten with the active task in this case; the caller must not evaluate
+ * it.
+ *   @param idxTask
+ * The index of the task to control.
+ *   @param operation
+ * The operation, one out of TASK_CONTROL_SUSPEND, TASK_CONTROL_RESUME and
+ * TASK_CONTROL_RESTART.
+ *   @remark
+ * This function and particularly passing the return codes via a global variable will
+ * operate only if all interrupts are disabled.
+ */
+
+static RTOS_TRUE_FCT boolean controlTask(uint8_t idxTask, uint8_t operation)
+{
+    /* Avoid inlining under all circumstances. See attributes also. */
+    asm("");
+
+    ASSERT(idxTask < RTOS_NO_TASKS);
+    task_t * const pT = &_taskAry[idxTask];
+
+    if(operation == TASK_CONTROL_SUSPEND)
+    {
+        /* Suspending a halted task has no effect. */
+        if(pT->haltState != TASK_NOT_HALTED)
+            return false;
+
+        if(takeTaskOutOfDueList(pT))
+        {
+            pT->haltState = TASK_HALTED_WHILE_DUE;
+#if RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_ON
+            /* The activation is interrupted on purpose. Its deadline is no longer
+               monitored; the halted task would otherwise be reported as late. */
+            disarmTaskDeadline(pT);
+#endif
+
+            /* If a task halts itself, another task becomes active. It's not guaranteed
+               that there is any due task. Idle is the fallback. The loop requires a signed
+               index. */
+            if(pT == _pActiveTask)
+            {
+                int8_t idxPrio;
+
+                _pSuspendedTask = _pActiveTask;
+                _pActiveTask = _pIdleTask;
+                for(idxPrio=RTOS_NO_PRIO_CLASSES-1; idxPrio>=0; --idxPrio)
+                {
+                    if(_noDueTasksAry[idxPrio] > 0)
+                    {
+                        _pActiveTask = _pDueTaskAryAry[idxPrio][0];
+                        break;
+                    }
+                }
+                return true;
+            }
+        }
+        else
+        {
+#ifdef DEBUG
+            const boolean isSuspended =
+#endif
+            takeTaskOutOfSuspendedList(pT);
+            ASSERT(isSuspended);
+            pT->haltState = TASK_HALTED_WHILE_WAITING;
+            pT->timeHaltedAt = _time;
+        }
+
+        /* The active task is not affected if another task is taken out of a list. */
+        return false;
+    }
+    else if(operation == TASK_CONTROL_RESUME)
+    {
+        if(pT->haltState == TASK_HALTED_WHILE_DUE)
+        {
+            /* The task continues where it had been preempted. It is due again. It keeps
+               its absolute deadline if it belongs to the EDF class. */
+            pT->haltState = TASK_NOT_HALTED;
+            putTaskIntoDueList(pT);
+            return lookForActiveTask();
+        }
+        else if(pT->haltState == TASK_HALTED_WHILE_WAITING)
+        {
+            /* The task continues waiting for its events. */
+            pT->haltState = TASK_NOT_HALTED;
+            const uint8_t idxSuspTask = putTaskIntoSuspendedList(pT);
+
+            /* The absolute timer is checked for equality with the system time in every
+               tic. If the due time has passed while the task was halted, it'll never be
+               seen. Post the event now. The duration of the halt is compared with the time,
+               which had been left till the due time when the task was halted. Other than a
+               signed comparison of due time and system time, this holds for halts of up to
+               a full cycle of the system time. A time-triggered task, which hasn't been
+               released by the schedule table meanwhile, continues waiting. */
+            const uintTime_t tiHalted = _time - pT->timeHaltedAt
+                           , tiLeftAtHalt = pT->timeDueAt - pT->timeHaltedAt;
+            if((pT->eventMask & RTOS_EVT_ABSOLUTE_TIMER) != 0
+               &&  tiHalted >= tiLeftAtHalt
+#ifdef RTOS_SCHEDULE_TABLE
+               &&  !pT->isWaitingForScheduleSlot
+#endif
+              )
+            {
+                pT->postedEventVec |= RTOS_EVT_ABSOLUTE_TIMER;
+                if(checkTaskForActivation(idxSuspTask))
+                    return lookForActiveTask();
+            }
+        }
+
+        /* Resuming a task, which is not halted, has no effect. */
+        return false;
+    }
+    else
+    {
+        ASSERT(operation == TASK_CONTROL_RESTART);
+
+        /* A task can't restart itself; the stack, which is reinitialized here, is in use. */
+        ASSERT(pT != _pActiveTask);
+
+        /* Take the task out of any list. */
+        if(pT->haltState == TASK_NOT_HALTED  &&  !takeTaskOutOfDueList(pT))
+        {
+#ifdef DEBUG
+            const boolean isSuspended =
+#endif
+            takeTaskOutOfSuspendedList(pT);
+            ASSERT(isSuspended);
+        }
+        pT->haltState = TASK_NOT_HALTED;
+#if RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_ON
+        /* The current activation of a due task is abandoned. Its deadline is no longer
+           monitored; the new activation gets a new one. */
+        if(pT->isDeadlineArmed)
+            disarmTaskDeadline(pT);
+#endif
+
+        /* The stack contents are lost. The task will start at the entry of its task
+           function. Below the initial context, the stack area keeps its former contents.
+           The pattern bytes of the unused area are still in place and stack usage reports
+           remain valid. */
+        pT->stackPointer = (uint16_t)prepareTaskStack( GET_STACK_AREA(idxTask)
+                                                     , GET_STACK_SIZE(idxTask)
+                                                     , GET_TASK_FUNCTION(idxTask)
+                                                     );
+
+        /* The task becomes due immediately. A task, which starts from a new stack, needs to
+           get a non-zero resume condition; the new context doesn't contain the registers,
+           which pass the resume condition to the task function. */
+        pT->postedEventVec = RTOS_EVT_DELAY_TIMER;
+        pT->eventMask = RTOS_EVT_DELAY_TIMER;
+        pT->cntDelay = 0;
+#if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON
+        pT->cntRoundRobin = pT->timeRoundRobin;
+#endif
+#if TASK_HAS_DEADLINE
+        pT->timeDeadlineAt = _time + pT->timeDeadline;
+#endif
+#if RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_ON
+        armTaskDeadline(pT);
+#endif
+#if RTOS_USE_EVENT_DATA == RTOS_FEATURE_ON
+        pT->eventData = 0;
+#endif
+#ifdef RTOS_SCHEDULE_TABLE
+        pT->isWaitingForScheduleSlot = false;
+#endif
+#if RTOS_USE_TASK_STATISTICS == RTOS_FEATURE_ON
+        /* A restart is a release of the task. */
+        recordTaskRelease(pT, RTOS_EVT_DELAY_TIMER);
+#endif
+        putTaskIntoDueList(pT);
+        return lookForActiveTask();
+    }
+} /* End of controlTask */
+
+
+
+
+/**
+ * The pseudo-software interrupt, which is shared by the task control functions \a
+ * rtos_suspendTask, \a rtos_resumeTask and \a rtos_restartTask. The operation may cause a
+ * task switch.
+ *   @param idxTask
+ * The index of the task to control.
+ *   @param operation
+ * The operation, one out of TASK_CONTROL_SUSPEND, TASK_CONTROL_RESUME and
+ * TASK_CONTROL_RESTART.
+ *   @remark
+ * It is absolutely essential that this routine is implemented as naked and noinline. See
+ * http://gcc.gnu.org/onlinedocs/gcc/Function-Attributes.html for details
+ */
+
+static RTOS_NAKED_FCT RTOS_TRUE_FCT void swiControlTask(uint8_t idxTask, uint8_t operation)
+{
+    /* This function is a pseudo-software interrupt. A true interrupt had reset the global
+       interrupt enable flag, we inhibit any interrupts now. */
+    asm volatile
+    ( "cli \n\t"
+    );
+
+    /* The program counter as first element of the context is already on the stack (by
+       calling this function). Save rest of context onto the stack of the interrupted
+       active task. The function doesn't return anything; we push register pair r24/25 and
+       this will be restored on function exit. */
+    PUSH_CONTEXT_ONTO_STACK
+
+    /* The actual implementation of the function's logic is placed into a sub-routine in
+       order to benefit from the compiler generated stack frame for local variables (in
+       this naked function we must not have declared any). */
+    if(controlTask(idxTask, operation))
+    {
+        /* Yes, another task becomes active. Switch the stack pointer to the (saved) stack
+           pointer of that task. */
+        SWITCH_CONTEXT
+        CHECK_STACK_GUARD_OF_SUSPENDED_TASK
+        PUSH_RET_CODE_OF_CONTEXT_SWITCH
+    }
+
+    /* The stack pointer points to the now active task. The CPU context to continue with
+       is popped from this stack. */
+    POP_CONTEXT_FROM_STACK
+
+    /* The global interrupt enable flag is not saved across task switches, but always set
+       on entry into the new or same context by using a reti rather than a ret. */
+    asm volatile
+    ( "reti \n\t"
+    );
+
+} /* End of swiControlTask */
+
+
+
+
+/**
+ * Take a task out of scheduling. The task is halted: It doesn't become active any more
+ * until it is resumed by \a rtos_resumeTask or restarted by \a rtos_restartTask. A
+ * supervising task can e.g. stop a misbehaving or currently unneeded task and give its CPU
+ * time to the other tasks.\n
+ *   A task, which is due, is halted at the point, where it had been preempted. A task,
+ * which is suspended and waits for events, is halted while waiting. While it is halted it
+ * doesn't receive any events; events, which are posted in this time, are lost for the
+ * task. Its timers don't elapse either. If it had been waiting for the delay timer, the
+ * delay is prolonged by the time it is halted. If a due task has a deadline, see \a
+ * rtos_setTaskDeadline, then the deadline of its current activation is no longer
+ * monitored.\n
+ *   A task may halt itself. The function returns when another task resumes it.\n
+ *   The execution time is bounded and it doesn't depend on the application state
+ * otherwise: Interrupts are globally disabled while not more than
+ * #RTOS_MAX_NO_TASKS_IN_PRIO_CLASS plus #RTOS_NO_TASKS list elements are inspected and
+ * moved.
+ *   @param idxTask
+ * The index of the task to halt. The index is the same as used when initializing the
+ * tasks (see rtos_initializeTask). The call has no effect if the task is already halted.
+ *   @remark
+ * A mutex or semaphore, which is held by the task, is not released. The other tasks, which
+ * wait for it, will wait until the task is resumed and releases it.
+ *   @remark
+ * The idle task can't be halted. The function must not be called from an interrupt
+ * service routine.
+ *   @see void rtos_resumeTask(uint8_t)
+ */
+
+void rtos_suspendTask(uint8_t idxTask)
+{
+    swiControlTask(idxTask, TASK_CONTROL_SUSPEND);
+
+} /* End of rtos_suspendTask */
+
+
+
+
+/**
+ * Let a task, which had been halted by \a rtos_suspendTask, continue. If it had been
+ * halted while it was due, it becomes due again and it continues where it had been
+ * preempted. This may immediately preempt the calling task. If it had been halted while
+ * it was waiting for events, it continues waiting. Events, which had been posted while it
+ * was halted, are not seen. If it waits for the absolute timer and the due time has passed
+ * while the task was halted, it becomes due now.\n
+ *   The kernel can recognize the passed due time only if the task had been halted for
+ * less than a full cycle of the system time, i.e. 256 tics if #uintTime_t is an 8 Bit
+ * type. After a longer halt the number of elapsed cycles is unknown; the task may then
+ * continue waiting for up to another cycle. An application, which halts tasks for such a
+ * long time, should use \a rtos_restartTask instead or configure a wider system time.\n
+ *   The execution time is bounded: Interrupts are globally disabled while not more than
+ * #RTOS_NO_TASKS list elements are moved.
+ *   @param idxTask
+ * The index of the task to resume. The call has no effect if the task is not halted.
+ *   @remark
+ * The function must not be called from an interrupt service routine.
+ *   @see void rtos_suspendTask(uint8_t)
+ */
+
+void rtos_resumeTask(uint8_t idxTask)
+{
+    swiControlTask(idxTask, TASK_CONTROL_RESUME);
+
+} /* End of rtos_resumeTask */
+
+
+
+
+/**
+ * Restart another task at the entry of its task function. The current state of the task
+ * is lost; it doesn't matter whether it is due, suspended or halted. The task becomes due
+ * immediately, which may immediately preempt the calling task. The task function is
+ * invoked with #RTOS_EVT_DELAY_TIMER as initial resume condition.\n
+ *   The execution time is bounded: Interrupts are globally disabled while not more than
+ * #RTOS_MAX_NO_TASKS_IN_PRIO_CLASS plus #RTOS_NO_TASKS list elements are inspected and
+ * moved and while the initial context is written onto the stack of the task. The stack
+ * area is not filled with the pattern byte again.\n
+ *   The task keeps its priority class, its overrun counter and, if it had been waiting
+ * for the absolute timer, its due time: A regular task, which has been restarted, can
+ * continue on its former time grid with \a rtos_suspendTaskTillTime.
+ *   @param idxTask
+ * The index of the task to restart. The calling task can't restart itself.
+ *   @remark
+ * A mutex or semaphore, which is held by the task, is not released. The application needs
+ * to do this on behalf of the restarted task.
+ *   @remark
+ * The function must not be called from an interrupt service routine.
+ */
+
+void rtos_restartTask(uint8_t idxTask)
+{
+    swiControlTask(idxTask, TASK_CONTROL_RESTART);
+
+} /* End of rtos_restartTask */
+#endif
+
+
+
+
+/**
+ * This is a code pattern (inline function) which saves the resume condition of a task,
+ * which is going to be suspended into its task object. This pattern is mainly used in the
+ * suspend function rtos_waitForEvent but also at task initialization time, when the
+ * initial task start condition is specified by the application code.
+ *   @return
+ * Get true if the task must not be suspended since its resume condition is already
+ * fulfilled. This happens only on a task overrun with policy
+ * #RTOS_OVERRUN_POLICY_CATCH_UP.
+ *   @param pT
+ * Pointer to the task object of the suspend task.
+ *   @param eventMask
+ * See function \a rtos_waitForEvent for details.
+ *   @param all
+ * See function \a rtos_waitForEvent for details.
+ *   @param timeout
+ * See function \a rtos_waitForEvent for details.
+ *   @see
+ * void rtos_waitForEvent(uintEventVec_t, boolean, uintTime_t)
+ *   @remark
+ * For performance reasons this function needs to be inlined. A macro would be an
+ * alternative.
+ */
+
+static inline boolean storeResumeCondition( task_t * const pT
+                                          , uintEventVec_t eventMask
+                                          , boolean all
+                                          , uintTime_t timeout
+                                          )
+{
+    boolean isDueImmediately = false;
+
+    /* Check event condition: It must not be empty. The two timers can't be used at the
+       same time (which is a rather harmless application design error) and at least one
+       other event needs to be required for a resume in case of the AND condition.
+         The latter bad situation leads to a crash. If all is set then RTuinOS interprets
+       the empty event mask as the always fulfilled resume condition. The task became due
+       without any bit set in the task's postedEventVec - which leads to a wrong state
+       transition in the kernel. (Please refer to the manual for a detail explanation of
+       the task state meaning of postedEventVec.) */
+    ASSERT(eventMask != 0
+           &&  (eventMask & MASK_EVT_IS_TIMER) != MASK_EVT_IS_TIMER
+           &&  (!all || (eventMask & ~MASK_EVT_IS_TIMER) != 0)
+          );
+
+    /* The timing parameter may refer to different timers. Depending on the event mask we
+       either load the one or the other timer. Default is the less expensive delay
+       counter. */
+#ifdef RTOS_SCHEDULE_TABLE
+    if(pT->isWaitingForScheduleSlot)
+    {
+        /* A time-triggered task waits for its next entry in the schedule table, which will
+           set the absolute timer. The flag has been set by rtos_waitForNextScheduleSlot;
+           no other resume condition leads into this branch. Until the entry is reached,
+           the timer is set to the current time, which is reached again only after a full
+           cycle of the system time; the hyperperiod is shorter. */
+        ASSERT(eventMask == RTOS_EVT_ABSOLUTE_TIMER  &&  !all);
+        pT->timeDueAt = _time;
+    }
+    else
+#endif
+    if((eventMask & RTOS_EVT_ABSOLUTE_TIMER) != 0)
+    {
+        /* This suspend command wants a reactivation at a certain time. The new time is
+           assigned by the += in the conditional expression.
+             Task overrun detection: The new time must be no more than half a cycle in the
+           future. The test uses a signed comparison. The unsigned comparison >= 0x80 would be
+           equivalent but probably less performant (TBC). */
+        if((intTime_t)((pT->timeDueAt+=timeout) - _time) <= 0)
+        {
+#if RTOS_USE_OVERRUN_POLICY == RTOS_FEATURE_ON
+            /* The reaction on the overrun is configured per task. */
+            isDueImmediately = handleTaskOverrun(pT, timeout);
+#else
+            if(pT->cntOverrun < 0xff)
+                ++ pT->cntOverrun;
+
+            /* The wanted point in time is over. We do the best recovery which is possible: Let
+               the task become due in the very next timer tic.
+                 In specific situations, this can be counter productive - the application
+               may turn off this corrective action. See documentation: If the eight Bit
+               system timer and very slow, regular tasks are used there's a high risk of
+               seeing false overrun recognitions. Now making the task due immediately would
+               introduce a true error. */
+# if RTOS_OVERRUN_TASK_IS_IMMEDIATELY_DUE == RTOS_FEATURE_ON
+            pT->timeDueAt = _time+1;
+# endif
+#endif
+        }
+    }
+    else
+    {
+        /* The timeout counter is reloaded. We could do this conditionally if the bit is
+           set, but in all normal use cases it'll and if not it doesn't harm. We will
+           just decrement the delay counter in onTimerTic once but not set the event.
+             ++ timeout: The call of the suspend function is in no way synchronized with the
+           system clock. We define the delay to be a minimum and implement the resolution
+           caused uncertainty as an additional delay. */
+        if((uintTime_t)(timeout+1) != 0)
+            ++ timeout;
+        pT->cntDelay = timeout;
+
+    } /* if(Which timer is addressed for the timeout condition?) */
+
+    pT->eventMask = eventMask;
+    pT->waitForAnyEvent = !all;
+
+    return isDueImmediately;
+
+} /* End of storeResumeCondition */
+
+
+
+#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
+/**
+ * Waiting for events doesn't necessarily mean waiting: If the wait condition includes
+ * mutexes and semaphores these may already be available on entry in the wait function.
+ * This routine checks all demanded sync objects and locks and allocates all those objects
+ * to the calling task, which are currently free.
+ *   @return
+ * Finally the routine checks if the wait condition of the suspend command is already
+ * fulfilled with the found sync objects. If and only if so it returns true and the suspend
+ * command won't actually block the calling task.
+ *   @param eventMask
+ * See function \a rtos_waitForEvent for details.
+ *   @param all
+ * See function \a rtos_waitForEvent for details.
+ *   @see
+ * void rtos_waitForEvent(uintEventVec_t, boolean, uintTime_t)
+ *   @remark
+ * This function is inlined for performance reasons.
+ */
+
+static inline boolean acquireFreeSyncObjs(uintEventVec_t eventMask, boolean all)
+{
+#if RTOS_USE_MUTEX == RTOS_FEATURE_ON
+    /* Check for immediate availability of all/any mutex. These mutexes are locked now and
+       entered in the calling task's postedEventVec. */
+    _pActiveTask->postedEventVec = eventMask & _mutexVec;
+
+    /* Lock the demanded mutexes. Bits in eventMask which do not correspond to mutex events
+       don't need to be masked. They may reset some anyway reset don't-care bits in
+       _mutexVec. */
+    _mutexVec &= ~eventMask;
+#endif
+
+#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
+    /* Check for immediate availability of all/any semaphores. The counters of none zero
+       semaphores are decremented now and the related acquired-bit is set in the calling
+       task's postedEventVec. */
+    uint8_t idxSem = 0
+          , maskSem = 0x01
+          , semaphoreToAcquireVec = eventMask & MASK_EVT_IS_SEMAPHORE;
+    while(semaphoreToAcquireVec)
+    {
+        if((semaphoreToAcquireVec & 0x01) != 0)
+        {
+            if(rtos_semaphoreAry[idxSem] > 0)
+            {
+                -- rtos_semaphoreAry[idxSem];
+                _pActiveTask->postedEventVec |= maskSem;
+            }
+        }
+
+        /* Test next event bit and increment related index of semaphore in array. */
+        ++ idxSem;
+        maskSem <<= 1;
+        semaphoreToAcquireVec >>= 1;
+    }
+#endif
+
+    /* postedEventVec now contains all requested mutexes, which were currently available.
+       If these were all demanded events, we don't need to suspend the task but can
+       immediately and successfully return. The timer bits (events 14 and 15) don't matter
+       as they are always OR terms. We definitely don't need to wait for them. */
+    return (!all &&  _pActiveTask->postedEventVec != 0)
+           || (all &&  ((_pActiveTask->postedEventVec ^ eventMask) & ~MASK_EVT_IS_TIMER) == 0);
+
+} /* End of acquireFreeSyncObjs */
+
+#endif /* RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON */
+
+
+
+/**
+ * Actual implementation of task suspension routine \a rtos_waitForEvent. The task is
+ * suspended until a specified event occurs.\n
+ *   The action of this SW interrupt is placed into an own function in order to let the
+ * compiler generate the stack frame required for all local data. (The stack frame
+ * generation of the SW interrupt entry point needs to be inhibited in order to permit the
+ * implementation of saving/restoring the task context).
+ *   @return
+ * If mutex or semaphores are in use the function returns the Boolean information whether
+ * the calling task has to be suspended. This is not the case if all demanded sync objects
+ * are currently available. If RTuinOS is compiled without support of mutexes and
+ * sempahores than the calling task is always suspended.\n
+ *   By means of side effects, the function returns which task is to be activated and records
+ * which task is left (i.e. the task calling this routine) in the global variables \a
+ * _pActiveTask and \a _pSuspendedTask.
+ *   @param eventMask
+ * See software interrupt \a rtos_waitForEvent.
+ *   @param all
+ * See software interrupt \a rtos_waitForEvent.
+ *   @param timeout
+ * See software interrupt \a rtos_waitForEvent.
  *   @see
- * void rtos_sendEvent(uint16_t)
+ * uintEventVec_t rtos_waitForEvent(uintEventVec_t, boolean, uintTime_t)
+ *   @remark
+ * This function and particularly passing the return codes via a global variable will
+ * operate only if all interrupts are disabled.
+ */
+
+#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
+static RTOS_TRUE_FCT boolean waitForEvent( uintEventVec_t eventMask
+                                           , boolean all
+                                           , uintTime_t timeout
+                                           )
+#else
+static RTOS_TRUE_FCT void waitForEvent( uintEventVec_t eventMask
+                                       , boolean all
+                                       , uintTime_t timeout
+                                       )
+#endif
+
+{
+    /* Avoid inlining under all circumstances. See attributes also. */
+    asm("");
+
+    /* Here, we could double-check _pActiveTask for the idle task and return without
+       context switch if it is active. (The idle task has illicitly called a suspend
+       command.) However, all implementation rates performance higher than failure
+       tolerance, and so do we here. */
+    ASSERT(_pActiveTask != _pIdleTask);
+
+#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
+    if(acquireFreeSyncObjs(eventMask, all))
+        return false;
+#endif
+
+    int8_t idxPrio;
+    int8_t idxTask;
+
+    /* Take the active task out of the list of due tasks. */
+    task_t * const pT = _pActiveTask;
+#if RTOS_USE_TASK_STATISTICS == RTOS_FEATURE_ON
+    recordTaskSuspend(pT);
+#endif
+#if RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_ON
+    /* The activation is completed. It is late if the tic of the deadline has passed. */
+    if(pT->isDeadlineArmed)
+    {
+        disarmTaskDeadline(pT);
+        if((intTime_t)(_time - pT->timeDeadlineAt) > 0)
+            notifyDeadlineMiss(pT);
+    }
+#endif
+    uint8_t prio = pT->prioClass;
+    uint8_t noDueNow = -- _noDueTasksAry[prio];
+    for(idxTask=0; idxTask<noDueNow; ++idxTask)
+        _pDueTaskAryAry[prio][idxTask] = _pDueTaskAryAry[prio][idxTask+1];
+
+    /* This suspend command wants a reactivation by a combination of events (which may
+       include the timeout event). Save the resume condition in the task object. The
+       operation is implemented as inline function to be able to reuse the code in the
+       task initialization routine. */
+#if RTOS_USE_OVERRUN_POLICY == RTOS_FEATURE_ON
+    const boolean isDueImmediately =
+#endif
+    storeResumeCondition(pT, eventMask, all, timeout);
+
+    /* Put the task in the list of suspended tasks. If mutexes or semaphores are in use
+       this list is sorted with decreasing priority. */
+#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
+    /* < rather than <=: The now suspended task becomes the last one in its prio class. The
+       others of same priority are waiting longer and will receive a later posted event
+       with priority. */
+    int8_t idxPos;
+    for(idxPos=0; idxPos<_noSuspendedTasks; ++idxPos)
+        if(_pSuspendedTaskAry[idxPos]->prioClass < prio)
+            break;
+
+    /* Shift rest of the list one to the end. This loop requires a signed index. */
+    for(idxTask=_noSuspendedTasks++ - 1; idxTask>=idxPos; --idxTask)
+        _pSuspendedTaskAry[idxTask+1] = _pSuspendedTaskAry[idxTask];
+
+    /* Insert the suspended task at the priority determined right position. */
+    _pSuspendedTaskAry[idxPos] = pT;
+#else
+# if RTOS_USE_OVERRUN_POLICY == RTOS_FEATURE_ON
+    const uint8_t idxPos = _noSuspendedTasks;
+# endif
+    _pSuspendedTaskAry[_noSuspendedTasks++] = pT;
+#endif
+
+#if RTOS_USE_OVERRUN_POLICY == RTOS_FEATURE_ON
+    /* A task overrun with policy catch-up: The task's absolute timer has already elapsed
+       and it becomes due again. It is put at the end of the list of due tasks of its
+       priority class like any other task, which is resumed by the timer; another due
+       task of same priority is not blocked by the catch-up activations. */
+    if(isDueImmediately)
+    {
+        pT->postedEventVec |= RTOS_EVT_ABSOLUTE_TIMER;
+#ifdef DEBUG
+        const boolean isDue =
+#endif
+        checkTaskForActivation(idxPos);
+        ASSERT(isDue);
+    }
+#endif
+
+    /* Record which task suspends itself for the assembly code in the calling function
+       which actually switches the context. */
+    _pSuspendedTask = _pActiveTask;
+
+    /* Look for the task we will return to. It's the first entry in the highest non-empty
+       priority class. The loop requires a signed index.
+         It's not guaranteed that there is any due task. Idle is the fallback. */
+    _pActiveTask = _pIdleTask;
+    for(idxPrio=RTOS_NO_PRIO_CLASSES-1; idxPrio>=0; --idxPrio)
+    {
+        if(_noDueTasksAry[idxPrio] > 0)
+        {
+            _pActiveTask = _pDueTaskAryAry[idxPrio][0];
+            break;
+        }
+    }
+
+#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
+    return true;
+#endif
+} /* End of waitForEvent */
+
+
+
+
+/**
+ * Suspend the current task (i.e. the one which invokes this method) until a specified
+ * combination of events occur. In the special case, that the specified combination of
+ * events can be satisfied with currently available synchronization objects (mutexes and
+ * semaphores) the function will return immediately without suspending the calling task.\n
+ *   A task is suspended in the instance of calling this method. It specifies a list of
+ * events. The task becomes due again, when either the first one or all of the specified
+ * events have been posted by other tasks.\n
+ *   The idle task can't be suspended. If it calls this function a crash would be the
+ * immediate result.
+ *   @return
+ * The set of actually resuming events is returned as a bit vector which corresponds
+ * bitwise to eventMask. See \a rtos.h for a list of known events.
+ *   @param eventMask
+ * The bit vector of events to wait for. Needs to include either the delay timer event
+ * #RTOS_EVT_DELAY_TIMER or #RTOS_EVT_ABSOLUTE_TIMER, if a timeout is required, but not both
+ * of them.\n
+ *   The normal use case will probably be the delay timer. However, a regular task may also
+ * specify the absolute timer with the next regular task time as parameter so that it
+ * surely becomes due outermost at its usual task time.
+ *   @param all
+ *   If false, the task is made due as soon as the first event mentioned in \a eventMask is
+ * seen.\n
+ *   If true, the task is made due only when all events are posted to the suspending task -
+ * except for the timer events, which are still OR combined. If you say "all" but the event
+ * mask contains either #RTOS_EVT_DELAY_TIMER or #RTOS_EVT_ABSOLUTE_TIMER, the task will
+ * resume when either the timer elapsed or when all other events in the mask were seen.\n
+ *   Caution: If all is true, there need to be at least one event bit set in \a eventMask
+ * besides a timer bit; RTuinOS crashes otherwise. Saying: "No particular event, just a
+ * timer condition" needs to be implemented by \a all set to false and \a eventMask set to
+ * only a timer event bit.
+ *   @param timeout
+ * If \a eventMask contains #RTOS_EVT_DELAY_TIMER:\n
+ *   The number of system timer tics from now on until the timeout elapses. One should be
+ * aware of the resolution of any timing being the tic of the system timer. A timeout of \a
+ * n may actually mean any delay in the range \a n .. \a n+1 tics.\n
+ *   Even specifying 0 will suspend the task a short time and give others the chance to
+ * become active - particularly other tasks belonging to the same priority class.\n
+ *   If \a eventMask contains #RTOS_EVT_ABSOLUTE_TIMER:\n
+ *   The absolute time the task becomes due again at latest. The time designation is
+ * relative; it refers to the last recent absolute time at which this task had been
+ * resumed. See #rtos_suspendTaskTillTime for details.\n
+ *   Now the range of the parameter is 1 till the half the range of the data type which is
+ * configured for the system time, e.g. 127 in case of uint8_t. Otherwise proper task
+ * timing can't be guaranteed.\n
+ *   If neither #RTOS_EVT_DELAY_TIMER nor #RTOS_EVT_ABSOLUTE_TIMER is set in the event mask,
+ * this parameter should be zero.
+ */
+ 
+RTOS_NAKED_FCT uintEventVec_t rtos_waitForEvent( uintEventVec_t eventMask
+                                               , boolean all
+                                               , uintTime_t timeout
+                                               )
+{
+    /* It is absolutely essential that this routine is implemented as naked and noinline.
+       See http://gcc.gnu.org/onlinedocs/gcc/Function-Attributes.html for details.
+         GCC doesn't create a stack frame for naked functions. For normal functions, the
+       calling parameter of the function is stored in such a stack frame. In the
+       combination naked and having local function parameters, GCC has a problem when
+       generating code without optimization: It doesn't generate a stack frame but still
+       does save the local parameter into the (not existing) stack frame as very first
+       assembly operation of the function code. There's absolutely no work around; when the
+       earliest code, we can write inside the function is executed, the stack is already
+       corrupted in a hazardous way. A crash is unavoidable.
+         A discussion of the issue can be found at
+       http://lists.gnu.org/archive/html/avr-gcc-list/2012-08/msg00014.html.
+         To avoid this problem we forbid to compile the code with optimization off.
+       Nonetheless, who will ever know or understand under which circumstances, e.g. which
+       combination of optimization flags, GCC will again generate this crash-code. This
+       issue remains a severe risk! Consequently, at any change of a compiler setting you
+       will need to inspect the assembly listing file and double-check that it is proper
+       with respect of using (better not using) the stack frame for this function (and
+       rtos_sendEvent).
+         Another idea would be the implementation of this function completely in assembly
+       code. Doing so, we have the new problem of calling assembly code as C functions.
+       Find an example of how to do in
+       file:///M:/SVNMainRepository/Arduino/RTuinOS/trunk/RTuinOS/code/RTOS/rtos.c,
+       revision 215. */
+#ifndef __OPTIMIZE__
+# error This code must not be compiled with optimization off. See source code comments for more
+#endif
+
+    /* This function is a pseudo-software interrupt. A true interrupt had reset the global
+       interrupt enable flag, we inhibit any interrupts now. */
+    asm volatile
+    ( "cli \n\t"
+    );
+
+    /* The program counter as first element of the context is already on the stack (by
+       calling this function). Save rest of context onto the stack of the interrupted
+       active task. */
+    PUSH_CONTEXT_WITHOUT_R24R25_ONTO_STACK
+
+    /* The actual implementation of the task switch logic is placed into a sub-routine in
+       order to benefit from the compiler generated stack frame for local variables (in
+       this naked function we must not have declared any). The call of the function is
+       immediately followed by some assembly code which computes the return value of the
+       function and places it in register pair r24/25. */
+#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
+    if(waitForEvent(eventMask, all, timeout))
+#else
+    waitForEvent(eventMask, all, timeout);
+#endif
+    {
+        /* The wait condition couldn't be fulfilled immediately, we need to suspend the
+           task. Switch the stack pointer to the (saved) stack pointer of the new active
+           task. */
+        SWITCH_CONTEXT
+        CHECK_STACK_GUARD_OF_SUSPENDED_TASK
+    }
+
+     /* Regardless whether we had switched the task the suspend command ends with returning
+        the information about the task releasing events. Push this function result onto the
+        (maybe new) stack - from where it is loaded into r24/r25 by the subsequent pop-context
+        command. */
+    PUSH_RET_CODE_OF_CONTEXT_SWITCH
+
+    /* The stack pointer points to the now active task (which may be still the same as at
+       function entry). The CPU context to continue with is popped from this stack. If
+       there's no change in active task the entire routine call is just like any ordinary
+       interrupt. */
+    POP_CONTEXT_FROM_STACK
+
+    /* The global interrupt enable flag is not saved across task switches, but always set
+       on entry into the new or same context by using a reti rather than a ret. */
+    asm volatile
+    ( "reti \n\t"
+    );
+
+    /* This statement is never reached. Just to avoid the warning. */
+    return 0;
+
+} /* End of rtos_waitForEvent */
+
+
+
+
+#ifdef RTOS_SCHEDULE_TABLE
+/**
+ * Suspend the current, time-triggered task until its next entry in the schedule table
+ * #RTOS_SCHEDULE_TABLE. The task is released by the system timer interrupt at the
+ * configured phase of the hyperperiod; other than with \a rtos_suspendTaskTillTime, the
+ * point in time doesn't depend on the previous resume of the task.\n
+ *   If the task is still busy, when its next entry in the table is reached, then this
+ * release is skipped and it is counted as task overrun, see \a rtos_getTaskOverrunCounter.
+ * The task will wait for the entry after the skipped one.
+ *   @return
+ * The event mask of resuming events is returned. This will always be
+ * #RTOS_EVT_ABSOLUTE_TIMER.
+ *   @remark
+ * The calling task needs to have at least one entry in the schedule table, otherwise it
+ * would never be resumed. This is double-checked in DEBUG compilation only.
+ *   @remark
+ * The function must be called by a task only. It must not be called by the idle task or
+ * from an interrupt service routine.
+ */
+
+uintEventVec_t rtos_waitForNextScheduleSlot(void)
+{
+    ASSERT(isTaskInScheduleTable(_pActiveTask));
+
+    /* The flag tells the suspend command that the task waits for the schedule table. It
+       is set with interrupts disabled: The system timer interrupt would otherwise take it
+       as a completed activation of the still running task. rtos_waitForEvent is entered
+       with interrupts disabled and reenables them when the task is suspended. */
+    cli();
+    _pActiveTask->isWaitingForScheduleSlot = true;
+    return rtos_waitForEvent( /* eventMask */ RTOS_EVT_ABSOLUTE_TIMER
+                            , /* all */       false
+                            , /* timeout */   0
+                            );
+
+} /* End of rtos_waitForNextScheduleSlot */
+#endif
+
+
+
+
+#if RTOS_COUNTED_EVENT_MASK != 0
+/**
+ * Get the number of posts of a counted event since the previous call of this function by
+ * the same task. Other than the event Bit, which is only seen by a task if it is
+ * suspended and waiting for the event, the counter doesn't lose any post; the posts are
+ * counted while the task is suspended, due or active.\n
+ *   A task, which wants to process all occurrences of an event, calls the function after
+ * resume and processes the returned number of occurrences. To not sleep on an event,
+ * which has been counted but not been seen as event Bit, the task checks and suspends
+ * atomically:\n
+ *   cli();\n
+ *   n = rtos_getNoPostedEvents(EVT);\n
+ *   if(n == 0)\n
+ *       { rtos_waitForEvent(EVT, false, 0); n = rtos_getNoPostedEvents(EVT); }\n
+ *   else\n
+ *       sei();\n
+ * rtos_waitForEvent is a software interrupt, it suspends with the interrupts still
+ * disabled and returns with enabled interrupts.
+ *   @return
+ * Get the number of posts. The counters have eight Bit: The result is wrong if more than
+ * 255 posts happened since the previous call.
+ *   @param event
+ * The counted event as a single Bit, which is set in #RTOS_COUNTED_EVENT_MASK.
  *   @remark
- * This function and particularly passing the return codes via a global variable will
- * operate only if all interrupts are disabled.
+ * The count relates to the previous query and not to the previous resume of the task. A
+ * count latched by the kernel at resume would defer the posts, which happen while the
+ * task is due or active, until the next post; the task could sleep on pending posts.
+ * Counting up to the query, the pattern above doesn't lose or defer any post. A task,
+ * which queries once after each resume, gets the posts since its last wake-up.
+ *   @remark
+ * The function must be called from a task or the idle task but not from an ISR. It
+ * doesn't need a critical section.
  */
 
-static RTOS_TRUE_FCT boolean sendEvent(uint16_t postedEventVec)
+uint8_t rtos_getNoPostedEvents(uintEventVec_t event)
 {
-    /* Avoid inlining under all circumstances. See attributes also. */
-    asm("");
+    ASSERT((event & (RTOS_COUNTED_EVENT_MASK)) != 0  &&  (event & (event-1)) == 0);
 
-    boolean activeTaskMayChange = false;
-    
-    /* The timer events must not be set manually. */
-    ASSERT((postedEventVec & MASK_EVT_IS_TIMER) == 0);
+    /* The index of the counter is the number of counted events below the requested one. */
+    uintEventVec_t maskCounted = (RTOS_COUNTED_EVENT_MASK) & (event-1);
+    uint8_t idxCnt = 0;
+    while(maskCounted != 0)
+    {
+        if((maskCounted & 0x01) != 0)
+            ++ idxCnt;
+        maskCounted >>= 1;
+    }
 
-    /* We keep track of all semaphores and mutexes, which have to be posted (released)
-       exactly once - to the first task, which is waiting for them. This task is done,
-       when the related mask, semaphoreToReleaseVec or mutexToReleaseVec becomes null. */
-#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
-    uint8_t semaphoreToReleaseVec = postedEventVec & MASK_EVT_IS_SEMAPHORE;
-#endif
-#if RTOS_USE_MUTEX == RTOS_FEATURE_ON
-    uint16_t mutexToReleaseVec = postedEventVec & MASK_EVT_IS_MUTEX;
-# ifdef DEBUG
-    uint16_t dbg_allMutexesToReleaseVec = mutexToReleaseVec;
-# endif
-#endif
-#if RTOS_USE_MUTEX == RTOS_FEATURE_ON  ||  RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
-    /* The implementation makes a distinction between synchronization objects (mutex and
-       semaphores) and ordinary, broadcasted events. */
-    postedEventVec &= ~(MASK_EVT_IS_MUTEX | MASK_EVT_IS_SEMAPHORE);
+    /* The counter is read with a single, atomic operation. The copy in the task object is
+       owned by the task. */
+    task_t * const pT = _pActiveTask;
+    const uint8_t cntPosted = _cntPostedEventAry[idxCnt]
+                , noPosts = cntPosted - pT->cntSeenEventAry[idxCnt];
+    pT->cntSeenEventAry[idxCnt] = cntPosted;
+
+    return noPosts;
+
+} /* End of rtos_getNoPostedEvents */
 #endif
 
-    /* Post ordinary events to all suspended tasks which are waiting for it.
-         Pass mutexes and semaphores to a single task each, those task, which is of highest
-       priority and waits the longest for it. This loop is the reason, why we need to have
-       the list of suspended tasks always sorted, when at least one semaphore or mutex is in
-       use. */
-    uint8_t idxSuspTask = 0;
-    while(idxSuspTask<_noSuspendedTasks)
-    {
-        task_t * const pT = _pSuspendedTaskAry[idxSuspTask];
-        
-        /* Remember the received events before (possibly) getting some more by this
-           sendEvent: Only if this set changes it is necessary to check for a state
-           transition of the task. */
-        const uint16_t postedEventVecBefore = pT->postedEventVec;
 
-#if RTOS_USE_MUTEX == RTOS_FEATURE_ON
-        /* Mutexes are Boolean and can't be posted twice to a task. This is easily possible
-           but an application error. This assertion fires if the application doesn't
-           properly keep track of who owns which mutex. */
-        ASSERT((pT->postedEventVec & dbg_allMutexesToReleaseVec) == 0);
 
-        /* The vector of all events this task will receive. */
-        uint16_t gotEvtVec = (postedEventVec | mutexToReleaseVec) & pT->eventMask;
 
-        /* Collect the events in the task object. */
-        pT->postedEventVec |= gotEvtVec;
+#if RTOS_USE_EVENT_DATA == RTOS_FEATURE_ON
+/**
+ * Post a set of events to the suspended tasks like \a rtos_sendEvent and pass a data word
+ * to the mailbox of each task, which receives at least one of the events. Posting the
+ * events and writing the mailboxes is a single atomic operation; neither the sending nor
+ * the receiving task need a critical section.\n
+ *   The function may be called from a task or from the idle task but not from an interrupt
+ * service routine. The top half of an application interrupt passes a data word with \a
+ * rtos_setEventDataFromISR.
+ *   @param eventVec
+ * A bit vector of posted events, see \a rtos_sendEvent. The data word is only delivered
+ * along with ordinary events; it is not passed with mutexes and semaphores.
+ *   @param data
+ * The data word, which is written into the mailboxes.
+ *   @remark
+ * Like \a rtos_sendEvent, the function returns with globally enabled interrupts.
+ *   @see
+ * uintEventVec_t rtos_waitForEventWithData(uintEventVec_t, boolean, uintTime_t, uint16_t *)
+ */
 
-        /* Subtract the given mutexes from the vector of all, which are to release in this
-           call. It doesn't matter that the mask also contains ordinary events - all these
-           bits can do is to reset already reset bits. */
-        mutexToReleaseVec &= ~gotEvtVec;
-#else
-        pT->postedEventVec |= (postedEventVec & pT->eventMask);
+void rtos_sendEventWithData(uintEventVec_t eventVec, uint16_t data)
+{
+    /* The data is handed over to sendEvent in a global variable. Interrupts are disabled
+       from here until the end of the software interrupt rtos_sendEvent, so that no other
+       call of sendEvent can take the data word. */
+    cli();
+    _eventDataToPost = data;
+    _isEventDataToPost = true;
+    rtos_sendEvent(eventVec);
 
-#endif /* RTOS_USE_MUTEX == RTOS_FEATURE_ON */
+} /* End of rtos_sendEventWithData */
 
-#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
-        /* Now pass all released semaphores to tasks waiting for them. This can't be done
-           all at once as semaphores are not simply a bit. We need a second loop to do so.
-             Remark: The implementation of the loops here and down below is the reason why
-           we (arbitrarily) restrict the maximum number to eight: We can use native CPU
-           machine codes for most operations instead of much more expensive 16 Bit
-           operations. */
-        uint8_t semMask = 0x01;
-        while(semaphoreToReleaseVec != 0  &&  (semMask & MASK_EVT_IS_SEMAPHORE) != 0)
-        {
-            /* Check if this task is waiting for this semaphore but didn't get it yet (i.e.
-               in an earlier call of this routine). */
-            if((semaphoreToReleaseVec & semMask & pT->eventMask & ~pT->postedEventVec) != 0)
-            {
-                /* The semaphore release operation is handled by passing the semaphore to
-                   the task. */
-                pT->postedEventVec    |= semMask;
-                semaphoreToReleaseVec &= ~semMask;
-            }
 
-            /* Shift mask one Bit to the left to test next semaphore in next cycle. */
-            semMask <<= 1;
-        }
+
+
+/**
+ * The top half of an application interrupt, see #RTOS_APPL_INTERRUPT_LIST, passes a data
+ * word to the mailbox of the tasks, which receive the events it returns. This is the
+ * interrupt counterpart of \a rtos_sendEventWithData: The word is delivered in the same
+ * atomic operation, which posts the returned events after the top half has completed.\n
+ *   The function must be called only from a top half. It has no effect if the top half
+ * returns no event.
+ *   @param data
+ * The data word, which is written into the mailboxes.
+ *   @remark
+ * If the function is called more than once in the same top half then the last recent
+ * data word is delivered.
+ */
+
+void rtos_setEventDataFromISR(uint16_t data)
+{
+    /* Top halves are executed with globally disabled interrupts. The data word is consumed
+       (or discarded) by sendEventFromISR before interrupts are enabled again. */
+    ASSERT((SREG & 0x80) == 0);
+    _eventDataToPost = data;
+    _isEventDataToPost = true;
+
+} /* End of rtos_setEventDataFromISR */
+
+
+
+
+/**
+ * Suspend the current task like \a rtos_waitForEvent and return the contents of its
+ * mailbox after it has been resumed.
+ *   @return
+ * The set of actually resuming events is returned as a bit vector, see \a
+ * rtos_waitForEvent.
+ *   @param eventMask
+ * See \a rtos_waitForEvent.
+ *   @param all
+ * See \a rtos_waitForEvent.
+ *   @param timeout
+ * See \a rtos_waitForEvent.
+ *   @param pData
+ * The contents of the mailbox of the task is returned by reference. It is the data word
+ * of the last recent call of \a rtos_sendEventWithData (or of an interrupt top half, which
+ * used \a rtos_setEventDataFromISR), which posted an event to this task while it was
+ * suspended - in this or in an earlier suspension. The mailbox is not
+ * cleared: The returned event vector tells whether the data is new.
+ *   @remark
+ * The mailbox is written only while the task is suspended. It is read after resume
+ * without a critical section.
+ */
+
+uintEventVec_t rtos_waitForEventWithData( uintEventVec_t eventMask
+                                        , boolean all
+                                        , uintTime_t timeout
+                                        , uint16_t *pData
+                                        )
+{
+    const uintEventVec_t eventVec = rtos_waitForEvent(eventMask, all, timeout);
+    *pData = _pActiveTask->eventData;
+    return eventVec;
+
+} /* End of rtos_waitForEventWithData */
 #endif
 
-        /* Check if this suspended task becomes due because of an event, which was posted
-           to it. */
-        if(postedEventVecBefore != pT->postedEventVec  && checkTaskForActivation(idxSuspTask))
-        {
-            /* The task becomes due. */
-            activeTaskMayChange = true;
 
-            /* Check next suspended task, which is in this case found in the array
-               element with same index: The task which became due has been removed into the
-               due list of its priority class. */
-        }
-        else
-        {
-            /* The task remains suspended. */
 
-            /* Check next suspended task, which is in this case found in the next array
-               element. */
-            ++ idxSuspTask;
 
-        } /* End if(Did this suspended task become due?) */
 
-    } /* End while(All suspended tasks) */
 
-#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
-    /* The remaining semaphores (more precise: semaphore counter values) are accumulated in
-       the global semaphore storage for later acquisition. */
-    uint8_t idxSem = 0;
-    while(semaphoreToReleaseVec)
+
+/**
+ * Get the current value of the overrun counter of a given task.\n
+ *   The value is a limited 8 Bit counter (i.e. it won't cycle around). This is considered
+ * satisfying as any task overrun is a kind of error and should not happen in a real
+ * application (with other words: even a Boolean information could be enough). Furthermore,
+ * if a larger range is required, one can regularly ask for this information, accumulate it
+ * and reset the value here to zero at the same time.\n
+ *   The function may be called from a task or from the idle task.
+ *   @return
+ * Get the current value of the overrun counter.
+ *   @param idxTask
+ * The index of the task the overrun counter of which is to be returned. The index is the
+ * same as used when initializing the tasks (see rtos_initializeTask).
+ *   @param doReset
+ * Boolean flag, which tells whether to reset the value.\n
+ *   Caution, when setting this to true, reading and resetting the value needs to become an
+ * atomic operation, which requires a critical section. This is significantly more
+ * expensive than just reading the value and it globally enables the interrupts finally.
+ * Therefore this call may destroy a surrounding critical section.
+ *   @remark
+ * This function has some limitations and weaknesses: First of all, the concept of task
+ * overruns is defined only for regular tasks. Secondary, and particularly when using the 8
+ * Bit system timer, there's a significant probability of not recognizing huge task
+ * overruns. Finally there's a significant probability of false recognitions of (not
+ * happening) task overruns if the task period time is greater than half the system timer's
+ * cycle time (i.e. greater than 127 for the 8 Bit system timer). Please, refer to the
+ * RTuinOS manual for details.
+ *   @see
+ * void rtos_initializeTask()
+ */
+
+uint8_t rtos_getTaskOverrunCounter(uint8_t idxTask, boolean doReset)
+{
+    if(doReset)
     {
-        if((semaphoreToReleaseVec & 0x01) != 0)
-        {
-            ++ rtos_semaphoreAry[idxSem];
+        uint8_t retCode
+              , * const pCntOverrun = &_taskAry[idxTask].cntOverrun;
 
-            /* The assertion validates the application code. It fires if the application
-               releases/produces more semaphore counter values as fit into the data type of
-               the semphore. This is harmless with respect to the stability of the RTOS but
-               probably a design error in the application. */
-            ASSERT(rtos_semaphoreAry[idxSem] != 0);
+        /* Read and reset should be atomic for data consistency if the application wants to
+           accumulate the counter values in order to extend the counter's range. */
+        cli();
+        {
+            retCode = *pCntOverrun;
+            *pCntOverrun = 0;
         }
+        sei();
 
-        /* Test next semaphore in next cycle. */
-        semaphoreToReleaseVec >>= 1;
-
-        /* The next event/semaphore bit is related to the next array entry. */
-        ++ idxSem;
+        return retCode;
+    }
+    else
+    {
+        /* Reading an 8 Bit word is an atomic operation as such, no additional lock
+           operation needed. */
+        return _taskAry[idxTask].cntOverrun;
     }
+} /* End of rtos_getTaskOverrunCounter */
+
+
+
+
+#if RTOS_USE_OVERRUN_POLICY == RTOS_FEATURE_ON
+/**
+ * Select the reaction of the kernel on an overrun of a regular task. An overrun is
+ * recognized when the task calls \a rtos_suspendTaskTillTime (or \a rtos_waitForEvent with
+ * the absolute timer) and the requested point in time is already over. With a schedule
+ * table, it is recognized when the task is still busy at its next entry.\n
+ *   Under transient overload, the default policy makes a late task due in the next tic
+ * again and again, until it has caught up with its time grid - which shifts by one tic
+ * each time. An application, which prefers to degrade gracefully, can select to skip the
+ * missed activations or to explicitly catch up with them, and it can notify a supervising
+ * task, which e.g. switches off less important tasks with \a rtos_suspendTask.\n
+ *   The function may be called from setup or at any time from a task or from the idle
+ * task. The new policy applies to the next recognized overrun.
+ *   @param idxTask
+ * The index of the task. The index is the same as used when initializing the tasks (see
+ * rtos_initializeTask).
+ *   @param overrunPolicy
+ * One out of #RTOS_OVERRUN_POLICY_DEFAULT, #RTOS_OVERRUN_POLICY_CATCH_UP and
+ * #RTOS_OVERRUN_POLICY_SKIP, optionally ORed with #RTOS_OVERRUN_CALL_HOOK and/or
+ * #RTOS_OVERRUN_SEND_EVENT. The overrun counter is incremented with all policies.
+ *   @remark
+ * Policy #RTOS_OVERRUN_SEND_EVENT requires the configuration of #RTOS_EVT_TASK_OVERRUN.
+ * The event tells that there was an overrun of any task; the supervising task can find out
+ * which one with \a rtos_getTaskOverrunCounter. The event is not lost if the supervising
+ * task is busy when the overrun happens; it is posted in the first system timer tic, in
+ * which a task waits for it. Several overruns before are reported by a single event.
+ */
+
+void rtos_setTaskOverrunPolicy(uint8_t idxTask, uint8_t overrunPolicy)
+{
+    ASSERT(idxTask < RTOS_NO_TASKS
+           &&  (overrunPolicy & (RTOS_OVERRUN_POLICY_CATCH_UP | RTOS_OVERRUN_POLICY_SKIP))
+               != (RTOS_OVERRUN_POLICY_CATCH_UP | RTOS_OVERRUN_POLICY_SKIP)
+           &&  ((overrunPolicy & RTOS_OVERRUN_SEND_EVENT) == 0
+                ||  (RTOS_EVT_TASK_OVERRUN != 0
+                     &&  (RTOS_EVT_TASK_OVERRUN
+                          & (MASK_EVT_IS_MUTEX | MASK_EVT_IS_SEMAPHORE | MASK_EVT_IS_TIMER)
+                         ) == 0
+                    )
+               )
+          );
+
+    /* Writing an 8 Bit word is an atomic operation as such, no additional lock operation
+       needed. */
+    _taskAry[idxTask].overrunPolicy = overrunPolicy;
+
+} /* End of rtos_setTaskOverrunPolicy */
+
+
+
+
+/**
+ * Callback, which is invoked by the kernel on each recognized overrun of a task with
+ * policy #RTOS_OVERRUN_CALL_HOOK, see \a rtos_setTaskOverrunPolicy.\n
+ *   The function is called from within the suspend command of the task or from the system
+ * timer interrupt, if the task has an entry in the schedule table. The global interrupts
+ * are disabled. The implementation must therefore be short, it must not use any RTuinOS
+ * API and it must not enable the interrupts.\n
+ *   This is the default implementation of the routine, which can be overloaded by the
+ * application code. It does nothing.
+ *   @param idxTask
+ * The index of the affected task. The index is the same as used when initializing the
+ * tasks (see rtos_initializeTask).
+ */
+
+RTOS_DEFAULT_FCT void rtos_onTaskOverrun(uint8_t idxTask)
+
+{
+} /* End of rtos_onTaskOverrun */
 #endif
-#if RTOS_USE_MUTEX == RTOS_FEATURE_ON
-    /* The remaining mutexes are returned to the global storage for later acquisition.
-         The assertion validates application code. It fires if the application releases
-       a mutex, which was not acquired. This is harmless with respect to the stability of
-       the RTOS but probably a design error in the application. Maybe, you have to
-       consider using a semaphore. */
-    ASSERT((_mutexVec & dbg_allMutexesToReleaseVec) == 0);
-    _mutexVec |= mutexToReleaseVec;
-#endif /* RTOS_USE_MUTEX == RTOS_FEATURE_ON */
 
 
-    /* Check if another task becomes active because of the posted events.
-         activeTaskMayChange: We do the search for the new active task only if at least one
-       suspended task was resumed.
-         The function has side effects: If there's a task which was suspended before and
-       which is resumed because of an event and which is of higher priority than the one
-       being active so far, the refernces to the old and newly active task are written into
-       global variables _pSuspendedTask and _pActiveTask. */
-    return activeTaskMayChange && lookForActiveTask();
-    
-} /* End of sendEvent */
 
 
+#if RTOS_USE_TASK_STATISTICS == RTOS_FEATURE_ON
+/**
+ * Get the timing statistics of a task. For each activation of the task the kernel measures
+ * the release jitter, the start latency and the response time; see \a
+ * rtos_taskStatistics_t for the definitions.\n
+ *   The statistics are copied with globally disabled interrupts and they are consistent
+ * with one another. The function doesn't change the global interrupt enable flag; it may
+ * be called from a task, from the idle task or from inside a critical section of those,
+ * e.g. to read the statistics of several tasks consistently.
+ *   @param idxTask
+ * The index of the task. The index is the same as used when initializing the tasks (see
+ * rtos_initializeTask).
+ *   @param pStatistics
+ * The statistics are returned by reference. The unit of all times is the unit of the time
+ * stamps, see #RTOS_TIMESTAMP_UNIT.
+ *   @param doReset
+ * If true, the statistics of the task are reset after reading them. Minimum and maximum
+ * and the histograms then refer to the time since this call.
+ *   @remark
+ * The copy operation takes some time with locked interrupts, about 15 us for the default
+ * number of histogram bins. Don't call the function at high rate.
+ */
+
+void rtos_getTaskStatistics( uint8_t idxTask
+                           , rtos_taskStatistics_t *pStatistics
+                           , boolean doReset
+                           )
+{
+    ASSERT(idxTask < RTOS_NO_TASKS);
+    rtos_taskStatistics_t * const pStat = &_taskStatisticsAry[idxTask];
+    const uint8_t sreg = SREG;
+
+    cli();
+    {
+        *pStatistics = *pStat;
+        if(doReset)
+        {
+            resetTimeSpanStatistics(&pStat->releaseJitter);
+            resetTimeSpanStatistics(&pStat->startLatency);
+            resetTimeSpanStatistics(&pStat->responseTime);
+        }
+    }
+    SREG = sreg;
+
+} /* End of rtos_getTaskStatistics */
+#endif
+
 
 
 
-#if RTOS_USE_APPL_INTERRUPT_00 == RTOS_FEATURE_ON
+#if RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_ON
 /**
- * A conditionally compiled interrupt function. If #RTOS_USE_APPL_INTERRUPT_00 is set to
- * #RTOS_FEATURE_ON, this function implements an interrupt service routine, which posts
- * event #RTOS_EVT_ISR_USER_00 every time the interrupt occurs.\n
- *   The use case is to have a task (of high priority) which implements an infinite loop.
- * At the beginning of each loop cycle the task will suspend itself waiting for this event
- * (or maybe a timeout). The body of the loop will then handle the interrupt.\n
- *   In the AVR environment, an ISR can't be compiled independently of the actual interrupt
- * source it might be connected to. Therefore, to make this code compilable, the name of
- * the interrupt vector to be used has to be specified. Please set #RTOS_ISR_USER_00 to the
- * desired vector's name, like TIMER3_COMPA_vect. The supported vector names can be derived
- * from table 14-1 on page 105 in the CPU manual, doc2549.pdf (see http://www.atmel.com)\n
- *   CAUTION: There's only one ISR for each interrupt source. If you'd e.g. use
- * TIMER0_OVF_vect, you'd disable the time measurement routines of Arduino. Functions like
- * \a millis() or \a delay() would no longer work. Due to their global sphere of influence
- * interrupts must be chosen very carefully.
+ * Set the relative deadline of a task. Each time the task is made due, its absolute
+ * deadline is set to the nominal due time plus this value; the nominal due time is the
+ * requested time if the task is resumed by the absolute timer, otherwise it is the time
+ * when the task became due. If the task doesn't suspend itself before the tic of the
+ * absolute deadline has passed, a deadline miss is counted.\n
+ *   The function may be called from setup or at any time from a task or from the idle
+ * task. The new deadline applies to the next activation of the task.
+ *   @param idxTask
+ * The index of the task. The index is the same as used when initializing the tasks (see
+ * rtos_initializeTask).
+ *   @param timeDeadline
+ * The relative deadline in system timer tics. A value of null switches the monitoring off
+ * for the task. The value must be less than half the cycle time of the system time.
  *   @remark
- * The implementation of this ISR makes use of the code of the task called routine \a
- * rtos_sendEvent. Both routines need to be maintained in strict accordance.
- *   @see
- * void rtos_sendEvent(uint16_t)
+ * If the task belongs to the EDF priority class #RTOS_EDF_PRIO_CLASS, then the relative
+ * deadline, which had been passed to \a rtos_initializeTask, is replaced; it determines
+ * the scheduling of the task, too.
+ *   @see uint8_t rtos_getTaskDeadlineMissCounter(uint8_t, boolean)
  */
 
-ISR(RTOS_ISR_USER_00, ISR_NAKED)
+void rtos_setTaskDeadline(uint8_t idxTask, uintTime_t timeDeadline)
 {
-    /* The program counter as first element of the context is already on the stack (by
-       calling this function). Save rest of context onto the stack of the interrupted
-       active task. */
-    PUSH_CONTEXT_ONTO_STACK
-
-	/* We must not exclude that the zero_reg is temporarily altered in the arbitrarily
-       interrupted code. To make the local code here running, we need to anticipate this
-       situation and clear the register. */
-    asm volatile
-    ("clr __zero_reg__ \n\t"
-    );
+    ASSERT(idxTask < RTOS_NO_TASKS  &&  timeDeadline <= (uintTime_t)-1 / 2
+           &&  (RTOS_EVT_DEADLINE_MISS
+                & (MASK_EVT_IS_MUTEX | MASK_EVT_IS_SEMAPHORE | MASK_EVT_IS_TIMER)
+               ) == 0
+          );
 
-    /* The implementation of this ISR makes use of the code of the task called routine
-       rtos_sendEvent. (Both routines need to be maintained in strict accordance.) That
-       function is executed with a constant parameter (r24/25) - the event mask just
-       containing the event which is posted by this interrupt. */
-    asm volatile
-    ( "ldi r24,lo8(" STR(RTOS_EVT_ISR_USER_00) ") \n\t"
-      "ldi r25,hi8(" STR(RTOS_EVT_ISR_USER_00) ") \n\t"
-      "rjmp LabelEntrySetEventForISR \n\t"
-    );
-} /* End of ISR(RTOS_ISR_USER_00) */
+    /* The system time may be a multi Byte word. */
+    const uint8_t sreg = SREG;
+    cli();
+    _taskAry[idxTask].timeDeadline = timeDeadline;
+    SREG = sreg;
 
-#endif /* RTOS_USE_APPL_INTERRUPT_00 == RTOS_FEATURE_ON */
+} /* End of rtos_setTaskDeadline */
 
 
 
 
-#if RTOS_USE_APPL_INTERRUPT_01 == RTOS_FEATURE_ON
 /**
- * A conditionally compiled interrupt function. If #RTOS_USE_APPL_INTERRUPT_01 is set to
- * #RTOS_FEATURE_ON, this function implements an interrupt service routine, which posts
- * event #RTOS_EVT_ISR_USER_01 every time the interrupt occurs.\n
- *   See documentation of ISR for application interrupt 0 for more details.
+ * Get the number of deadline misses of a task. A deadline miss is counted if the task
+ * doesn't complete its activation, i.e. it doesn't suspend itself, before its deadline has
+ * passed, see \a rtos_setTaskDeadline. The miss is recognized when the task suspends or -
+ * if #RTOS_EVT_DEADLINE_MISS is configured - in the system timer tic after the deadline.
+ * In the latter case the event is posted to a supervising task, too.\n
+ *   Different to the task overrun counter, a task is reported, which is late but still
+ * completes before its next due time.
+ *   @return
+ * Get the current value of the deadline miss counter. The counter saturates at 255.
+ *   @param idxTask
+ * The index of the task. The index is the same as used when initializing the tasks (see
+ * rtos_initializeTask).
+ *   @param doReset
+ * If true, the counter is reset to null after reading it. Read and reset are done
+ * atomically.
+ *   @see uint8_t rtos_getTaskOverrunCounter(uint8_t, boolean)
  */
 
-ISR(RTOS_ISR_USER_01, ISR_NAKED)
+uint8_t rtos_getTaskDeadlineMissCounter(uint8_t idxTask, boolean doReset)
 {
-    /* The program counter as first element of the context is already on the stack (by
-       calling this function). Save rest of context onto the stack of the interrupted
-       active task. */
-    PUSH_CONTEXT_ONTO_STACK
+    ASSERT(idxTask < RTOS_NO_TASKS);
+    uint8_t * const pCntDeadlineMiss = &_taskAry[idxTask].cntDeadlineMiss;
 
-	/* We must not exclude that the zero_reg is temporarily altered in the arbitrarily
-       interrupted code. To make the local code here running, we need to anticipate this
-       situation and clear the register. */
-    asm volatile
-    ("clr __zero_reg__ \n\t"
-    );
+    if(doReset)
+    {
+        uint8_t retCode;
 
-    /* The implementation of this ISR makes use of the code of the task called routine
-       rtos_sendEvent. (Both routines need to be maintained in strict accordance.) That
-       function is executed with a constant parameter (r24/25) - the event mask just
-       containing the event which is posted by this interrupt. */
-    asm volatile
-    ( "ldi r24,lo8(" STR(RTOS_EVT_ISR_USER_01) ") \n\t"
-      "ldi r25,hi8(" STR(RTOS_EVT_ISR_USER_01) ") \n\t"
-      "rjmp LabelEntrySetEventForISR \n\t"
-    );
-} /* End of ISR(RTOS_ISR_USER_01) */
+        cli();
+        {
+            retCode = *pCntDeadlineMiss;
+            *pCntDeadlineMiss = 0;
+        }
+        sei();
 
-#endif /* RTOS_USE_APPL_INTERRUPT_01 == RTOS_FEATURE_ON */
+        return retCode;
+    }
+    else
+    {
+        /* Reading an 8 Bit word is an atomic operation as such, no additional lock
+           operation needed. */
+        return *pCntDeadlineMiss;
+    }
+} /* End of rtos_getTaskDeadlineMissCounter */
+#endif
 
 
 
 
 /**
- * A task (including the idle task) may post an event. The event is broadcasted to all
- * suspended tasks which are waiting for it. An event is not saved beyond that. If a task
- * suspends and starts waiting for an event which has been posted by another task just
- * before, it'll wait forever and never be resumed.\n
- *   The posted event may resume another task, which may be of higher priority as the
- * event posting task. In this case \a sendEvent will cause a task switch. The calling task
- * stays due but stops to be the active task. It does not become suspended (this is why
- * even the idle task may call this function). The activated task will resume by coming out
- * of the suspend command it had been invoked to wait for this event. The return value of
- * this suspend command will then tell about the event set here.\n
- *   If no task of higher priority is resumed by the posted event the calling task will be
- * continued immediately after execution of this method. In this case \a sendEvent behaves
- * like any ordinary sub-routine.
- *   @param eventVec
- * A bit vector of posted events. Known events are defined in rtos.h. The timer events
- * RTOS_EVT_ABSOLUTE_TIMER and RTOS_EVT_DELAY_TIMER cannot be posted.
- *   @see
- * uint16_t rtos_waitForEvent(uint16_t, boolean, uintTime_t)
- *   @remark
- * It is absolutely essential that this routine is implemented as naked and noinline. See
- * http://gcc.gnu.org/onlinedocs/gcc/Function-Attributes.html for details
- *   @remark
- * In optimization level 0 GCC has a problem with code generation for naked functions. See
- * function #rtos_suspendTaskTillTime for details.
+ * Compute how many bytes of the stack area of a task are still unused. If the value is
+ * requested after an application has been run a long while and has been forced to run
+ * through all its paths many times, it may be used to optimize the static stack allocation
+ * of the task. The function is useful only for diagnosis purpose as there's no chance to
+ * dynamically increase or decrease the stack area at runtime.\n
+ *   The function may be called from a task or from the idle task.\n
+ *   The algorithm is as follows: The unused part of the stack is initialized with a
+ * specific pattern byte. This routine counts the number of subsequent pattern bytes down
+ * from the top of the stack area. This number is returned.\n
+ *   The returned result must not be trusted too much: It could of course be that a pattern
+ * byte is found not because of the initialization but because it has been pushed onto the
+ * stack - in which case the return value is too great (too optimistic) by one. The
+ * probability that this happens is significantly greater than zero. The chance that two
+ * pattern bytes had been pushed is however much less and the probability of three, four,
+ * five such bytes in sequence is negligible. (Except the irrelevant case you initialize
+ * an automatic array variable with all pattern bytes.) Any stack size optimization based
+ * on this routine should therefore subtract e.g. five bytes from the returned reserve and
+ * diminish the stack outermost by this modified value.\n
+ *   Be careful with stack size optimization based on this routine: Even if the application
+ * ran a long time there's a non-zero probability that there has not yet been a system
+ * timer interrupt in the very instance that the code of the task of interest was busy in
+ * the deepest nested sub-routine, i.e. when having the largest stack consumption. A good
+ * suggestion is to have another 36 Byte of reserve - this is the stack consumption if an
+ * interrupt occurs.\n
+ *   Recipe: Run your application a long time, ensure that it ran through all paths, get
+ * the stack reserve from this routine, subtract 5+36 Byte and diminish the stack by this
+ * value.
+ *   @return
+ * The number of still unused stack bytes. See function description for details.\n
+ *   If #RTOS_LAZY_STACK_PAINTING is on and if the idle task has not yet filled the stack
+ * area of the task with the pattern byte then #RTOS_STACK_RESERVE_UNKNOWN is returned.
+ * Later, the stack usage of the activations of the task before the painting is not
+ * contained in the result, see #RTOS_STACK_RESERVE_UNKNOWN.
+ *   @param idxTask
+ * The index of the task the stack usage has to be investigated for. The index is the
+ * same as used when initializing the tasks (see rtos_initializeTask).
  *   @remark
- * The implementation of this function is reused on machine code level by the
- * implementation of the application interrupt service routines \a ISR(RTOS_ISR_USER_nn).
- * This function needs to be maintained in strict accordance with the implementation of the
- * ISRs.
+ * The computation is a linear search for the first non-pattern byte and thus relatively
+ * expensive. It's suggested to call it only in some specific diagnosis compilation or
+ * occasionally from the idle task.
+ *   @see
+ * void rtos_initializeTask()
  */
-#ifndef __OPTIMIZE__
-# error This code must not be compiled with optimization off. See source code comments for more
-#endif
 
-RTOS_NAKED_FCT void rtos_sendEvent(uint16_t eventVec)
+uint16_t rtos_getStackReserve(uint8_t idxTask)
 {
-    /* This function is a pseudo-software interrupt. A true interrupt had reset the global
-       interrupt enable flag, we inhibit any interrupts now. */
-    asm volatile
-    ( "cli \n\t"
-    );
+    uint8_t * const pStackArea = GET_STACK_AREA(idxTask)
+          , *sp = pStackArea;
 
-    /* The program counter as first element of the context is already on the stack (by
-       calling this function). Save rest of context onto the stack of the interrupted
-       active task. sendEvent does not return anything; we push register pair r24/25 and
-       this will be restored on function exit. */
-    PUSH_CONTEXT_ONTO_STACK
+#if RTOS_LAZY_STACK_PAINTING == RTOS_FEATURE_ON
+    /* The search for the pattern bytes is meaningless as long as they are not written. */
+    if(idxTask >= _idxTaskStackPaint)
+        return RTOS_STACK_RESERVE_UNKNOWN;
+#endif
 
-    /* The next assembler statement has no direct impact but permits to jump on machine
-       code level into the middle of this function. The application ISRs make use of this:
-       They push the interrupted context, load the parameter register pair r24/25 with the
-       event they are assigned to and jump here to reuse the code for posting an event and
-       probably initiate a task switch. */
-    asm volatile
-    ( "LabelEntrySetEventForISR: \n\t"
-    );
+    /* The bottom of the stack is always initialized with 0, which must not be the pattern
+       byte. Therefore we don't need a limitation of the search loop - it'll always find a
+       non-pattern byte in the stack area. */
+    while(*sp == UNUSED_STACK_PATTERN)
+        ++ sp;
 
-    /* Check for all suspended tasks if the posted events will resume them.
-         The actual implementation of the function's logic is placed into a sub-routine in
-       order to benefit from the compiler generated stack frame for local variables (in
-       this naked function we must not have declared any). */
-    if(sendEvent(eventVec))
+    return sp - pStackArea;
+
+} /* End of rtos_getStackReserve */
+
+
+
+
+/**
+ * Get the current system time. The system time is the cyclic counter of the system timer
+ * tics, which the kernel uses for all its timing operations, see \a uintTime_t.\n
+ *   The function may be called from a task, from the idle task or from an interrupt service
+ * routine. It doesn't touch the global interrupt enable flag.
+ *   @return
+ * Get the current system time.
+ */
+
+uintTime_t rtos_getTime(void)
+{
+    if(sizeof(uintTime_t) == 1)
     {
-        /* Yes, another task becomes active because of the posted events. Switch the stack
-           pointer to the (saved) stack pointer of that task. */
-        SWITCH_CONTEXT
-        PUSH_RET_CODE_OF_CONTEXT_SWITCH
+        /* Reading an 8 Bit word is an atomic operation as such, no additional lock
+           operation needed. */
+        return _time;
     }
+    else
+    {
+        uintTime_t time;
+        const uint8_t sreg = SREG;
 
-    /* The stack pointer points to the now active task (which will often be still the same
-       as at function entry). The CPU context to continue with is popped from this stack. If
-       there's no change in active task the entire routine call is just like any ordinary
-       interrupt. */
-    POP_CONTEXT_FROM_STACK
-
-    /* The global interrupt enable flag is not saved across task switches, but always set
-       on entry into the new or same context by using a reti rather than a ret. */
-    asm volatile
-    ( "reti \n\t"
-    );
+        cli();
+        time = _time;
+        SREG = sreg;
 
-} /* End of rtos_sendEvent */
+        return time;
+    }
+} /* End of rtos_getTime */
 
 
 
 
+#if RTOS_USE_CTC_SYSTEM_TIMER == RTOS_FEATURE_ON
 /**
- * This is a code pattern (inline function) which saves the resume condition of a task,
- * which is going to be suspended into its task object. This pattern is mainly used in the
- * suspend function rtos_waitForEvent but also at task initialization time, when the
- * initial task start condition is specified by the application code.
- *   @param pT
- * Pointer to the task object of the suspend task.
- *   @param eventMask
- * See function \a rtos_waitForEvent for details.
- *   @param all
- * See function \a rtos_waitForEvent for details.
- *   @param timeout
- * See function \a rtos_waitForEvent for details.
- *   @see
- * void rtos_waitForEvent(uint16_t, boolean, uintTime_t)
+ * Read the counter register of the system timer and find out whether a system timer tic
+ * has been elapsed, which has not been served yet by the interrupt service routine.
+ *   @return
+ * Get true if the counter has wrapped around but the related interrupt has not been served
+ * yet. The caller needs to add one system timer tic to the time, which was accounted by the
+ * interrupt.
+ *   @param pCnt
+ * The value of the counter register is returned by reference.
  *   @remark
- * For performance reasons this function needs to be inlined. A macro would be an
- * alternative.
+ * The function must be called with globally disabled interrupts.
  */
 
-static inline void storeResumeCondition( task_t * const pT
-                                       , uint16_t eventMask
-                                       , boolean all
-                                       , uintTime_t timeout
-                                       )
+static inline boolean readSystemTimerCnt(uint16_t *pCnt)
 {
-    /* Check event condition: It must not be empty. The two timers can't be used at the
-       same time (which is a rather harmless application design error) and at least one
-       other event needs to be required for a resume in case of the AND condition.
-         The latter bad situation leads to a crash. If all is set then RTuinOS interprets
-       the empty event mask as the always fulfilled resume condition. The task became due
-       without any bit set in the task's postedEventVec - which leads to a wrong state
-       transition in the kernel. (Please refer to the manual for a detail explanation of
-       the task state meaning of postedEventVec.) */
-    ASSERT(eventMask != 0
-           &&  (eventMask & MASK_EVT_IS_TIMER) != MASK_EVT_IS_TIMER
-           &&  (!all || (eventMask & ~MASK_EVT_IS_TIMER) != 0)
-          );
-
-    /* The timing parameter may refer to different timers. Depending on the event mask we
-       either load the one or the other timer. Default is the less expensive delay
-       counter. */
-    if((eventMask & RTOS_EVT_ABSOLUTE_TIMER) != 0)
+    boolean isTicPending = false;
+    uint16_t cnt = RTOS_CTC_TCNT;
+
+    /* The counter may have wrapped around before or after reading it but the related
+       interrupt has not been served yet - the global interrupts are locked. The wrap around
+       is indicated by the pending interrupt flag. If so we need to re-read the counter to
+       be sure to have the value after the wrap around. In the same CPU clock tic the flag
+       is set the counter still holds the compare value; it is reset to zero only with the
+       next timer clock tic. */
+    if((RTOS_CTC_TIFR & _BV(RTOS_CTC_OCFA)) != 0)
     {
-        /* This suspend command wants a reactivation at a certain time. The new time is
-           assigned by the += in the conditional expression.
-             Task overrun detection: The new time must be no more than half a cycle in the
-           future. The test uses a signed comparison. The unsigned comparison >= 0x80 would be
-           equivalent but probably less performant (TBC). */
-        if((intTime_t)((pT->timeDueAt+=timeout) - _time) <= 0)
-        {
-            if(pT->cntOverrun < 0xff)
-                ++ pT->cntOverrun;
-
-            /* The wanted point in time is over. We do the best recovery which is possible: Let
-               the task become due in the very next timer tic.
-                 In specific situations, this can be counter productive - the application
-               may turn off this corrective action. See documentation: If the eight Bit
-               system timer and very slow, regular tasks are used there's a high risk of
-               seeing false overrun recognitions. Now making the task due immediately would
-               introduce a true error. */
-#if RTOS_OVERRUN_TASK_IS_IMMEDIATELY_DUE == RTOS_FEATURE_ON
-            pT->timeDueAt = _time+1;
-#endif
-        }
+        cnt = RTOS_CTC_TCNT;
+        isTicPending = cnt < RTOS_CTC_OCR_VALUE;
     }
-    else
-    {
-        /* The timeout counter is reloaded. We could do this conditionally if the bit is
-           set, but in all normal use cases it'll and if not it doesn't harm. We will
-           just decrement the delay counter in onTimerTic once but not set the event.
-             ++ timeout: The call of the suspend function is in no way synchronized with the
-           system clock. We define the delay to be a minimum and implement the resolution
-           caused uncertainty as an additional delay. */
-        if((uintTime_t)(timeout+1) != 0)
-            ++ timeout;
-        pT->cntDelay = timeout;
 
-    } /* if(Which timer is addressed for the timeout condition?) */
+    *pCnt = cnt;
+    return isTicPending;
 
-    pT->eventMask = eventMask;
-    pT->waitForAnyEvent = !all;
+} /* End of readSystemTimerCnt */
+
+
+
+
+/**
+ * Get a high resolution time stamp. The time stamp is composed of the number of elapsed
+ * system timer tics and the current value of the counter register of the system timer. Its
+ * unit is the clock tic of the system timer, see #RTOS_TIMESTAMP_UNIT; this is 62.5 ns for
+ * system timer periods of up to 4 ms and a CPU clock of 16 MHz.\n
+ *   The time stamp is a cyclic 32 Bit counter. Time spans are computed by unsigned
+ * subtraction of two time stamps.\n
+ *   The function may be called from a task, from the idle task or from an interrupt service
+ * routine. It doesn't touch the global interrupt enable flag. Its execution time is about
+ * 2 us.
+ *   @return
+ * Get the current time stamp.
+ *   @remark
+ * The function is available only if the built-in CTC system timer is used, see
+ * #RTOS_USE_CTC_SYSTEM_TIMER. The standard system timer of RTuinOS, timer 2 in phase
+ * correct PWM mode, counts up and down; its counter value doesn't unambiguously tell the
+ * elapsed time since the last tic.
+ */
+
+uint32_t rtos_getTimestamp(void)
+{
+    uint32_t timestamp;
+    uint16_t cnt;
+    const uint8_t sreg = SREG;
+
+    cli();
+    timestamp = _timestampAtTic;
+    if(readSystemTimerCnt(&cnt))
+        timestamp += RTOS_CTC_OCR_VALUE + 1ul;
+    SREG = sreg;
+
+    return timestamp + cnt;
+
+} /* End of rtos_getTimestamp */
+#endif
 
-} /* End of storeResumeCondition */
 
 
 
-#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
+#if RTOS_PROVIDE_ARDUINO_TIME == RTOS_FEATURE_ON
 /**
- * Waiting for events doesn't necessarily mean waiting: If the wait condition includes
- * mutexes and semaphores these may already be available on entry in the wait function.
- * This routine checks all demanded sync objects and locks and allocates all those objects
- * to the calling task, which are currently free.
+ * Substitute for the Arduino library function micros(). The linker redirects all calls of
+ * micros() to this function, see makefile variable WRAP_ARDUINO_TIME. Before the RTuinOS
+ * system timer is started the original function is used. Afterwards, the time is derived
+ * from the system timer and the interrupt of timer 0 is disabled.
  *   @return
- * Finally the routine checks if the wait condition of the suspend command is already
- * fulfilled with the found sync objects. If and only if so it returns true and the suspend
- * command won't actually block the calling task.
- *   @param eventMask
- * See function \a rtos_waitForEvent for details.
- *   @param all
- * See function \a rtos_waitForEvent for details.
- *   @see
- * void rtos_waitForEvent(uint16_t, boolean, uintTime_t)
+ * Get the time since start of the application in us. The value is cyclic with a period of
+ * about 71 minutes.
  *   @remark
- * This function is inlined for performance reasons.
+ * The function may be called from a task, from the idle task or from an interrupt service
+ * routine. It doesn't touch the global interrupt enable flag.
  */
 
-static inline boolean acquireFreeSyncObjs(uint16_t eventMask, boolean all)
+extern "C" unsigned long __wrap_micros(void)
 {
-#if RTOS_USE_MUTEX == RTOS_FEATURE_ON
-    /* Check for immediate availability of all/any mutex. These mutexes are locked now and
-       entered in the calling task's postedEventVec. */
-    _pActiveTask->postedEventVec = eventMask & _mutexVec;
-
-    /* Lock the demanded mutexes. Bits in eventMask which do not correspond to mutex events
-       don't need to be masked. They may reset some anyway reset don't-care bits in
-       _mutexVec. */
-    _mutexVec &= ~eventMask;
-#endif
+    if(!_isArduinoTimeProvided)
+        return __real_micros();
 
-#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
-    /* Check for immediate availability of all/any semaphores. The counters of none zero
-       semaphores are decremented now and the related acquired-bit is set in the calling
-       task's postedEventVec. */
-    uint8_t idxSem = 0
-          , maskSem = 0x01
-          , semaphoreToAcquireVec = eventMask & MASK_EVT_IS_SEMAPHORE;
-    while(semaphoreToAcquireVec)
-    {
-        if((semaphoreToAcquireVec & 0x01) != 0)
-        {
-            if(rtos_semaphoreAry[idxSem] > 0)
-            {
-                -- rtos_semaphoreAry[idxSem];
-                _pActiveTask->postedEventVec |= maskSem;
-            }
-        }
+    uint32_t us;
+    uint16_t cnt;
+    const uint8_t sreg = SREG;
 
-        /* Test next event bit and increment related index of semaphore in array. */
-        ++ idxSem;
-        maskSem <<= 1;
-        semaphoreToAcquireVec >>= 1;
-    }
-#endif
+    cli();
+    us = _microsAtTic;
+    if(readSystemTimerCnt(&cnt))
+        us += RTOS_CTC_TIC_PERIOD_US;
+    SREG = sreg;
 
-    /* postedEventVec now contains all requested mutexes, which were currently available.
-       If these were all demanded events, we don't need to suspend the task but can
-       immediately and successfully return. The timer bits (events 14 and 15) don't matter
-       as they are always OR terms. We definitely don't need to wait for them. */
-    return (!all &&  _pActiveTask->postedEventVec != 0)
-           || (all &&  ((_pActiveTask->postedEventVec ^ eventMask) & ~MASK_EVT_IS_TIMER) == 0);
+    /* The conversion of the counter value is done with compile time constants. For the
+       prescalers 1 and 8 it becomes a shift operation. */
+    return us + (uint32_t)cnt * RTOS_CTC_PRESCALER / (F_CPU/1000000ul);
 
-} /* End of acquireFreeSyncObjs */
+} /* End of __wrap_micros */
 
-#endif /* RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON */
 
 
 
 /**
- * Actual implementation of task suspension routine \a rtos_waitForEvent. The task is
- * suspended until a specified event occurs.\n
- *   The action of this SW interrupt is placed into an own function in order to let the
- * compiler generate the stack frame required for all local data. (The stack frame
- * generation of the SW interrupt entry point needs to be inhibited in order to permit the
- * implementation of saving/restoring the task context).
+ * Substitute for the Arduino library function millis(). The linker redirects all calls of
+ * millis() to this function, see __wrap_micros for details.
  *   @return
- * If mutex or semaphores are in use the function returns the Boolean information whether
- * the calling task has to be suspended. This is not the case if all demanded sync objects
- * are currently available. If RTuinOS is compiled without support of mutexes and
- * sempahores than the calling task is always suspended.\n
- *   By means of side effects, the function returns which task is to be activated and records
- * which task is left (i.e. the task calling this routine) in the global variables \a
- * _pActiveTask and \a _pSuspendedTask.
- *   @param eventMask
- * See software interrupt \a rtos_waitForEvent.
- *   @param all
- * See software interrupt \a rtos_waitForEvent.
- *   @param timeout
- * See software interrupt \a rtos_waitForEvent.
- *   @see
- * uint16_t rtos_waitForEvent(uint16_t, boolean, uintTime_t)
+ * Get the time since start of the application in ms. The value is cyclic with a period of
+ * about 50 days.
  *   @remark
- * This function and particularly passing the return codes via a global variable will
- * operate only if all interrupts are disabled.
+ * The function may be called from a task, from the idle task or from an interrupt service
+ * routine. It doesn't touch the global interrupt enable flag.
  */
 
-#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
-static RTOS_TRUE_FCT boolean waitForEvent( uint16_t eventMask
-                                           , boolean all
-                                           , uintTime_t timeout
-                                           )
-#else
-static RTOS_TRUE_FCT void waitForEvent(uint16_t eventMask, boolean all, uintTime_t timeout)
-#endif
-
+extern "C" unsigned long __wrap_millis(void)
 {
-    /* Avoid inlining under all circumstances. See attributes also. */
-    asm("");
+    if(!_isArduinoTimeProvided)
+        return __real_millis();
 
-    /* Here, we could double-check _pActiveTask for the idle task and return without
-       context switch if it is active. (The idle task has illicitly called a suspend
-       command.) However, all implementation rates performance higher than failure
-       tolerance, and so do we here. */
-    ASSERT(_pActiveTask != _pIdleTask);
+    uint32_t ms, fractInUs;
+    uint16_t cnt;
+    const uint8_t sreg = SREG;
 
-#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
-    if(acquireFreeSyncObjs(eventMask, all))
-        return false;
-#endif
+    cli();
+    ms = _millisAtTic;
+    fractInUs = _fractMillisAtTic;
+    if(readSystemTimerCnt(&cnt))
+        fractInUs += RTOS_CTC_TIC_PERIOD_US;
+    SREG = sreg;
 
-    int8_t idxPrio;
-    int8_t idxTask;
+    fractInUs += (uint32_t)cnt * RTOS_CTC_PRESCALER / (F_CPU/1000000ul);
+    return ms + fractInUs/1000u;
 
-    /* Take the active task out of the list of due tasks. */
-    task_t * const pT = _pActiveTask;
-    uint8_t prio = pT->prioClass;
-    uint8_t noDueNow = -- _noDueTasksAry[prio];
-    for(idxTask=0; idxTask<noDueNow; ++idxTask)
-        _pDueTaskAryAry[prio][idxTask] = _pDueTaskAryAry[prio][idxTask+1];
+} /* End of __wrap_millis */
 
-    /* This suspend command wants a reactivation by a combination of events (which may
-       include the timeout event). Save the resume condition in the task object. The
-       operation is implemented as inline function to be able to reuse the code in the
-       task initialization routine. */
-    storeResumeCondition(pT, eventMask, all, timeout);
 
-    /* Put the task in the list of suspended tasks. If mutexes or semaphores are in use
-       this list is sorted with decreasing priority. */
-#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
-    /* < rather than <=: The now suspended task becomes the last one in its prio class. The
-       others of same priority are waiting longer and will receive a later posted event
-       with priority. */
-    int8_t idxPos;
-    for(idxPos=0; idxPos<_noSuspendedTasks; ++idxPos)
-        if(_pSuspendedTaskAry[idxPos]->prioClass < prio)
-            break;
 
-    /* Shift rest of the list one to the end. This loop requires a signed index. */
-    for(idxTask=_noSuspendedTasks++ - 1; idxTask>=idxPos; --idxTask)
-        _pSuspendedTaskAry[idxTask+1] = _pSuspendedTaskAry[idxTask];
 
-    /* Insert the suspended task at the priority determined right position. */
-    _pSuspendedTaskAry[idxPos] = pT;
-#else
-    _pSuspendedTaskAry[_noSuspendedTasks++] = pT;
-#endif
+/**
+ * Substitute for the Arduino library function delay(). The linker redirects all calls of
+ * delay() to this function. The implementation is the same busy wait as the original one
+ * but it is based on the substitute of micros().
+ *   @param ms
+ * The time to wait in ms.
+ *   @remark
+ * This function should not be used by a task. A task will rather suspend itself by
+ * calling \a rtos_delay. A busy wait would burden all tasks of lower priority.
+ */
 
-    /* Record which task suspends itself for the assembly code in the calling function
-       which actually switches the context. */
-    _pSuspendedTask = _pActiveTask;
+extern "C" void __wrap_delay(unsigned long ms)
+{
+    uint16_t start = (uint16_t)__wrap_micros();
 
-    /* Look for the task we will return to. It's the first entry in the highest non-empty
-       priority class. The loop requires a signed index.
-         It's not guaranteed that there is any due task. Idle is the fallback. */
-    _pActiveTask = _pIdleTask;
-    for(idxPrio=RTOS_NO_PRIO_CLASSES-1; idxPrio>=0; --idxPrio)
+    while(ms > 0)
     {
-        if(_noDueTasksAry[idxPrio] > 0)
+        if((uint16_t)((uint16_t)__wrap_micros() - start) >= 1000u)
         {
-            _pActiveTask = _pDueTaskAryAry[idxPrio][0];
-            break;
+            -- ms;
+            start += 1000u;
         }
     }
-
-#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
-    return true;
+} /* End of __wrap_delay */
 #endif
-} /* End of waitForEvent */
 
 
 
 
+
+#if RTOS_INCREMENTAL_STACK_SCAN == RTOS_FEATURE_ON
 /**
- * Suspend the current task (i.e. the one which invokes this method) until a specified
- * combination of events occur. In the special case, that the specified combination of
- * events can be satisfied with currently available synchronization objects (mutexes and
- * semaphores) the function will return immediately without suspending the calling task.\n
- *   A task is suspended in the instance of calling this method. It specifies a list of
- * events. The task becomes due again, when either the first one or all of the specified
- * events have been posted by other tasks.\n
- *   The idle task can't be suspended. If it calls this function a crash would be the
- * immediate result.
+ * Advance the incremental stack usage monitor. This function is the non-blocking
+ * counterpart of \a rtos_getStackReserve. It is intended to be regularly called from the
+ * idle task; the application's loop() is the natural place.\n
+ *   The stacks of all tasks are inspected one after another and in cycles. Each call of the
+ * function looks at no more than \a noBytes bytes. If the inspection of a task's stack is
+ * completed, the result is cached and can be queried at any time and at negligible cost by
+ * \a rtos_getCachedStackReserve.\n
+ *   The stack reserve of a task can only shrink. Consequently, a scan never needs to look
+ * beyond the reserve, which was found in the previous cycle. The longer the application
+ * runs the less bytes need to be inspected and the faster a cycle completes.\n
+ *   The same pattern byte based algorithm is applied as in \a rtos_getStackReserve. Please
+ * refer to this function for a discussion of the accuracy of the result.
  *   @return
- * The set of actually resuming events is returned as a bit vector which corresponds
- * bitwise to eventMask. See \a rtos.h for a list of known events.
- *   @param eventMask
- * The bit vector of events to wait for. Needs to include either the delay timer event
- * #RTOS_EVT_DELAY_TIMER or #RTOS_EVT_ABSOLUTE_TIMER, if a timeout is required, but not both
- * of them.\n
- *   The normal use case will probably be the delay timer. However, a regular task may also
- * specify the absolute timer with the next regular task time as parameter so that it
- * surely becomes due outermost at its usual task time.
- *   @param all
- *   If false, the task is made due as soon as the first event mentioned in \a eventMask is
- * seen.\n
- *   If true, the task is made due only when all events are posted to the suspending task -
- * except for the timer events, which are still OR combined. If you say "all" but the event
- * mask contains either #RTOS_EVT_DELAY_TIMER or #RTOS_EVT_ABSOLUTE_TIMER, the task will
- * resume when either the timer elapsed or when all other events in the mask were seen.\n
- *   Caution: If all is true, there need to be at least one event bit set in \a eventMask
- * besides a timer bit; RTuinOS crashes otherwise. Saying: "No particular event, just a
- * timer condition" needs to be implemented by \a all set to false and \a eventMask set to
- * only a timer event bit.
- *   @param timeout
- * If \a eventMask contains #RTOS_EVT_DELAY_TIMER:\n
- *   The number of system timer tics from now on until the timeout elapses. One should be
- * aware of the resolution of any timing being the tic of the system timer. A timeout of \a
- * n may actually mean any delay in the range \a n .. \a n+1 tics.\n
- *   Even specifying 0 will suspend the task a short time and give others the chance to
- * become active - particularly other tasks belonging to the same priority class.\n
- *   If \a eventMask contains #RTOS_EVT_ABSOLUTE_TIMER:\n
- *   The absolute time the task becomes due again at latest. The time designation is
- * relative; it refers to the last recent absolute time at which this task had been
- * resumed. See #rtos_suspendTaskTillTime for details.\n
- *   Now the range of the parameter is 1 till the half the range of the data type which is
- * configured for the system time, e.g. 127 in case of uint8_t. Otherwise proper task
- * timing can't be guaranteed.\n
- *   If neither #RTOS_EVT_DELAY_TIMER nor #RTOS_EVT_ABSOLUTE_TIMER is set in the event mask,
- * this parameter should be zero.
+ * Get true if this call has completed a cycle, i.e. the cached reserves of all tasks have
+ * been updated since the previous cycle.
+ *   @param noBytes
+ * The maximum number of bytes to inspect in this call. The execution time of the function
+ * is about linear in this number. Pass e.g. 8 or 16 to make the function call very cheap.
+ *   @remark
+ * The function must be called solely from the idle task.
+ *   @see uint16_t rtos_getCachedStackReserve(uint8_t)
  */
- 
-RTOS_NAKED_FCT uint16_t rtos_waitForEvent( uint16_t eventMask
-                                         , boolean all
-                                         , uintTime_t timeout
-                                         )
+
+boolean rtos_scanStackReserve(uint8_t noBytes)
 {
-    /* It is absolutely essential that this routine is implemented as naked and noinline.
-       See http://gcc.gnu.org/onlinedocs/gcc/Function-Attributes.html for details.
-         GCC doesn't create a stack frame for naked functions. For normal functions, the
-       calling parameter of the function is stored in such a stack frame. In the
-       combination naked and having local function parameters, GCC has a problem when
-       generating code without optimization: It doesn't generate a stack frame but still
-       does save the local parameter into the (not existing) stack frame as very first
-       assembly operation of the function code. There's absolutely no work around; when the
-       earliest code, we can write inside the function is executed, the stack is already
-       corrupted in a hazardous way. A crash is unavoidable.
-         A discussion of the issue can be found at
-       http://lists.gnu.org/archive/html/avr-gcc-list/2012-08/msg00014.html.
-         To avoid this problem we forbid to compile the code with optimization off.
-       Nonetheless, who will ever know or understand under which circumstances, e.g. which
-       combination of optimization flags, GCC will again generate this crash-code. This
-       issue remains a severe risk! Consequently, at any change of a compiler setting you
-       will need to inspect the assembly listing file and double-check that it is proper
-       with respect of using (better not using) the stack frame for this function (and
-       rtos_sendEvent).
-         Another idea would be the implementation of this function completely in assembly
-       code. Doing so, we have the new problem of calling assembly code as C functions.
-       Find an example of how to do in
-       file:///M:/SVNMainRepository/Arduino/RTuinOS/trunk/RTuinOS/code/RTOS/rtos.c,
-       revision 215. */
-#ifndef __OPTIMIZE__
-# error This code must not be compiled with optimization off. See source code comments for more
+    task_t * const pT = &_taskAry[_idxTaskStackScan];
+    const uint8_t * const pStackArea = GET_STACK_AREA(_idxTaskStackScan);
+
+    /* The cached value is written only by this function, i.e. by the idle task. No lock is
+       needed to read it. */
+    const uint16_t stackReserve = pT->stackReserve;
+    uint16_t offs = _offsStackScan;
+    boolean isTaskDone = false;
+
+#if RTOS_LAZY_STACK_PAINTING == RTOS_FEATURE_ON
+    /* A stack area, which is not yet filled with the pattern byte, can't be inspected. The
+       stacks are filled in order of the task index, so none of the remaining tasks can be
+       inspected either. Start over with the first task. The cached reserve of a task is
+       initialized when its stack has been filled. */
+    if(_idxTaskStackScan >= _idxTaskStackPaint)
+    {
+        _idxTaskStackScan = 0;
+        return false;
+    }
 #endif
 
-    /* This function is a pseudo-software interrupt. A true interrupt had reset the global
-       interrupt enable flag, we inhibit any interrupts now. */
-    asm volatile
-    ( "cli \n\t"
-    );
+    while(noBytes-- > 0)
+    {
+        if(offs >= stackReserve)
+        {
+            /* No further byte has been used since the previous cycle. */
+            isTaskDone = true;
+            break;
+        }
+        else if(pStackArea[offs] != UNUSED_STACK_PATTERN)
+        {
+            /* The task has consumed more stack than before. Update the cached value. This
+               needs to be atomic as the value may be read by any task. */
+            cli();
+            pT->stackReserve = offs;
+            sei();
 
-    /* The program counter as first element of the context is already on the stack (by
-       calling this function). Save rest of context onto the stack of the interrupted
-       active task. */
-    PUSH_CONTEXT_WITHOUT_R24R25_ONTO_STACK
+            isTaskDone = true;
+            break;
+        }
+        else
+            ++ offs;
 
-    /* The actual implementation of the task switch logic is placed into a sub-routine in
-       order to benefit from the compiler generated stack frame for local variables (in
-       this naked function we must not have declared any). The call of the function is
-       immediately followed by some assembly code which computes the return value of the
-       function and places it in register pair r24/25. */
-#if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON  ||  RTOS_USE_MUTEX == RTOS_FEATURE_ON
-    if(waitForEvent(eventMask, all, timeout))
-#else
-    waitForEvent(eventMask, all, timeout);
-#endif
+    } /* while(Still bytes to inspect in this call) */
+
+    if(isTaskDone)
     {
-        /* The wait condition couldn't be fulfilled immediately, we need to suspend the
-           task. Switch the stack pointer to the (saved) stack pointer of the new active
-           task. */
-        SWITCH_CONTEXT
+        /* Continue with next task at next call. */
+        _offsStackScan = 0;
+        if(++_idxTaskStackScan >= RTOS_NO_TASKS)
+        {
+            _idxTaskStackScan = 0;
+            return true;
+        }
     }
+    else
+        _offsStackScan = offs;
 
-     /* Regardless whether we had switched the task the suspend command ends with returning
-        the information about the task releasing events. Push this function result onto the
-        (maybe new) stack - from where it is loaded into r24/r25 by the subsequent pop-context
-        command. */
-    PUSH_RET_CODE_OF_CONTEXT_SWITCH
+    return false;
 
-    /* The stack pointer points to the now active task (which may be still the same as at
-       function entry). The CPU context to continue with is popped from this stack. If
-       there's no change in active task the entire routine call is just like any ordinary
-       interrupt. */
-    POP_CONTEXT_FROM_STACK
+} /* End of rtos_scanStackReserve */
 
-    /* The global interrupt enable flag is not saved across task switches, but always set
-       on entry into the new or same context by using a reti rather than a ret. */
-    asm volatile
-    ( "reti \n\t"
-    );
 
-    /* This statement is never reached. Just to avoid the warning. */
-    return 0;
 
-} /* End of rtos_waitForEvent */
 
+/**
+ * Get the number of unused bytes of the stack area of a task as found by the incremental
+ * stack usage monitor.\n
+ *   The function returns the cached result of the last complete inspection of the task's
+ * stack and it is very cheap. It may be called from a task or from the idle task.
+ *   @return
+ * The number of still unused stack bytes at the time of the last complete inspection of
+ * the stack. Before the first inspection has completed, it is the number of bytes, which
+ * had been unused when the task was started.\n
+ *   If #RTOS_LAZY_STACK_PAINTING is on and if the idle task has not yet filled the stack
+ * area of the task with the pattern byte then #RTOS_STACK_RESERVE_UNKNOWN is returned.
+ * Later, the stack usage of the activations of the task before the painting is not
+ * contained in the result, see #RTOS_STACK_RESERVE_UNKNOWN.
+ *   @param idxTask
+ * The index of the task the stack usage has to be reported for. The index is the same as
+ * used when initializing the tasks (see rtos_initializeTask).
+ *   @remark
+ * The result is up-to-date only if the idle task regularly calls \a
+ * rtos_scanStackReserve.
+ *   @see boolean rtos_scanStackReserve(uint8_t)
+ */
+
+uint16_t rtos_getCachedStackReserve(uint8_t idxTask)
+{
+#if RTOS_LAZY_STACK_PAINTING == RTOS_FEATURE_ON
+    if(idxTask >= _idxTaskStackPaint)
+        return RTOS_STACK_RESERVE_UNKNOWN;
+#endif
 
+    /* The value is written by the idle task inside a critical section and the idle task
+       can't interrupt any other task. Reading is atomic without a lock. */
+    return _taskAry[idxTask].stackReserve;
 
+} /* End of rtos_getCachedStackReserve */
+#endif
 
 
 
 
+#if RTOS_USE_DEFERRED_WORK == RTOS_FEATURE_ON
 /**
- * Get the current value of the overrun counter of a given task.\n
- *   The value is a limited 8 Bit counter (i.e. it won't cycle around). This is considered
- * satisfying as any task overrun is a kind of error and should not happen in a real
- * application (with other words: even a Boolean information could be enough). Furthermore,
- * if a larger range is required, one can regularly ask for this information, accumulate it
- * and reset the value here to zero at the same time.\n
- *   The function may be called from a task or from the idle task.
+ * Post a work item to the deferred work queue. The item will be executed by the worker
+ * task, \a rtos_deferredWorkTask, after all items posted before.\n
+ *   The function can be called from any interrupt service routine, typically from the top
+ * half of an application interrupt, see #RTOS_APPL_INTERRUPT_LIST, and from a task. Its
+ * execution time is constant and short. It doesn't touch the global interrupt enable
+ * flag.
  *   @return
- * Get the current value of the overrun counter.
- *   @param idxTask
- * The index of the task the overrun counter of which is to be returned. The index is the
- * same as used when initializing the tasks (see rtos_initializeTask).
- *   @param doReset
- * Boolean flag, which tells whether to reset the value.\n
- *   Caution, when setting this to true, reading and resetting the value needs to become an
- * atomic operation, which requires a critical section. This is significantly more
- * expensive than just reading the value and it globally enables the interrupts finally.
- * Therefore this call may destroy a surrounding critical section.
+ * Get true if the item has been queued. If the queue is full, the item is lost and
+ * counted, see \a rtos_getNoLostDeferredWork.
+ *   @param workFunction
+ * The function, which is executed by the worker task.
+ *   @param arg
+ * The argument of \a workFunction, e.g. the value read from a hardware register.
  *   @remark
- * This function has some limitations and weaknesses: First of all, the concept of task
- * overruns is defined only for regular tasks. Secondary, and particularly when using the 8
- * Bit system timer, there's a significant probability of not recognizing huge task
- * overruns. Finally there's a significant probability of false recognitions of (not
- * happening) task overruns if the task period time is greater than half the system timer's
- * cycle time (i.e. greater than 127 for the 8 Bit system timer). Please, refer to the
- * RTuinOS manual for details.
- *   @see
- * void rtos_initializeTask()
+ * The function doesn't wake the worker task. An interrupt top half returns
+ * #RTOS_EVT_DEFERRED_WORK, a task calls rtos_sendEvent(#RTOS_EVT_DEFERRED_WORK) after
+ * posting the item.
  */
 
-uint8_t rtos_getTaskOverrunCounter(uint8_t idxTask, boolean doReset)
+boolean rtos_postDeferredWork(rtos_deferredWorkFunction_t workFunction, uint16_t arg)
 {
-    if(doReset)
+    boolean success = false;
+    const uint8_t sreg = SREG;
+    cli();
+
+    const uint8_t idxWrite = _idxWriteDeferredWork
+                , idxWriteNext = (idxWrite+1) & (RTOS_DEFERRED_WORK_QUEUE_SIZE-1);
+    if(idxWriteNext != _idxReadDeferredWork)
     {
-        uint8_t retCode
-              , * const pCntOverrun = &_taskAry[idxTask].cntOverrun;
+        _deferredWorkQueue[idxWrite].workFunction = workFunction;
+        _deferredWorkQueue[idxWrite].arg = arg;
+        _idxWriteDeferredWork = idxWriteNext;
+        success = true;
+    }
+    else if(_noLostDeferredWork < 0xff)
+        ++ _noLostDeferredWork;
 
-        /* Read and reset should be atomic for data consistency if the application wants to
-           accumulate the counter values in order to extend the counter's range. */
+    SREG = sreg;
+    return success;
+
+} /* End of rtos_postDeferredWork */
+
+
+
+
+/**
+ * The task function of the worker task, which executes the deferred work items in order of
+ * posting. The application creates a task with this function in setup(). Typically, the
+ * task belongs to the highest priority class; the work items should not block. The task
+ * is started either by #RTOS_EVT_DEFERRED_WORK or by a timeout, the start condition
+ * doesn't matter.\n
+ *   The stack of the task needs to be large enough for the most demanding work item.
+ *   @param initialResumeCondition
+ * The vector of events, which made the task due the very first time. Not used.
+ */
+
+void rtos_deferredWorkTask(uintEventVec_t initialResumeCondition)
+{
+    while(true)
+    {
         cli();
+        const uint8_t idxRead = _idxReadDeferredWork;
+        if(idxRead == _idxWriteDeferredWork)
         {
-            retCode = *pCntOverrun;
-            *pCntOverrun = 0;
+            /* The queue is empty. The check and the suspension of the task are atomic:
+               rtos_waitForEvent is entered with globally disabled interrupts, which are
+               re-enabled only when the task has become suspended. Therefore the event of
+               an item, which is posted meanwhile, can't be lost. */
+            rtos_waitForEvent(RTOS_EVT_DEFERRED_WORK, /* all */ false, /* timeout */ 0);
         }
-        sei();
+        else
+        {
+            /* The element is no longer touched by the posting contexts before the read
+               index is advanced. */
+            const deferredWork_t work = _deferredWorkQueue[idxRead];
+            _idxReadDeferredWork = (idxRead+1) & (RTOS_DEFERRED_WORK_QUEUE_SIZE-1);
+            sei();
 
-        return retCode;
-    }
-    else
-    {
-        /* Reading an 8 Bit word is an atomic operation as such, no additional lock
-           operation needed. */
-        return _taskAry[idxTask].cntOverrun;
+            work.workFunction(work.arg);
+        }
     }
-} /* End of rtos_getTaskOverrunCounter */
+} /* End of rtos_deferredWorkTask */
 
 
 
 
 /**
- * Compute how many bytes of the stack area of a task are still unused. If the value is
- * requested after an application has been run a long while and has been forced to run
- * through all its paths many times, it may be used to optimize the static stack allocation
- * of the task. The function is useful only for diagnosis purpose as there's no chance to
- * dynamically increase or decrease the stack area at runtime.\n
- *   The function may be called from a task or from the idle task.\n
- *   The algorithm is as follows: The unused part of the stack is initialized with a
- * specific pattern byte. This routine counts the number of subsequent pattern bytes down
- * from the top of the stack area. This number is returned.\n
- *   The returned result must not be trusted too much: It could of course be that a pattern
- * byte is found not because of the initialization but because it has been pushed onto the
- * stack - in which case the return value is too great (too optimistic) by one. The
- * probability that this happens is significantly greater than zero. The chance that two
- * pattern bytes had been pushed is however much less and the probability of three, four,
- * five such bytes in sequence is negligible. (Except the irrelevant case you initialize
- * an automatic array variable with all pattern bytes.) Any stack size optimization based
- * on this routine should therefore subtract e.g. five bytes from the returned reserve and
- * diminish the stack outermost by this modified value.\n
- *   Be careful with stack size optimization based on this routine: Even if the application
- * ran a long time there's a non-zero probability that there has not yet been a system
- * timer interrupt in the very instance that the code of the task of interest was busy in
- * the deepest nested sub-routine, i.e. when having the largest stack consumption. A good
- * suggestion is to have another 36 Byte of reserve - this is the stack consumption if an
- * interrupt occurs.\n
- *   Recipe: Run your application a long time, ensure that it ran through all paths, get
- * the stack reserve from this routine, subtract 5+36 Byte and diminish the stack by this
- * value.
+ * Get the number of work items, which could not be posted because the deferred work queue
+ * was full.
  *   @return
- * The number of still unused stack bytes. See function description for details.
- *   @param idxTask
- * The index of the task the stack usage has to be investigated for. The index is the
- * same as used when initializing the tasks (see rtos_initializeTask).
- *   @remark
- * The computation is a linear search for the first non-pattern byte and thus relatively
- * expensive. It's suggested to call it only in some specific diagnosis compilation or
- * occasionally from the idle task.
- *   @see
- * void rtos_initializeTask()
+ * Get the number of lost items. The counter saturates at its implementation limit.
+ *   @param doReset
+ * If true, the counter is reset to null after reading.
  */
 
-uint16_t rtos_getStackReserve(uint8_t idxTask)
+uint8_t rtos_getNoLostDeferredWork(boolean doReset)
+{
+    const uint8_t sreg = SREG;
+    cli();
+    const uint8_t noLostDeferredWork = _noLostDeferredWork;
+    if(doReset)
+        _noLostDeferredWork = 0;
+    SREG = sreg;
+
+    return noLostDeferredWork;
+
+} /* End of rtos_getNoLostDeferredWork */
+#endif
+
+
+
+
+/**
+ * Initialize the elements of a single task object, which are used by the scheduler: The
+ * priority class and the start condition. This is the common part of rtos_initializeTask
+ * and initializeTaskList.
+ *   @param pT
+ * The task object to initialize.
+ *   @param prioClass
+ * See rtos_initializeTask.
+ *   @param timeRoundRobin
+ * See rtos_initializeTask.
+ *   @param timeDeadline
+ * See rtos_initializeTask.
+ *   @param startEventMask
+ * See rtos_initializeTask.
+ *   @param startByAllEvents
+ * See rtos_initializeTask.
+ *   @param startTimeout
+ * See rtos_initializeTask.
+ */
+
+static void initializeTask( task_t * const pT
+                          , uint8_t prioClass
+#if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON
+                          , uintTime_t timeRoundRobin
+#endif
+#if RTOS_USE_EDF_PRIO_CLASS == RTOS_FEATURE_ON
+                          , uintTime_t timeDeadline
+#endif
+                          , uintEventVec_t startEventMask
+                          , boolean startByAllEvents
+                          , uintTime_t startTimeout
+                          )
 {
-    uint8_t *sp = _taskAry[idxTask].pStackArea;
+    /* To which priority class does the task belong? */
+    pT->prioClass = prioClass;
 
-    /* The bottom of the stack is always initialized with 0, which must not be the pattern
-       byte. Therefore we don't need a limitation of the search loop - it'll always find a
-       non-pattern byte in the stack area. */
-    while(*sp == UNUSED_STACK_PATTERN)
-        ++ sp;
+    /* Set the start condition. */
+    ASSERT(startEventMask != 0);
+
+    /* Start condition "wait for sync object" is not implemented. */
+#if RTOS_USE_MUTEX == RTOS_FEATURE_ON  ||  RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
+    ASSERT((startEventMask & (MASK_EVT_IS_MUTEX | MASK_EVT_IS_SEMAPHORE)) == 0);
+#endif
 
-    return sp - _taskAry[idxTask].pStackArea;
+    pT->cntDelay = 0;
+    pT->timeDueAt = 0;
+#ifdef RTOS_SCHEDULE_TABLE
+    /* A time-triggered task is started by its first entry in the schedule table. Its start
+       condition is the resume condition of rtos_waitForNextScheduleSlot. (As ordinary
+       start condition, the absolute timer with timeout 0 would be an immediate overrun.) */
+    pT->isWaitingForScheduleSlot = startEventMask == RTOS_EVT_ABSOLUTE_TIMER
+                                   &&  !startByAllEvents
+                                   &&  startTimeout == 0;
+    ASSERT(!pT->isWaitingForScheduleSlot  ||  isTaskInScheduleTable(pT));
+#endif
+    storeResumeCondition(pT, startEventMask, startByAllEvents, startTimeout);
 
-} /* End of rtos_getStackReserve */
+#if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON
+    /* The maximum execution time in round robin mode. */
+    pT->timeRoundRobin = timeRoundRobin;
+
+# if RTOS_USE_EDF_PRIO_CLASS == RTOS_FEATURE_ON
+    /* Round robin would destroy the deadline ordered list of due tasks of the EDF class. */
+    ASSERT(prioClass != RTOS_EDF_PRIO_CLASS  ||  timeRoundRobin == 0);
+# endif
+#endif
+
+#if RTOS_USE_EDF_PRIO_CLASS == RTOS_FEATURE_ON
+    /* The relative deadline, which determines the order of due tasks in the EDF class. */
+    pT->timeDeadline = timeDeadline;
+    pT->timeDeadlineAt = 0;
+#elif RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_ON
+    /* The deadline is set later by rtos_setTaskDeadline. */
+    pT->timeDeadline = 0;
+    pT->timeDeadlineAt = 0;
+#endif
+#if RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_ON
+    pT->isDeadlineArmed = false;
+    pT->cntDeadlineMiss = 0;
+#endif
 
+} /* End of initializeTask */
 
 
 
+
+#ifndef RTOS_TASK_LIST
 /**
  * Initialize the contents of a single task object.\n
  *   This routine needs to be called from within setup() once for each task. The number of
  * tasks has been defined by the application using #RTOS_NO_TASKS but the array of this
  * number of task objects is still empty. The system will crash if this routine is not
  * called properly for each of the tasks before the RTOS actually starts.\n
- *   This function must never be called outside of setup(). A crash would result otherwise.
+ *   This function must never be called outside of setup(). A crash would result otherwise.\n
+ *   This function is not available if the application declares its tasks in
+ * #RTOS_TASK_LIST; the tasks are initialized from the list before setup() is invoked.
  *   @param idxTask
  * The index of the task in the range 0..RTOS_NO_TASKS-1. The order of tasks barely
  * matters.
@@ -1860,6 +4917,16 @@ uint16_t rtos_getStackReserve(uint8_t idxTask)
  * task.\n
  *   This parameter is available only if #RTOS_ROUND_ROBIN_MODE_SUPPORTED is set to
  * #RTOS_FEATURE_ON.
+ *   @param timeDeadline
+ * The relative deadline of the task in system timer tics. It is meaningful only if the task
+ * belongs to the priority class #RTOS_EDF_PRIO_CLASS: Each time the task becomes due its
+ * absolute deadline is set to the time it became due plus this value. The due tasks of the
+ * class are activated in the order of their absolute deadlines. For a regular task, the
+ * deadline is typically its period time.\n
+ *   If #RTOS_USE_DEADLINE_MONITOR is on, then the deadline of a task of any priority class
+ * is monitored, see \a rtos_setTaskDeadline. Pass null for a task without deadline.\n
+ *   This parameter is available only if #RTOS_USE_EDF_PRIO_CLASS is set to
+ * #RTOS_FEATURE_ON.
  *   @param pStackArea
  * The pointer to the preallocated stack area of the task. The area needs to be
  * available all the RTOS runtime. Therefore dynamic allocation won't pay off. Consider
@@ -1889,7 +4956,7 @@ uint16_t rtos_getStackReserve(uint8_t idxTask)
  * the task will not be activated by a time condition. Do not set both timer events at
  * once! See rtos_waitForEvent for details.
  *   @see void rtos_initRTOS(void)
- *   @see uint16_t rtos_waitForEvent(uint16_t, boolean, uintTime_t)
+ *   @see uintEventVec_t rtos_waitForEvent(uintEventVec_t, boolean, uintTime_t)
  *   @remark
  * The restriction that the initial resume condition must not comprise the request for mutex
  * or semaphore kind of events has been made just for simplicity. No additional code is
@@ -1906,10 +4973,13 @@ void rtos_initializeTask( uint8_t idxTask
                         , uint8_t prioClass
 #if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON
                         , uintTime_t timeRoundRobin
+#endif
+#if RTOS_USE_EDF_PRIO_CLASS == RTOS_FEATURE_ON
+                        , uintTime_t timeDeadline
 #endif
                         , uint8_t * const pStackArea
                         , uint16_t stackSize
-                        , uint16_t startEventMask
+                        , uintEventVec_t startEventMask
                         , boolean startByAllEvents
                         , uintTime_t startTimeout
                         )
@@ -1921,27 +4991,121 @@ void rtos_initializeTask( uint8_t idxTask
     pT->pStackArea   = pStackArea;
     pT->stackSize    = stackSize;
 
-    /* To which priority class does the task belong? */
-    pT->prioClass = prioClass;
+    initializeTask( pT
+                  , prioClass
+#if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON
+                  , timeRoundRobin
+#endif
+#if RTOS_USE_EDF_PRIO_CLASS == RTOS_FEATURE_ON
+                  , timeDeadline
+#endif
+                  , startEventMask
+                  , startByAllEvents
+                  , startTimeout
+                  );
 
-    /* Set the start condition. */
-    ASSERT(startEventMask != 0);
+} /* End of rtos_initializeTask */
+#endif
 
-    /* Start condition "wait for sync object" is not implemented. */
-#if RTOS_USE_MUTEX == RTOS_FEATURE_ON  ||  RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
-    ASSERT((startEventMask & (MASK_EVT_IS_MUTEX | MASK_EVT_IS_SEMAPHORE)) == 0);
+
+
+
+#ifdef RTOS_TASK_LIST
+/**
+ * Initialize all task objects from the table of tasks, which has been generated from
+ * #RTOS_TASK_LIST. The table entries are read from flash ROM one by one. Only the data,
+ * which is used by the scheduler, is copied into the task objects.
+ *   @remark
+ * The table is copied entry by entry with memcpy_P into a local variable. This costs a
+ * few microseconds per task once at startup, in exchange the invariant data of a task
+ * needs no RAM. A table in RAM would be initialized by the C startup code in about the
+ * same time.
+ */
+
+static void initializeTaskList(void)
+{
+    uint8_t idxTask;
+#ifdef DEBUG
+    /* The number of tasks per priority class can't be checked at compile time. */
+    uint8_t noTasksInClassAry[RTOS_NO_PRIO_CLASSES];
+    memset( /* dest */ noTasksInClassAry
+          , /* val */ 0x00
+          , /* len */ sizeof(noTasksInClassAry)
+          );
 #endif
 
-    pT->cntDelay = 0;
-    pT->timeDueAt = 0;
-    storeResumeCondition(pT, startEventMask, startByAllEvents, startTimeout);
+    for(idxTask=0; idxTask<RTOS_NO_TASKS; ++idxTask)
+    {
+        taskListEntry_t entry;
+        memcpy_P(&entry, &_taskListAry[idxTask], sizeof(entry));
 
+#ifdef DEBUG
+        ++ noTasksInClassAry[entry.prioClass];
+        ASSERT(noTasksInClassAry[entry.prioClass] <= RTOS_MAX_NO_TASKS_IN_PRIO_CLASS);
+#endif
+        initializeTask( &_taskAry[idxTask]
+                      , entry.prioClass
 #if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON
-    /* The maximum execution time in round robin mode. */
-    pT->timeRoundRobin = timeRoundRobin;
+                      , entry.timeRoundRobin
+#endif
+#if RTOS_USE_EDF_PRIO_CLASS == RTOS_FEATURE_ON
+                      , entry.timeDeadline
+#endif
+                      , entry.startEventMask
+                      , entry.startByAllEvents
+                      , entry.startTimeout
+                      );
+    }
+} /* End of initializeTaskList */
 #endif
 
-} /* End of rtos_initializeTask */
+
+
+
+#if RTOS_LAZY_STACK_PAINTING == RTOS_FEATURE_ON
+/**
+ * Fill the next few bytes of a task stack with the pattern byte, which is required by the
+ * stack usage functions. The function is called by the idle task in each cycle, before
+ * loop() is invoked, until the stack areas of all tasks are filled. The stacks are filled
+ * one after another, from the end of the stack area towards the stack pointer.\n
+ *   Only the bytes below the current stack pointer of the task are written. The task is not
+ * running while the idle task is active, its stack pointer is the one, which had been
+ * saved when the task was left. The bytes are written with globally disabled interrupts;
+ * otherwise the task could resume and push data into the range, which is just being
+ * filled.
+ */
+
+static void paintTaskStack(void)
+{
+    task_t * const pT = &_taskAry[_idxTaskStackPaint];
+    uint8_t * const pStackArea = GET_STACK_AREA(_idxTaskStackPaint);
+    uint16_t offs = _offsStackPaint;
+    uint8_t noBytes = STACK_PAINTING_CHUNK_SIZE;
+
+    cli();
+
+    /* The stack pointer points to the next free byte, it may be overwritten, too. */
+    const uint16_t offsStackPointer = pT->stackPointer - (uint16_t)pStackArea;
+    while(noBytes-- > 0  &&  offs <= offsStackPointer)
+        pStackArea[offs++] = UNUSED_STACK_PATTERN;
+
+    if(offs > offsStackPointer)
+    {
+#if RTOS_INCREMENTAL_STACK_SCAN == RTOS_FEATURE_ON
+        /* The stack usage monitor will never inspect any byte above the filled range. */
+        pT->stackReserve = offs;
+#endif
+        /* Continue with next task in the next cycle. */
+        _offsStackPaint = 0;
+        ++ _idxTaskStackPaint;
+    }
+    else
+        _offsStackPaint = offs;
+
+    sei();
+
+} /* End of paintTaskStack */
+#endif
 
 
 
@@ -1995,6 +5159,11 @@ void rtos_initRTOS(void)
     memset(/* dest */ _taskAry, /* val */ 0x00, /* len */ sizeof(_taskAry));
 #endif
 
+#ifdef RTOS_TASK_LIST
+    /* The tasks are configured at compile time. */
+    initializeTaskList();
+#endif
+
     /* Give the application the chance to do all its initialization - regardless of RTOS
        related or whatever else. After return, the task array needs to be properly
        filled. */
@@ -2004,16 +5173,37 @@ void rtos_initRTOS(void)
     for(idxTask=0; idxTask<RTOS_NO_TASKS; ++idxTask)
     {
         pT = &_taskAry[idxTask];
+        uint8_t * const pStackArea = GET_STACK_AREA(idxTask);
+        const uint16_t stackSize = GET_STACK_SIZE(idxTask);
 
         /* Anticipate typical application errors with respect to the initialization of task
            objects. */
-        ASSERT(pT->taskFunction != NULL  &&  pT->pStackArea != NULL  &&  pT->stackSize >= 50);
+        ASSERT(GET_TASK_FUNCTION(idxTask) != NULL  &&  pStackArea != NULL
+               &&  stackSize >= MIN_STACK_SIZE
+              );
+
+#if defined(RTOS_TASK_LIST)  &&  RTOS_CHECK_STACK_GUARD == RTOS_FEATURE_ON
+        /* The stack guard is checked in every context switch; a copy of the stack area is
+           held in RAM. */
+        pT->pStackArea = pStackArea;
+#endif
 
         /* Prepare the stack of the task and store the initial stack pointer value. */
-        pT->stackPointer = (uint16_t)prepareTaskStack( pT->pStackArea
-                                                     , pT->stackSize
-                                                     , pT->taskFunction
+        pT->stackPointer = (uint16_t)prepareTaskStack( pStackArea
+                                                     , stackSize
+                                                     , GET_TASK_FUNCTION(idxTask)
                                                      );
+#if RTOS_LAZY_STACK_PAINTING == RTOS_FEATURE_OFF
+        /* The rest of the stack area doesn't matter. Nonetheless, we fill it with a
+           specific pattern, which will permit to run a (a bit guessing) stack usage
+           routine later on: We can look up to where the pattern has been destroyed. */
+        memset( /* dest */ pStackArea
+              , /* val */ UNUSED_STACK_PATTERN
+              , /* len */ pT->stackPointer - (uint16_t)pStackArea + 1
+              );
+#else
+        /* The pattern is written later by the idle task, see paintTaskStack. */
+#endif
 #ifdef DEBUG
 # if false
         {
@@ -2023,17 +5213,17 @@ void rtos_initRTOS(void)
             Serial.print(idxTask);
             Serial.print(":\nStack pointer: 0x");
             Serial.println(pT->stackPointer, HEX);
-            for(u=0; u<pT->stackSize; ++u)
+            for(u=0; u<stackSize; ++u)
             {
                 if(u%8 == 0)
                 {
                     Serial.println("");
                     Serial.print(u, HEX);
                     Serial.print(", 0x");
-                    Serial.print((uint16_t)(pT->pStackArea+u), HEX);
+                    Serial.print((uint16_t)(pStackArea+u), HEX);
                     Serial.print(":\t");
                 }
-                Serial.print(pT->pStackArea[u], HEX);
+                Serial.print(pStackArea[u], HEX);
                 Serial.print("\t");
             }
             Serial.println("");
@@ -2052,6 +5242,39 @@ void rtos_initRTOS(void)
         /* Initialize overrun counter. */
         pT->cntOverrun = 0;
 
+#if RTOS_INCREMENTAL_STACK_SCAN == RTOS_FEATURE_ON
+        /* All bytes below the initial context are still unused. The stack usage monitor
+           will never inspect any byte above this limit. */
+        pT->stackReserve = pT->stackPointer - (uint16_t)pStackArea + 1;
+#endif
+
+#if RTOS_COUNTED_EVENT_MASK != 0
+        /* No counted event has been seen yet. The global counters are initialized by the
+           C runtime. */
+        memset( /* dest */ pT->cntSeenEventAry
+              , /* val */ 0x00
+              , /* len */ sizeof(pT->cntSeenEventAry)
+              );
+#endif
+
+#if RTOS_USE_EVENT_DATA == RTOS_FEATURE_ON
+        /* The mailbox is empty. */
+        pT->eventData = 0;
+#endif
+
+#if RTOS_USE_TASK_CONTROL == RTOS_FEATURE_ON
+        /* All tasks take part in the scheduling. */
+        pT->haltState = TASK_NOT_HALTED;
+#endif
+
+#if RTOS_USE_TASK_STATISTICS == RTOS_FEATURE_ON
+        /* No time span has been measured yet. */
+        pT->statState = STAT_STATE_IDLE;
+        resetTimeSpanStatistics(&_taskStatisticsAry[idxTask].releaseJitter);
+        resetTimeSpanStatistics(&_taskStatisticsAry[idxTask].startLatency);
+        resetTimeSpanStatistics(&_taskStatisticsAry[idxTask].responseTime);
+#endif
+
         /* Any task is suspended at the beginning. No task is active, see before. If
            mutexes or semaphores are in use this list is sorted with decreasing priority. */
 #if RTOS_USE_MUTEX == RTOS_FEATURE_OFF
@@ -2100,19 +5323,38 @@ void rtos_initRTOS(void)
     _pActiveTask    = _pIdleTask;
     _pSuspendedTask = _pIdleTask;
 
+#if RTOS_PROVIDE_ARDUINO_TIME == RTOS_FEATURE_ON
+    /* All data is prepared. Let's start the IRQ which clocks the system time.
+         RTuinOS takes over the Arduino time functions. The substitutes read the counter of
+       the system timer, so they must not be enabled before the timer has been started and
+       its counter has been reset. The interrupt of timer 0 is no longer needed; timer 0 is
+       free for other use by the application. The time continues with the values reached
+       so far. */
+    cli();
+    rtos_enableIRQTimerTic();
+    TIMSK0 &= ~_BV(TOIE0);
+    _microsAtTic = __real_micros();
+    _millisAtTic = __real_millis();
+    _fractMillisAtTic = 0;
+    _isArduinoTimeProvided = true;
+    sei();
+#else
     /* All data is prepared. Let's start the IRQ which clocks the system time. */
     rtos_enableIRQTimerTic();
+#endif
 
     /* Call the application to let it configure its interrupt sources. */
-#if RTOS_USE_APPL_INTERRUPT_00 == RTOS_FEATURE_ON
-    rtos_enableIRQUser00();
-#endif
-#if RTOS_USE_APPL_INTERRUPT_01 == RTOS_FEATURE_ON
-    rtos_enableIRQUser01();
-#endif
+    ALL_APPL_INTERRUPTS(CALL_ENABLE_FCT, CALL_ENABLE_FCT)
 
     /* From here, all further code implicitly becomes the idle task. */
     while(true)
+    {
+#if RTOS_LAZY_STACK_PAINTING == RTOS_FEATURE_ON
+        /* The stack areas are filled with the pattern byte, a few bytes per cycle. */
+        if(_idxTaskStackPaint < RTOS_NO_TASKS)
+            paintTaskStack();
+#endif
         loop();
+    }
 
 } /* End of rtos_initRTOS */
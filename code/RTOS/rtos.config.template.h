@@ -5,7 +5,10 @@
  * Switches to define the most relevant compile-time settings of RTuinOS in an application
  * specific way.
  * @todo Copy this file to your application code, rename it to rtos.config.h and adjust the
- * settings to the need of your RTuinOS application. Then remove this hint.
+ * settings to the need of your RTuinOS application. Then remove this hint.\n
+ *   The switches, which have been added after the first release of RTuinOS, are optional.
+ * rtos.h sets them to the default values shown here if your rtos.config.h doesn't define
+ * them; it's sufficient to copy those, which you want to change, see e.g. test case tc25.
  *
  * Copyright (C) 2012-2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
  *
@@ -38,12 +41,85 @@
 #define RTOS_ROUND_ROBIN_MODE_SUPPORTED     RTOS_FEATURE_OFF
 
 
+/** Does the task scheduling concept support a priority class with earliest deadline first
+    scheduling? If on, the due tasks of priority class #RTOS_EDF_PRIO_CLASS are not
+    ordered by the time they became due but by their absolute deadline. The absolute
+    deadline is the time at which the task became due plus the relative deadline, which is
+    configured for each task in \a rtos_initializeTask. All other priority classes are
+    scheduled as usual; a due task of a higher class still preempts any task of the EDF
+    class and vice versa.\n
+      The tasks of the EDF class must not be operated in round robin mode.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_USE_EDF_PRIO_CLASS             RTOS_FEATURE_OFF
+
+/** The priority class, which is scheduled earliest deadline first if
+    #RTOS_USE_EDF_PRIO_CLASS is on. Permitted range is 0..RTOS_NO_PRIO_CLASSES-1. */
+#define RTOS_EDF_PRIO_CLASS                 0
+
+
 /** Number of tasks in the system. Tasks aren't created dynamically. This number of tasks
     will always be existent and alive. Permitted range is 0..127.\n
       A runtime check is not done. The code will crash in case of a bad setting. */
 #define RTOS_NO_TASKS   5
 
 
+/** Alternatively to calling rtos_initializeTask in setup(), the tasks can be declared in
+    a list. The macro expands to a list of entries, which are not separated by commas. An
+    entry is RTOS_TASK(taskFunction, prioClass, timeRoundRobin, timeDeadline, stackSize,
+    startEventMask, startByAllEvents, startTimeout). The arguments have the meaning of the
+    same named parameters of rtos_initializeTask; timeRoundRobin and timeDeadline are
+    ignored if the related feature is not configured.\n
+      The stack areas and a constant table of the tasks in flash ROM are generated from the
+    list; rtos_initRTOS copies the table entry by entry from flash ROM and initializes the
+    tasks before it calls setup(). The task functions must not be static, they are declared
+    by rtos.h. The tasks are numbered in the order of the list, and
+    rtos_idxTask_<taskFunction> is the index of a task.\n
+      #RTOS_NO_TASKS is derived from the list and should not be defined. The priority
+    classes, the stack sizes and the start conditions are validated at compile time: An
+    error "size of array is negative" is reported for a bad entry and the name of the array
+    says what's wrong with which task. The number of tasks per priority class is checked
+    in DEBUG compilation at runtime only.\n
+      Example:\n
+      #define RTOS_TASK_LIST(RTOS_TASK)                                                 \\\n
+          RTOS_TASK(taskCtrl, 1, 0, 0, 200, RTOS_EVT_DELAY_TIMER, false, 0)             \\\n
+          RTOS_TASK(taskComm, 0, 0, 0, 256, EVT_RX_DATA, false, 0) */
+/* #define RTOS_TASK_LIST(RTOS_TASK) */
+
+
+/** Strictly periodic tasks with fixed phase relations can be released by a schedule table
+    rather than by \a rtos_suspendTaskTillTime. The table is cyclically processed with
+    the period #RTOS_SCHEDULE_HYPERPERIOD; it is a list of entries
+    RTOS_SCHEDULE_ENTRY(offset, idxTask), which are not separated by commas. At system
+    time tic \a offset of each hyperperiod, the task with index \a idxTask is released.
+    The first hyperperiod begins with the first system timer tic. A task may have several
+    entries.\n
+      The entries need to be sorted by ascending offset. The order, the offsets and the
+    task indexes are validated at compile time. The table is held in flash ROM, the system
+    timer interrupt compares only the next entry with the phase in each tic.\n
+      A time-triggered task waits for its next entry with \a rtos_waitForNextScheduleSlot.
+    Its first entry is awaited with the start condition startEventMask
+    #RTOS_EVT_ABSOLUTE_TIMER, startByAllEvents false and startTimeout 0. At runtime, only
+    \a rtos_waitForNextScheduleSlot waits for the schedule table, \a
+    rtos_suspendTaskTillTime(0) is an ordinary wait for a passed due time. If a task is
+    still busy when its next entry is reached, then the release is skipped and counted as
+    task overrun.\n
+      The feature costs one Byte of RAM per task plus three Byte.\n
+      Example:\n
+      #define RTOS_SCHEDULE_HYPERPERIOD 20\n
+      #define RTOS_SCHEDULE_TABLE(RTOS_SCHEDULE_ENTRY)                                  \\\n
+          RTOS_SCHEDULE_ENTRY(0, rtos_idxTask_taskCtrl)                                 \\\n
+          RTOS_SCHEDULE_ENTRY(5, rtos_idxTask_taskComm)                                 \\\n
+          RTOS_SCHEDULE_ENTRY(10, rtos_idxTask_taskCtrl) */
+/* #define RTOS_SCHEDULE_TABLE(RTOS_SCHEDULE_ENTRY) */
+
+
+/** The length of the cycle of #RTOS_SCHEDULE_TABLE in system timer tics. Range is
+    1..min(65535, max_value(uintTime_t)): The time between two releases of a task must not
+    exceed the cycle time of the system time. Only used if the schedule table is
+    defined. */
+#define RTOS_SCHEDULE_HYPERPERIOD   1
+
+
 /** Number of distinct priorities of tasks. Since several tasks may share the same
     priority, this number is lower or equal to NO_TASKS. Permitted range is 0..NO_TASKS,
     but 1..NO_TASKS if at least one task is defined.\n
@@ -93,6 +169,48 @@
 #define RTOS_NO_MUTEX_EVENTS    0
 
 
+/** The ordinary events of the application can be named in a list. The macro expands to a
+    list of entries RTOS_EVENT(name), which are not separated by commas. Each name becomes
+    an enumeration, whose value is the event; the events are allocated in the order of the
+    list, starting with the first event, which is neither a semaphore nor a mutex. A compile
+    time error is reported if the listed events collide with the events of the application
+    interrupts 00 and 01 or with the timer events.\n
+      Example: #define RTOS_EVENT_LIST(RTOS_EVENT) RTOS_EVENT(EVT_RX_DATA) */
+#define RTOS_EVENT_LIST(RTOS_EVENT)
+
+
+/** Use the built-in driver for a high resolution system timer. If on, one of the 16 Bit
+    timers is operated in CTC mode with a period time, which is configured at compile time.
+    The interrupt vector #RTOS_ISR_SYSTEM_TIMER_TIC, the tic period #RTOS_TIC and the
+    implementation of the critical section are derived from these settings. If off, the
+    overflow interrupt of timer 2 is used as in the standard configuration of RTuinOS,
+    which results in a tic period of about 2 ms.\n
+      The PWM outputs of the selected timer can't be used by the application.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_USE_CTC_SYSTEM_TIMER   RTOS_FEATURE_OFF
+
+/** The 16 Bit timer, which clocks the system time if #RTOS_USE_CTC_SYSTEM_TIMER is on.
+    Select 1, 3, 4 or 5. */
+#define RTOS_CTC_TIMER              4
+
+/** The period time of the system timer tic in us if #RTOS_USE_CTC_SYSTEM_TIMER is on. The
+    prescaler of the timer is chosen at compile time such that the best possible resolution
+    is achieved. With a CPU clock of 16 MHz the period can be set with a resolution of
+    62.5 ns up to 4 ms and it may range up to 4 s. */
+#define RTOS_CTC_TIC_PERIOD_US      500
+
+/** If on, RTuinOS takes over the Arduino time functions millis(), micros() and delay().
+    They are derived from the system timer and the overflow interrupt of timer 0 is
+    disabled when RTuinOS starts. Timer 0 and its PWM outputs become available to the
+    application and the CPU load of the timer 0 interrupt vanishes.\n
+      This switch requires the built-in CTC system timer with a tic period, which is an
+    exact multiple of a microsecond. Furthermore, the linker needs to redirect the library
+    functions: Set WRAP_ARDUINO_TIME = 1 in the makefile fragment of the application,
+    <applicationName>.mk.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_PROVIDE_ARDUINO_TIME   RTOS_FEATURE_OFF
+
+
 /** Select the interrupt which clocks the system time. Side effects to consider: This
     interrupt (like all others which possibly result in a context switch) need to be
     inhibited by rtos_enterCriticalSection.\n
@@ -103,16 +221,26 @@
       If an application redefines the interrupt source, the new source will probably
     produce another system clock frequency. If so, the macro #RTOS_TIC needs to be redefined
     also. */
-#define RTOS_ISR_SYSTEM_TIMER_TIC TIMER2_OVF_vect
+#if RTOS_USE_CTC_SYSTEM_TIMER == RTOS_FEATURE_ON
+# define RTOS_ISR_SYSTEM_TIMER_TIC RTOS_CTC_ISR_VECTOR
+#else
+# define RTOS_ISR_SYSTEM_TIMER_TIC TIMER2_OVF_vect
+#endif
 
 
 /** The system timer tic is about 2 ms. For more accurate considerations, it is defined here as
-    floating point constant. The unit is s. */
-#define RTOS_TIC (2.04e-3)
+    floating point constant. The unit is s.\n
+      If the built-in CTC system timer is used then the exact period time is computed from
+    the CPU clock frequency and the configuration of the timer. */
+#if RTOS_USE_CTC_SYSTEM_TIMER == RTOS_FEATURE_ON
+# define RTOS_TIC RTOS_CTC_TIC
+#else
+# define RTOS_TIC (2.04e-3)
+#endif
 
 
 /** Enable the application defined interrupt 0. (Two such interrupts are pre-configured in
-    the code and more can be implemented by taking these two as a code template.)\n
+    the code and more can be configured by #RTOS_APPL_INTERRUPT_LIST.)\n
       To install an application interrupt, this define is set to #RTOS_FEATURE_ON.\n
       Secondary, you will define #RTOS_ISR_USER_00 in order to specify the interrupt
     source.\n
@@ -138,6 +266,30 @@
 #define RTOS_ISR_USER_01    xxx_vect
 
 
+/** Any number of further application interrupts, which post an event each time they
+    occur. The macro expands to a list of entries, which are not separated by commas. An
+    entry is either RTOS_ISR_TO_EVENT(vector, eventVec, enableFct) or
+    RTOS_ISR_TO_TOP_HALF(vector, topHalfFct, enableFct):\n
+      vector is the name of the interrupt vector, see #RTOS_ISR_USER_00.\n
+      eventVec is the vector of events, which is posted by the interrupt. Typically, this
+    is a single general purpose event RTOS_EVT_EVENT_nn; the timer events can't be posted.\n
+      topHalfFct is the name of an application supplied function uintEventVec_t
+    topHalfFct(void), which is executed by the interrupt with globally disabled interrupts.
+    It can e.g. read the hardware and post a work item, see #RTOS_USE_DEFERRED_WORK. It
+    returns the vector of events to post, which may be null.\n
+      enableFct is the name of an application supplied callback void enableFct(void),
+    which enables the interrupt source, see \a rtos_enableIRQUser00.\n
+      Example:\n
+      #define RTOS_APPL_INTERRUPT_LIST(RTOS_ISR_TO_EVENT, RTOS_ISR_TO_TOP_HALF)        \\\n
+          RTOS_ISR_TO_EVENT(USART1_RX_vect, RTOS_EVT_EVENT_05, enableIRQUart1)          \\\n
+          RTOS_ISR_TO_TOP_HALF(PCINT0_vect, onPinChange, enableIRQPinChange)\n
+      All application interrupts share the kernel code, which posts the event; each
+    further interrupt costs a few bytes of flash ROM only. An interrupt, which doesn't
+    resume a task of higher priority than the interrupted one, returns without saving the
+    complete CPU context. */
+#define RTOS_APPL_INTERRUPT_LIST(RTOS_ISR_TO_EVENT, RTOS_ISR_TO_TOP_HALF)
+
+
 /** A macro which expands to the code which defines all types which are related to the
     system timer. We need the unsigned and the related signed type. The macro is applied
     just once, see below and #RTOS_DEFINE_TYPE_OF_SYSTEM_TIME_DOXYGEN_TAG. */
@@ -181,14 +333,25 @@
  *   @see #RTOS_ISR_SYSTEM_TIMER_TIC
  *   @see #RTOS_USE_APPL_INTERRUPT_00
  *   @see #RTOS_USE_APPL_INTERRUPT_01
+ *   @see #RTOS_APPL_INTERRUPT_LIST
  */
-# define rtos_enterCriticalSection()                                        \
+# if RTOS_USE_CTC_SYSTEM_TIMER == RTOS_FEATURE_ON
+#  define rtos_enterCriticalSection()                                       \
+{                                                                           \
+    cli();                                                                  \
+    RTOS_CTC_TIMSK &= ~_BV(RTOS_CTC_OCIEA);                                 \
+    sei();                                                                  \
+                                                                            \
+} /* End of macro rtos_enterCriticalSection */
+# else
+#  define rtos_enterCriticalSection()                                       \
 {                                                                           \
     cli();                                                                  \
     TIMSK2 &= ~_BV(TOIE2);                                                  \
     sei();                                                                  \
                                                                             \
 } /* End of macro rtos_enterCriticalSection */
+# endif
 #else
 # error Modification of code for other AVR CPU required
 #endif
@@ -202,11 +365,19 @@
  * This macro is the counterpart of #rtos_enterCriticalSection. Please refer to
  * #rtos_enterCriticalSection for deatils.
  */
-# define rtos_leaveCriticalSection()                                        \
+# if RTOS_USE_CTC_SYSTEM_TIMER == RTOS_FEATURE_ON
+#  define rtos_leaveCriticalSection()                                       \
+{                                                                           \
+    RTOS_CTC_TIMSK |= _BV(RTOS_CTC_OCIEA);                                  \
+                                                                            \
+} /* End of macro rtos_leaveCriticalSection */
+# else
+#  define rtos_leaveCriticalSection()                                       \
 {                                                                           \
     TIMSK2 |= _BV(TOIE2);                                                   \
                                                                             \
 } /* End of macro rtos_leaveCriticalSection */
+# endif
 #else
 # error Modifcation of code for other AVR CPU required
 #endif
@@ -292,6 +463,188 @@ RTOS_DEFINE_TYPE_OF_SYSTEM_TIME(8)
 #define RTOS_OVERRUN_TASK_IS_IMMEDIATELY_DUE  RTOS_FEATURE_ON
 
 
+/** Check the stack of a task at each context switch. If the feature is on, the stack
+    pointer, which is saved when a task is left, is compared against a guard zone at the
+    end of the task's stack area. If it points into the guard zone the callback \a
+    rtos_onStackGuardViolation is invoked. This happens in the interrupt context of the
+    context switch and before the stack area is actually exceeded - as long as the guard
+    zone is large enough.\n
+      The overhead is a single comparison per context switch.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_CHECK_STACK_GUARD  RTOS_FEATURE_OFF
+
+/** The size in Byte of the guard zone at the end of each task's stack area, which is
+    checked if #RTOS_CHECK_STACK_GUARD is on. Consider that an interrupt, which occurs
+    while a task is running, consumes up to 36 Byte of the task's stack. */
+#define RTOS_STACK_GUARD_SIZE   16
+
+
+/** Enable the incremental stack usage monitor. The idle task may regularly call \a
+    rtos_scanStackReserve, which examines a few bytes of the task stacks per call. The
+    result is cached and can be queried at any time and at negligible cost with \a
+    rtos_getCachedStackReserve.\n
+      The feature costs two Byte of RAM per task.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_INCREMENTAL_STACK_SCAN RTOS_FEATURE_OFF
+
+
+/** The stack usage functions require the stack areas to be filled with a pattern byte.
+    Normally, this is done in \a rtos_initRTOS before the first task is started. With
+    several kByte of task stacks this delays the start of the application by a few
+    milliseconds. If the feature is on, the stacks are not filled at startup but by the
+    idle task, a few bytes in each cycle, before it calls loop(). Until the stack area of a
+    task is completely filled, \a rtos_getStackReserve and \a rtos_getCachedStackReserve
+    return #RTOS_STACK_RESERVE_UNKNOWN for this task.\n
+      The stack reserve reported later relates to the time after the stack area has been
+    filled; deeper stack usage before is not recognized: The idle task can fill only the
+    bytes below the stack pointer, which the task had saved when it was left the last
+    time. If a task has already run, e.g. through its initialization code, and had used
+    more stack than at the time of painting, then the reported reserve overstates the true
+    margin. Stack sizes should therefore be dimensioned with the feature off. Applications,
+    whose loop() never returns, will never see a stack reserve.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_LAZY_STACK_PAINTING RTOS_FEATURE_OFF
+
+
+/** Enable the deferred work queue. An interrupt service routine, which has non-trivial
+    processing to do, only reads its hardware and posts a work item, i.e. a function
+    pointer plus argument, with \a rtos_postDeferredWork. The items are executed in order
+    of posting by a single worker task, \a rtos_deferredWorkTask, which is created by the
+    application, typically in the highest priority class. All interrupt sources share the
+    stack of the worker task and the time spent with globally disabled interrupts is
+    reduced to the posting of the item.\n
+      The ISR is best implemented as top half of an application interrupt, see
+    #RTOS_APPL_INTERRUPT_LIST. It returns #RTOS_EVT_DEFERRED_WORK to wake the worker.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_USE_DEFERRED_WORK  RTOS_FEATURE_OFF
+
+/** The maximum number of pending work items. The value needs to be a power of two. The
+    queue occupies four Byte of RAM per item. */
+#define RTOS_DEFERRED_WORK_QUEUE_SIZE   8
+
+/** The event, which wakes the worker task if #RTOS_USE_DEFERRED_WORK is on. It needs to
+    be an ordinary event, which is not used otherwise. */
+#define RTOS_EVT_DEFERRED_WORK  RTOS_EVT_EVENT_04
+
+
+/** Enable the event data mailbox. Each task gets a 16 Bit mailbox word. A task posts
+    events together with a data word by \a rtos_sendEventWithData; the word is written
+    into the mailbox of each suspended task, which receives at least one of the events, in
+    the same atomic operation, which posts the events. The receiving task gets the word
+    together with the resuming events from \a rtos_waitForEventWithData. The top half of an
+    application interrupt passes a word with \a rtos_setEventDataFromISR. Simple
+    producer/consumer pairs don't need a global variable and a critical section to pass the
+    data.\n
+      The feature costs two Byte of RAM per task.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_USE_EVENT_DATA     RTOS_FEATURE_OFF
+
+
+/** The set of counted events. An event is normally a single Bit in the vector of posted
+    events of a task. If it is posted twice before the receiving task has processed it, one
+    occurrence is lost. For the events in this mask, the kernel additionally counts each
+    post. A task queries the number of posts since its previous query - not since its
+    last wake-up - with \a rtos_getNoPostedEvents and can e.g. batch-process all
+    interrupts of a burst in one activation.\n
+      Only ordinary events can be counted, no mutexes, semaphores or timer events. The
+    counters have eight Bit: A task needs to query at least every 255 posts.\n
+      The feature costs one Byte of RAM per counted event and task plus one Byte per
+    counted event. Set the mask to null to disable the feature.\n
+      Example: #define RTOS_COUNTED_EVENT_MASK (RTOS_EVT_ISR_USER_00) */
+#define RTOS_COUNTED_EVENT_MASK 0
+
+
+/** The width of the event vectors in Bit, either 16 or 32. With 16 Bit, there are 14
+    events, which are shared between semaphores, mutexes, ordinary events and the
+    application interrupts 00 and 01. With 32 Bit, there are 30 such events, which are
+    named in the same way, e.g. RTOS_EVT_EVENT(20) or #RTOS_EVT_MUTEX_20. The two timer
+    events and the events of the application interrupts 00 and 01 are always the highest
+    ones.\n
+      The task functions, the top halves of application interrupts and the variables, which
+    hold event vectors in the application code, should use the type uintEventVec_t.\n
+      A 32 Bit event vector costs four more Byte of RAM per task and some additional CPU
+    load in every kernel operation. The 16 Bit kernel is not affected by the choice. */
+#define RTOS_EVENT_VECTOR_WIDTH 16
+
+
+/** Enable the function \a rtos_setTaskPriority, which changes the priority class of a task
+    at runtime.\n
+      The feature doesn't cost RAM.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_USE_SET_TASK_PRIORITY  RTOS_FEATURE_OFF
+
+
+/** Enable the task control functions \a rtos_suspendTask, \a rtos_resumeTask and \a
+    rtos_restartTask. A supervising task can take another task out of scheduling, let it
+    continue later or restart it at the entry of its task function. A task taken out of
+    scheduling is called halted - in distinction to a task, which is suspended because it
+    waits for events: It doesn't receive events and its timers don't elapse.\n
+      The feature costs one Byte of RAM per task.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_USE_TASK_CONTROL   RTOS_FEATURE_OFF
+
+
+/** Enable per-task overrun policies. A regular task, which recognizes an overrun in \a
+    rtos_suspendTaskTillTime, can be made to catch up with the missed activations, to skip
+    them or to keep the default reaction of #RTOS_OVERRUN_TASK_IS_IMMEDIATELY_DUE.
+    Additionally, a callback can be invoked or an event can be posted to a supervising
+    task. The policy is set with \a rtos_setTaskOverrunPolicy; it applies to overruns in
+    the schedule table, too, where the timing reaction is always to skip.\n
+      The feature costs one Byte of RAM per task plus one event vector.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_USE_OVERRUN_POLICY RTOS_FEATURE_OFF
+
+/** The event, which is posted on an overrun of a task with policy
+    #RTOS_OVERRUN_SEND_EVENT. It needs to be an ordinary event. It is posted by the system
+    timer interrupt to all suspended tasks, which wait for it. If no task waits for it, it
+    is kept pending until a task does. Set it to null if no task uses this policy. */
+#define RTOS_EVT_TASK_OVERRUN   0
+
+
+/** Enable the monitoring of task deadlines. A task can be given a relative deadline with
+    \a rtos_setTaskDeadline (or with \a rtos_initializeTask if #RTOS_USE_EDF_PRIO_CLASS is
+    on). Each time the task is made due, its absolute deadline is computed. If the task has
+    not suspended itself again when the deadline has passed, a deadline miss is counted,
+    see \a rtos_getTaskDeadlineMissCounter. Different to a task overrun, this recognizes a
+    late task even if it completes before its next period.\n
+      Without #RTOS_EVT_DEADLINE_MISS a miss is recognized when the late task suspends. The
+    feature costs two Byte and - if #RTOS_USE_EDF_PRIO_CLASS is off - two system time
+    words of RAM per task plus one event vector and one pointer.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_USE_DEADLINE_MONITOR   RTOS_FEATURE_OFF
+
+/** The event, which is posted on a deadline miss of any task. It needs to be an ordinary
+    event. If it is configured then the system timer interrupt enforces the deadlines: It
+    recognizes a miss in the first tic after the deadline, even if the late task doesn't
+    complete at all, and posts the event to all suspended tasks, which wait for it. If no
+    task waits for it, it is kept pending until a task does. Only the earliest deadline is
+    checked in each tic. The kernel looks for the next one, when the task with this
+    deadline suspends, is halted or is late, which costs some CPU time per task. Set it to
+    null if the deadlines should only be checked when the tasks suspend. */
+#define RTOS_EVT_DEADLINE_MISS  0
+
+
+/** Enable the timing statistics of the tasks. For each task the kernel measures the
+    release jitter, the start latency and the response time in each activation and
+    records minimum, maximum and a logarithmic histogram of each. The statistics are
+    queried with \a rtos_getTaskStatistics. They help finding appropriate priorities and
+    periods of the tasks.\n
+      The time spans are measured with the high resolution time stamps, the feature
+    requires #RTOS_USE_CTC_SYSTEM_TIMER. It costs about 2 us of CPU time in each state
+    transition of a task and 5 + 3*(8+2*#RTOS_TASK_STATISTICS_NO_BINS) Byte of RAM per
+    task.\n
+      Select either RTOS_FEATURE_OFF or RTOS_FEATURE_ON. */
+#define RTOS_USE_TASK_STATISTICS    RTOS_FEATURE_OFF
+
+/** The number of bins of the logarithmic histograms of the task statistics. */
+#define RTOS_TASK_STATISTICS_NO_BINS    8
+
+/** The time spans are divided by two to the power of this value before they are sorted
+    into the bins of the histograms. With the default value, 4, and a prescaler of one at
+    16 MHz, the first bins are 1 us, 2 us, 4 us, etc. wide. */
+#define RTOS_TASK_STATISTICS_SCALE  4
+
+
 #if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
 /** The implementation of a semaphore is a simple unsigned integer. The value means the
     number of resources managed by the semaphore. In a resource management system it may be
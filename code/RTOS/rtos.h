@@ -25,6 +25,23 @@
  */
  
 #include "Arduino.h"
+
+/* The switches, which make the feature selecting defines readable, are needed already by
+   the configuration file, which may use them in preprocessor conditions. */
+/** Switch to make feature selecting defines readable. Here: Feature is enabled. */
+#define RTOS_FEATURE_ON     1
+/** Switch to make feature selecting defines readable. Here: Feature is disabled. */
+#define RTOS_FEATURE_OFF    0
+
+/** Derive a switch telling whether events of type semaphore are in use. The switch is an
+    expression, which evaluates to either #RTOS_FEATURE_ON or #RTOS_FEATURE_OFF. It may
+    be used in the configuration file once the number of semaphores has been defined. */
+#define RTOS_USE_SEMAPHORE  (RTOS_NO_SEMAPHORE_EVENTS > 0)
+
+/** Derive a switch telling whether events of type mutex are in use. The switch is an
+    expression, which evaluates to either #RTOS_FEATURE_ON or #RTOS_FEATURE_OFF. */
+#define RTOS_USE_MUTEX      (RTOS_NO_MUTEX_EVENTS > 0)
+
 #include "rtos.config.h"
 
 
@@ -42,180 +59,382 @@
     "This is free software; see the source for copying conditions. There is NO\n"       \
     "warranty; not even for MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE."
 
-/** Switch to make feature selecting defines readable. Here: Feature is enabled. */
-#define RTOS_FEATURE_ON     1
-/** Switch to make feature selecting defines readable. Here: Feature is disabled. */
-#define RTOS_FEATURE_OFF    0
-
 
-/** Derive a switch telling whether events of type semaphore are in use. */
-#if RTOS_NO_SEMAPHORE_EVENTS > 0
-# define RTOS_USE_SEMAPHORE RTOS_FEATURE_ON
-#else
-# define RTOS_USE_SEMAPHORE RTOS_FEATURE_OFF
+/* The configuration switches, which have been added after the first release of RTuinOS
+   are set to a default value if an application's configuration file doesn't know them
+   yet. */
+#ifndef RTOS_USE_EDF_PRIO_CLASS
+# define RTOS_USE_EDF_PRIO_CLASS    RTOS_FEATURE_OFF
 #endif
-
-
-/** Derive a switch telling whether events of type mutex are in use. */
-#if RTOS_NO_MUTEX_EVENTS > 0
-# define RTOS_USE_MUTEX RTOS_FEATURE_ON
-#else
-# define RTOS_USE_MUTEX RTOS_FEATURE_OFF
+#if RTOS_USE_EDF_PRIO_CLASS == RTOS_FEATURE_ON  &&  RTOS_EDF_PRIO_CLASS >= RTOS_NO_PRIO_CLASSES
+# error Configuration error: RTOS_EDF_PRIO_CLASS is not a valid priority class
 #endif
-
-
-/* Some global, general purpose events and the two timer events. Used to specify the
-   resume condition when suspending a task.
-     Conditional definition: If the application defines an interrupt which triggers an
-   event, the same event gets a deviating name. */
-/** General purpose event, posted explicitly by rtos_sendEvent. */
-#if RTOS_NO_SEMAPHORE_EVENTS > 0
-# define RTOS_EVT_SEMAPHORE_00      (0x0001u<<0)
-#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 0
-# define RTOS_EVT_MUTEX_00          (0x0001u<<0)
-#else
-# define RTOS_EVT_EVENT_00          (0x0001u<<0)
+#ifndef RTOS_USE_CTC_SYSTEM_TIMER
+# define RTOS_USE_CTC_SYSTEM_TIMER  RTOS_FEATURE_OFF
 #endif
-
-/** General purpose event, posted explicitly by rtos_sendEvent. */
-#if RTOS_NO_SEMAPHORE_EVENTS > 1
-# define RTOS_EVT_SEMAPHORE_01      (0x0001u<<1)
-#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 1
-# define RTOS_EVT_MUTEX_01          (0x0001u<<1)
-#else
-# define RTOS_EVT_EVENT_01          (0x0001u<<1)
+#ifndef RTOS_PROVIDE_ARDUINO_TIME
+# define RTOS_PROVIDE_ARDUINO_TIME  RTOS_FEATURE_OFF
 #endif
-
-/** General purpose event, posted explicitly by rtos_sendEvent. */
-#if RTOS_NO_SEMAPHORE_EVENTS > 2
-# define RTOS_EVT_SEMAPHORE_02      (0x0001u<<2)
-#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 2
-# define RTOS_EVT_MUTEX_02          (0x0001u<<2)
-#else
-# define RTOS_EVT_EVENT_02          (0x0001u<<2)
+#ifndef RTOS_CHECK_STACK_GUARD
+# define RTOS_CHECK_STACK_GUARD     RTOS_FEATURE_OFF
 #endif
-
-/** General purpose event, posted explicitly by rtos_sendEvent. */
-#if RTOS_NO_SEMAPHORE_EVENTS > 3
-# define RTOS_EVT_SEMAPHORE_03      (0x0001u<<3)
-#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 3
-# define RTOS_EVT_MUTEX_03          (0x0001u<<3)
-#else
-# define RTOS_EVT_EVENT_03          (0x0001u<<3)
+#ifndef RTOS_STACK_GUARD_SIZE
+# define RTOS_STACK_GUARD_SIZE      16
 #endif
-
-/** General purpose event, posted explicitly by rtos_sendEvent. */
-#if RTOS_NO_SEMAPHORE_EVENTS > 4
-# define RTOS_EVT_SEMAPHORE_04      (0x0001u<<4)
-#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 4
-# define RTOS_EVT_MUTEX_04          (0x0001u<<4)
-#else
-# define RTOS_EVT_EVENT_04          (0x0001u<<4)
+#ifndef RTOS_INCREMENTAL_STACK_SCAN
+# define RTOS_INCREMENTAL_STACK_SCAN RTOS_FEATURE_OFF
 #endif
-
-/** General purpose event, posted explicitly by rtos_sendEvent. */
-#if RTOS_NO_SEMAPHORE_EVENTS > 5
-# define RTOS_EVT_SEMAPHORE_05      (0x0001u<<5)
-#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 5
-# define RTOS_EVT_MUTEX_05          (0x0001u<<5)
-#else
-# define RTOS_EVT_EVENT_05          (0x0001u<<5)
+#ifndef RTOS_LAZY_STACK_PAINTING
+# define RTOS_LAZY_STACK_PAINTING   RTOS_FEATURE_OFF
 #endif
-
-/** General purpose event, posted explicitly by rtos_sendEvent. */
-#if RTOS_NO_SEMAPHORE_EVENTS > 6
-# define RTOS_EVT_SEMAPHORE_06      (0x0001u<<6)
-#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 6
-# define RTOS_EVT_MUTEX_06          (0x0001u<<6)
-#else
-# define RTOS_EVT_EVENT_06          (0x0001u<<6)
+#ifndef RTOS_APPL_INTERRUPT_LIST
+# define RTOS_APPL_INTERRUPT_LIST(RTOS_ISR_TO_EVENT, RTOS_ISR_TO_TOP_HALF)
 #endif
-
-/** General purpose event, posted explicitly by rtos_sendEvent. */
-#if RTOS_NO_SEMAPHORE_EVENTS > 7
-# define RTOS_EVT_SEMAPHORE_07      (0x0001u<<7)
-#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 7
-# define RTOS_EVT_MUTEX_07          (0x0001u<<7)
-#else
-# define RTOS_EVT_EVENT_07          (0x0001u<<7)
+#ifndef RTOS_USE_DEFERRED_WORK
+# define RTOS_USE_DEFERRED_WORK     RTOS_FEATURE_OFF
 #endif
-
-/** General purpose event, posted explicitly by rtos_sendEvent. */
-#if RTOS_NO_SEMAPHORE_EVENTS > 8
-# error No more than eight semaphores are permitted
-#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 8
-# define RTOS_EVT_MUTEX_08          (0x0001u<<8)
-#else
-# define RTOS_EVT_EVENT_08          (0x0001u<<8)
+#ifndef RTOS_DEFERRED_WORK_QUEUE_SIZE
+# define RTOS_DEFERRED_WORK_QUEUE_SIZE 8
 #endif
-
-/** General purpose event, posted explicitly by rtos_sendEvent. */
-#if RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 9
-# define RTOS_EVT_MUTEX_09          (0x0001u<<9)
-#else
-# define RTOS_EVT_EVENT_09          (0x0001u<<9)
+#ifndef RTOS_USE_EVENT_DATA
+# define RTOS_USE_EVENT_DATA        RTOS_FEATURE_OFF
+#endif
+#ifndef RTOS_COUNTED_EVENT_MASK
+# define RTOS_COUNTED_EVENT_MASK    0
+#endif
+#ifndef RTOS_EVENT_VECTOR_WIDTH
+# define RTOS_EVENT_VECTOR_WIDTH    16
+#endif
+#ifndef RTOS_USE_SET_TASK_PRIORITY
+# define RTOS_USE_SET_TASK_PRIORITY RTOS_FEATURE_OFF
+#endif
+#ifndef RTOS_USE_TASK_CONTROL
+# define RTOS_USE_TASK_CONTROL      RTOS_FEATURE_OFF
+#endif
+#ifndef RTOS_USE_OVERRUN_POLICY
+# define RTOS_USE_OVERRUN_POLICY    RTOS_FEATURE_OFF
+#endif
+#ifndef RTOS_EVT_TASK_OVERRUN
+# define RTOS_EVT_TASK_OVERRUN      0
+#endif
+#ifndef RTOS_USE_DEADLINE_MONITOR
+# define RTOS_USE_DEADLINE_MONITOR  RTOS_FEATURE_OFF
+#endif
+#ifndef RTOS_EVT_DEADLINE_MISS
+# define RTOS_EVT_DEADLINE_MISS     0
+#endif
+#ifndef RTOS_USE_TASK_STATISTICS
+# define RTOS_USE_TASK_STATISTICS   RTOS_FEATURE_OFF
+#endif
+#ifndef RTOS_TASK_STATISTICS_NO_BINS
+# define RTOS_TASK_STATISTICS_NO_BINS   8
+#endif
+#ifndef RTOS_TASK_STATISTICS_SCALE
+# define RTOS_TASK_STATISTICS_SCALE 4
+#endif
+#if RTOS_USE_TASK_STATISTICS == RTOS_FEATURE_ON                                            \
+    &&  RTOS_USE_CTC_SYSTEM_TIMER == RTOS_FEATURE_OFF
+# error Configuration error: RTOS_USE_TASK_STATISTICS requires RTOS_USE_CTC_SYSTEM_TIMER
+#endif
+#if RTOS_EVENT_VECTOR_WIDTH != 16  &&  RTOS_EVENT_VECTOR_WIDTH != 32
+# error Configuration error: RTOS_EVENT_VECTOR_WIDTH needs to be either 16 or 32
+#endif
+#ifndef RTOS_EVENT_LIST
+# define RTOS_EVENT_LIST(RTOS_EVENT)
+#endif
+#if defined(RTOS_SCHEDULE_TABLE)  &&  !defined(RTOS_SCHEDULE_HYPERPERIOD)
+# error Configuration error: RTOS_SCHEDULE_HYPERPERIOD needs to be defined for RTOS_SCHEDULE_TABLE
+#endif
+/** \cond The number of entries of #RTOS_TASK_LIST and #RTOS_EVENT_LIST. The expansion of
+    the lists is a sum, which can be evaluated by the preprocessor. */
+#define RTOS_COUNT_TASK( taskFunction, prioClass, timeRoundRobin, timeDeadline             \
+                       , stackSize, startEventMask, startByAllEvents, startTimeout         \
+                       )                                                                   \
+            +1
+#define RTOS_COUNT_EVENT(name)      +1
+#define RTOS_NO_LISTED_EVENTS       (0 RTOS_EVENT_LIST(RTOS_COUNT_EVENT))
+/** \endcond */
+#ifdef RTOS_TASK_LIST
+# ifndef RTOS_NO_TASKS
+#  define RTOS_NO_TASKS             (0 RTOS_TASK_LIST(RTOS_COUNT_TASK))
+# elif RTOS_NO_TASKS != (0 RTOS_TASK_LIST(RTOS_COUNT_TASK))
+#  error Configuration error: RTOS_NO_TASKS differs from the number of entries of RTOS_TASK_LIST
+# endif
+#endif
+#if RTOS_USE_DEFERRED_WORK == RTOS_FEATURE_ON
+# ifndef RTOS_EVT_DEFERRED_WORK
+#  error Configuration error: RTOS_EVT_DEFERRED_WORK needs to be defined
+# endif
+# if (RTOS_DEFERRED_WORK_QUEUE_SIZE & (RTOS_DEFERRED_WORK_QUEUE_SIZE-1)) != 0  \
+     ||  RTOS_DEFERRED_WORK_QUEUE_SIZE > 128
+#  error Configuration error: RTOS_DEFERRED_WORK_QUEUE_SIZE needs to be a power of two <= 128
+# endif
 #endif
 
-/** General purpose event, posted explicitly by rtos_sendEvent. */
-#if RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 10
-# define RTOS_EVT_MUTEX_10          (0x0001u<<10)
-#else
-# define RTOS_EVT_EVENT_10          (0x0001u<<10)
+
+#if RTOS_USE_CTC_SYSTEM_TIMER == RTOS_FEATURE_ON
+/* The built-in system timer driver: One of the 16 Bit timers is operated in CTC mode. The
+   prescaler is the smallest one, which permits the configured tic period; this yields the
+   best resolution. The compare value is rounded to the nearest integer, the resulting tic
+   period is exactly known as RTOS_CTC_TIC. */
+# if RTOS_CTC_TIMER != 1  &&  RTOS_CTC_TIMER != 3  &&  RTOS_CTC_TIMER != 4  &&  RTOS_CTC_TIMER != 5
+#  error Configuration error: RTOS_CTC_TIMER needs to be one of the 16 Bit timers 1, 3, 4 or 5
+# endif
+
+/** The number of CPU clock tics per system timer tic. */
+# define RTOS_CTC_CPU_TICS_PER_TIC  ((F_CPU*1ull*(RTOS_CTC_TIC_PERIOD_US) + 500000ull) / 1000000ull)
+
+# if RTOS_CTC_CPU_TICS_PER_TIC < 100
+#  error Configuration error: RTOS_CTC_TIC_PERIOD_US is too short
+# elif RTOS_CTC_CPU_TICS_PER_TIC <= 65536ull
+#  define RTOS_CTC_PRESCALER    1
+#  define RTOS_CTC_CS_BITS      0x01
+# elif RTOS_CTC_CPU_TICS_PER_TIC <= 8ull*65536ull
+#  define RTOS_CTC_PRESCALER    8
+#  define RTOS_CTC_CS_BITS      0x02
+# elif RTOS_CTC_CPU_TICS_PER_TIC <= 64ull*65536ull
+#  define RTOS_CTC_PRESCALER    64
+#  define RTOS_CTC_CS_BITS      0x03
+# elif RTOS_CTC_CPU_TICS_PER_TIC <= 256ull*65536ull
+#  define RTOS_CTC_PRESCALER    256
+#  define RTOS_CTC_CS_BITS      0x04
+# elif RTOS_CTC_CPU_TICS_PER_TIC <= 1024ull*65536ull
+#  define RTOS_CTC_PRESCALER    1024
+#  define RTOS_CTC_CS_BITS      0x05
+# else
+#  error Configuration error: RTOS_CTC_TIC_PERIOD_US is too long
+# endif
+
+/** The value of the compare register, which determines the period of the timer. */
+# define RTOS_CTC_OCR_VALUE                                                             \
+            ((uint16_t)((RTOS_CTC_CPU_TICS_PER_TIC + RTOS_CTC_PRESCALER/2)              \
+                        / RTOS_CTC_PRESCALER - 1                                        \
+                       )                                                                \
+            )
+
+/** The exact period time of the system timer tic, which results from the configured
+    period, the CPU clock frequency and the available prescalers. Unit is s. */
+# define RTOS_CTC_TIC                                                                   \
+            ((double)RTOS_CTC_PRESCALER * ((double)RTOS_CTC_OCR_VALUE + 1.0) / (double)F_CPU)
+
+/** The unit of the time stamps returned by \a rtos_getTimestamp, which is the clock tic
+    of the system timer. Unit is s. */
+# define RTOS_TIMESTAMP_UNIT    ((double)RTOS_CTC_PRESCALER / (double)F_CPU)
+
+/** \cond Two nested macros are used to compose the names of the registers of the selected
+    timer. */
+# define RTOS_CTC_CAT3_(a, n, b) a##n##b
+# define RTOS_CTC_CAT3(a, n, b) RTOS_CTC_CAT3_(a, n, b)
+/** \endcond */
+
+/** The interrupt vector of the selected timer, which clocks the system time. */
+# define RTOS_CTC_ISR_VECTOR    RTOS_CTC_CAT3(TIMER, RTOS_CTC_TIMER, _COMPA_vect)
+
+/** The registers and bits of the selected timer. */
+# define RTOS_CTC_TCCRA     RTOS_CTC_CAT3(TCCR, RTOS_CTC_TIMER, A)
+# define RTOS_CTC_TCCRB     RTOS_CTC_CAT3(TCCR, RTOS_CTC_TIMER, B)
+# define RTOS_CTC_TCNT      RTOS_CTC_CAT3(TCNT, RTOS_CTC_TIMER, )
+# define RTOS_CTC_OCRA      RTOS_CTC_CAT3(OCR, RTOS_CTC_TIMER, A)
+# define RTOS_CTC_TIMSK     RTOS_CTC_CAT3(TIMSK, RTOS_CTC_TIMER, )
+# define RTOS_CTC_TIFR      RTOS_CTC_CAT3(TIFR, RTOS_CTC_TIMER, )
+# define RTOS_CTC_OCIEA     RTOS_CTC_CAT3(OCIE, RTOS_CTC_TIMER, A)
+# define RTOS_CTC_OCFA      RTOS_CTC_CAT3(OCF, RTOS_CTC_TIMER, A)
+# define RTOS_CTC_WGM2      RTOS_CTC_CAT3(WGM, RTOS_CTC_TIMER, 2)
+#endif /* RTOS_USE_CTC_SYSTEM_TIMER == RTOS_FEATURE_ON */
+
+#if RTOS_PROVIDE_ARDUINO_TIME == RTOS_FEATURE_ON
+/* The Arduino time functions are derived from the system timer. This requires the CTC
+   system timer and a tic period, which is realized without rounding error, otherwise
+   millis() and micros() would drift. */
+# if RTOS_USE_CTC_SYSTEM_TIMER != RTOS_FEATURE_ON
+#  error Configuration error: RTOS_PROVIDE_ARDUINO_TIME requires RTOS_USE_CTC_SYSTEM_TIMER
+# endif
+# if F_CPU % 1000000ul != 0                                                             \
+     ||  RTOS_CTC_CPU_TICS_PER_TIC != F_CPU/1000000ull*(RTOS_CTC_TIC_PERIOD_US)         \
+     ||  RTOS_CTC_CPU_TICS_PER_TIC % RTOS_CTC_PRESCALER != 0
+#  error Configuration error: RTOS_PROVIDE_ARDUINO_TIME requires an exact tic period
+# endif
 #endif
 
-/** General purpose event, posted explicitly by rtos_sendEvent. */
-#if RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 11
-# define RTOS_EVT_MUTEX_11          (0x0001u<<11)
+
+/** The event with index \a idx as a bit in the event vector. The events are numbered 0 ..
+    #RTOS_EVENT_VECTOR_WIDTH-1; the two highest ones are the timer events. The application
+    should use the macros below, which check the kind of the event, e.g.
+    #RTOS_EVT_SEMAPHORE. */
+#if RTOS_EVENT_VECTOR_WIDTH == 32
+# define RTOS_EVT(idx)              (0x00000001ul<<(idx))
 #else
-# define RTOS_EVT_EVENT_11          (0x0001u<<11)
+# define RTOS_EVT(idx)              (0x0001u<<(idx))
 #endif
 
-/* The name of the next event depends on the configuration of RTuinOS. */
+/* The names of the events posted by the application defined ISRs. They use the two events
+   below the timer events. */
 #if RTOS_USE_APPL_INTERRUPT_01 == RTOS_FEATURE_ON
 /** This event is posted by the application defined ISR 01.
-      @remark The expression here is passed on to the assembler as is. It needs to be
-    compatible with both, compiler and assembler. Type casts, type post fixes, nested
-    macros etc. must not be used. */
-# define RTOS_EVT_ISR_USER_01       (0x0001<<12)
-# if RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 12
-#  error Too many semaphores and mutexes specified. The limit is 12 when using two application interrupts
-# endif
-#else
-/** General purpose event, posted explicitly by rtos_sendEvent. */
-# if RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 12
-#  define RTOS_EVT_MUTEX_12         (0x0001u<<12)
-# else
-#  define RTOS_EVT_EVENT_12         (0x0001u<<12)
-# endif
+      @remark The expression here is used as immediate operand of inline assembler code.
+    It needs to be a constant expression. */
+# define RTOS_EVT_ISR_USER_01       RTOS_EVT(RTOS_EVENT_VECTOR_WIDTH-4)
 #endif
-
-/* The name of the next event depends on the configuration of RTuinOS. */
 #if RTOS_USE_APPL_INTERRUPT_00 == RTOS_FEATURE_ON
 /** This event is posted by the application defined ISR 00.
-      @remark The expression here is passed on to the assembler as is. It needs to be
-    compatible with both, compiler and assembler. Type casts, type post fixes, nested
-    macros etc. must not be used. */
-# define RTOS_EVT_ISR_USER_00       (0x0001<<13)
-# if RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 13
-#  error Too many semaphores and mutexes specified. The limit is 13 when using a single application interrupt
+      @remark The expression here is used as immediate operand of inline assembler code.
+    It needs to be a constant expression. */
+# define RTOS_EVT_ISR_USER_00       RTOS_EVT(RTOS_EVENT_VECTOR_WIDTH-3)
+#endif
+
+/** \cond The events, which are reserved for the application defined ISRs. */
+#define RTOS_EVT_MASK_ISR_USER                                                             \
+            (((RTOS_USE_APPL_INTERRUPT_01 == RTOS_FEATURE_ON)                              \
+              ? RTOS_EVT(RTOS_EVENT_VECTOR_WIDTH-4)                                        \
+              : 0u                                                                         \
+             )                                                                             \
+             | ((RTOS_USE_APPL_INTERRUPT_00 == RTOS_FEATURE_ON)                            \
+                ? RTOS_EVT(RTOS_EVENT_VECTOR_WIDTH-3)                                      \
+                : 0u                                                                       \
+               )                                                                           \
+            )
+
+/* The check of the index of an event of a given kind: Event \a idx is returned if \a
+   isInRange is true, otherwise the expression divides by zero. The compiler reports this
+   as an error in preprocessor conditions and in constant expressions and as a warning
+   (-Wdiv-by-zero) in all other expressions. */
+#define RTOS_EVT_CHECKED(idx, isInRange)    (RTOS_EVT(idx) / ((isInRange)? 1u: 0u))
+/** \endcond */
+
+/** The semaphore with index \a idx as a bit in the event vector. The semaphores use the
+    events 0 .. #RTOS_NO_SEMAPHORE_EVENTS-1. */
+#define RTOS_EVT_SEMAPHORE(idx)                                                            \
+            RTOS_EVT_CHECKED(idx, (idx) >= 0  &&  (idx) < RTOS_NO_SEMAPHORE_EVENTS)
+
+/** The mutex, which is event \a idx of the event vector. The mutexes use the events
+    #RTOS_NO_SEMAPHORE_EVENTS .. #RTOS_NO_SEMAPHORE_EVENTS+#RTOS_NO_MUTEX_EVENTS-1. */
+#define RTOS_EVT_MUTEX(idx)                                                                \
+            RTOS_EVT_CHECKED( idx                                                          \
+                            , (idx) >= RTOS_NO_SEMAPHORE_EVENTS                            \
+                              &&  (idx) < RTOS_NO_SEMAPHORE_EVENTS+RTOS_NO_MUTEX_EVENTS    \
+                            )
+
+/** The general purpose event \a idx of the event vector, posted explicitly by
+    rtos_sendEvent. These are all events from #RTOS_NO_SEMAPHORE_EVENTS +
+    #RTOS_NO_MUTEX_EVENTS up to the timer events, except for the events of the application
+    defined ISRs. */
+#define RTOS_EVT_EVENT(idx)                                                                \
+            RTOS_EVT_CHECKED( idx                                                          \
+                            , (idx) >= RTOS_NO_SEMAPHORE_EVENTS+RTOS_NO_MUTEX_EVENTS       \
+                              &&  (idx) < RTOS_EVENT_VECTOR_WIDTH-2                        \
+                              &&  (RTOS_EVT(idx) & RTOS_EVT_MASK_ISR_USER) == 0            \
+                            )
+
+/* The names of the events of former RTuinOS revisions, e.g. RTOS_EVT_EVENT_03 or
+   RTOS_EVT_MUTEX_09. The number in the name is the index of the event in the event vector;
+   the kind of the event is checked as by the macros above. */
+#define RTOS_EVT_SEMAPHORE_00      RTOS_EVT_SEMAPHORE(0)
+#define RTOS_EVT_SEMAPHORE_01      RTOS_EVT_SEMAPHORE(1)
+#define RTOS_EVT_SEMAPHORE_02      RTOS_EVT_SEMAPHORE(2)
+#define RTOS_EVT_SEMAPHORE_03      RTOS_EVT_SEMAPHORE(3)
+#define RTOS_EVT_SEMAPHORE_04      RTOS_EVT_SEMAPHORE(4)
+#define RTOS_EVT_SEMAPHORE_05      RTOS_EVT_SEMAPHORE(5)
+#define RTOS_EVT_SEMAPHORE_06      RTOS_EVT_SEMAPHORE(6)
+#define RTOS_EVT_SEMAPHORE_07      RTOS_EVT_SEMAPHORE(7)
+#define RTOS_EVT_MUTEX_00          RTOS_EVT_MUTEX(0)
+#define RTOS_EVT_MUTEX_01          RTOS_EVT_MUTEX(1)
+#define RTOS_EVT_MUTEX_02          RTOS_EVT_MUTEX(2)
+#define RTOS_EVT_MUTEX_03          RTOS_EVT_MUTEX(3)
+#define RTOS_EVT_MUTEX_04          RTOS_EVT_MUTEX(4)
+#define RTOS_EVT_MUTEX_05          RTOS_EVT_MUTEX(5)
+#define RTOS_EVT_MUTEX_06          RTOS_EVT_MUTEX(6)
+#define RTOS_EVT_MUTEX_07          RTOS_EVT_MUTEX(7)
+#define RTOS_EVT_MUTEX_08          RTOS_EVT_MUTEX(8)
+#define RTOS_EVT_MUTEX_09          RTOS_EVT_MUTEX(9)
+#define RTOS_EVT_MUTEX_10          RTOS_EVT_MUTEX(10)
+#define RTOS_EVT_MUTEX_11          RTOS_EVT_MUTEX(11)
+#define RTOS_EVT_MUTEX_12          RTOS_EVT_MUTEX(12)
+#define RTOS_EVT_MUTEX_13          RTOS_EVT_MUTEX(13)
+#define RTOS_EVT_MUTEX_14          RTOS_EVT_MUTEX(14)
+#define RTOS_EVT_MUTEX_15          RTOS_EVT_MUTEX(15)
+#define RTOS_EVT_MUTEX_16          RTOS_EVT_MUTEX(16)
+#define RTOS_EVT_MUTEX_17          RTOS_EVT_MUTEX(17)
+#define RTOS_EVT_MUTEX_18          RTOS_EVT_MUTEX(18)
+#define RTOS_EVT_MUTEX_19          RTOS_EVT_MUTEX(19)
+#define RTOS_EVT_MUTEX_20          RTOS_EVT_MUTEX(20)
+#define RTOS_EVT_MUTEX_21          RTOS_EVT_MUTEX(21)
+#define RTOS_EVT_MUTEX_22          RTOS_EVT_MUTEX(22)
+#define RTOS_EVT_MUTEX_23          RTOS_EVT_MUTEX(23)
+#define RTOS_EVT_MUTEX_24          RTOS_EVT_MUTEX(24)
+#define RTOS_EVT_MUTEX_25          RTOS_EVT_MUTEX(25)
+#define RTOS_EVT_MUTEX_26          RTOS_EVT_MUTEX(26)
+#define RTOS_EVT_MUTEX_27          RTOS_EVT_MUTEX(27)
+#define RTOS_EVT_MUTEX_28          RTOS_EVT_MUTEX(28)
+#define RTOS_EVT_MUTEX_29          RTOS_EVT_MUTEX(29)
+#define RTOS_EVT_EVENT_00          RTOS_EVT_EVENT(0)
+#define RTOS_EVT_EVENT_01          RTOS_EVT_EVENT(1)
+#define RTOS_EVT_EVENT_02          RTOS_EVT_EVENT(2)
+#define RTOS_EVT_EVENT_03          RTOS_EVT_EVENT(3)
+#define RTOS_EVT_EVENT_04          RTOS_EVT_EVENT(4)
+#define RTOS_EVT_EVENT_05          RTOS_EVT_EVENT(5)
+#define RTOS_EVT_EVENT_06          RTOS_EVT_EVENT(6)
+#define RTOS_EVT_EVENT_07          RTOS_EVT_EVENT(7)
+#define RTOS_EVT_EVENT_08          RTOS_EVT_EVENT(8)
+#define RTOS_EVT_EVENT_09          RTOS_EVT_EVENT(9)
+#define RTOS_EVT_EVENT_10          RTOS_EVT_EVENT(10)
+#define RTOS_EVT_EVENT_11          RTOS_EVT_EVENT(11)
+#define RTOS_EVT_EVENT_12          RTOS_EVT_EVENT(12)
+#define RTOS_EVT_EVENT_13          RTOS_EVT_EVENT(13)
+#define RTOS_EVT_EVENT_14          RTOS_EVT_EVENT(14)
+#define RTOS_EVT_EVENT_15          RTOS_EVT_EVENT(15)
+#define RTOS_EVT_EVENT_16          RTOS_EVT_EVENT(16)
+#define RTOS_EVT_EVENT_17          RTOS_EVT_EVENT(17)
+#define RTOS_EVT_EVENT_18          RTOS_EVT_EVENT(18)
+#define RTOS_EVT_EVENT_19          RTOS_EVT_EVENT(19)
+#define RTOS_EVT_EVENT_20          RTOS_EVT_EVENT(20)
+#define RTOS_EVT_EVENT_21          RTOS_EVT_EVENT(21)
+#define RTOS_EVT_EVENT_22          RTOS_EVT_EVENT(22)
+#define RTOS_EVT_EVENT_23          RTOS_EVT_EVENT(23)
+#define RTOS_EVT_EVENT_24          RTOS_EVT_EVENT(24)
+#define RTOS_EVT_EVENT_25          RTOS_EVT_EVENT(25)
+#define RTOS_EVT_EVENT_26          RTOS_EVT_EVENT(26)
+#define RTOS_EVT_EVENT_27          RTOS_EVT_EVENT(27)
+#define RTOS_EVT_EVENT_28          RTOS_EVT_EVENT(28)
+#define RTOS_EVT_EVENT_29          RTOS_EVT_EVENT(29)
+
+#if RTOS_NO_SEMAPHORE_EVENTS > 8
+# error No more than eight semaphores are permitted
+#endif
+
+#if RTOS_USE_APPL_INTERRUPT_01 == RTOS_FEATURE_ON
+# if RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > RTOS_EVENT_VECTOR_WIDTH-4
+#  error Too many semaphores and mutexes specified. The limit is 12 (28 with 32 Bit event vectors) when using two application interrupts
+# elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_LISTED_EVENTS             \
+       > RTOS_EVENT_VECTOR_WIDTH-4
+#  error Too many events in RTOS_EVENT_LIST. They collide with application interrupt 01
 # endif
-#else
-/** General purpose event, posted explicitly by rtos_sendEvent. */
-# if RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 13
-#  define RTOS_EVT_MUTEX_13         (0x0001u<<13)
-# else
-#  define RTOS_EVT_EVENT_13         (0x0001u<<13)
+#elif RTOS_USE_APPL_INTERRUPT_00 == RTOS_FEATURE_ON
+# if RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > RTOS_EVENT_VECTOR_WIDTH-3
+#  error Too many semaphores and mutexes specified. The limit is 13 (29 with 32 Bit event vectors) when using a single application interrupt
+# elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_LISTED_EVENTS             \
+       > RTOS_EVENT_VECTOR_WIDTH-3
+#  error Too many events in RTOS_EVENT_LIST. They collide with application interrupt 00
 # endif
 #endif
-
-#if RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > 14
-# error Too many semaphores and mutexes specified. The limit is 14 in total
+#if RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS > RTOS_EVENT_VECTOR_WIDTH-2
+# error Too many semaphores and mutexes specified. The limit is 14 (30 with 32 Bit event vectors) in total
+#elif RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS + RTOS_NO_LISTED_EVENTS              \
+      > RTOS_EVENT_VECTOR_WIDTH-2
+# error Too many events in RTOS_EVENT_LIST. They collide with the timer events
 #endif
 
 /** Real time clock is elapsed for the task. */
-#define RTOS_EVT_ABSOLUTE_TIMER     (0x0001u<<14)
+#define RTOS_EVT_ABSOLUTE_TIMER     RTOS_EVT(RTOS_EVENT_VECTOR_WIDTH-2)
 /** The relative-to-start clock is elapsed for the task */
-#define RTOS_EVT_DELAY_TIMER        (0x0001u<<15)
+#define RTOS_EVT_DELAY_TIMER        RTOS_EVT(RTOS_EVENT_VECTOR_WIDTH-1)
+
+#if ((RTOS_COUNTED_EVENT_MASK)                                                          \
+     & (((1u<<(RTOS_NO_SEMAPHORE_EVENTS+RTOS_NO_MUTEX_EVENTS))-1u)                      \
+        | RTOS_EVT_ABSOLUTE_TIMER | RTOS_EVT_DELAY_TIMER                                \
+       )                                                                                \
+    ) != 0
+# error Configuration error: RTOS_COUNTED_EVENT_MASK must contain ordinary events only
+#endif
 
 
 /** The system timer frequency as floating point constant. The unit is Hz.\n
@@ -232,6 +451,37 @@
 #define RTOS_TIC_MS ((RTOS_TIC)*1000.0)
 
 
+/** The value returned by the functions, which report the stack reserve of a task, if the
+    reserve is not known yet. This happens only if #RTOS_LAZY_STACK_PAINTING is on: The
+    stack area of a task has not yet been completely filled with the pattern bytes by the
+    idle task.\n
+      Note, the idle task can fill only the bytes below the stack pointer, which the task
+    had saved when it was left the last time before. The activations of the task before
+    the painting has completed are not monitored: If they had used more stack, the
+    reported reserve overstates the true margin. */
+#define RTOS_STACK_RESERVE_UNKNOWN  0xffffu
+
+
+/** The overrun policies of a regular task, see \a rtos_setTaskOverrunPolicy. A policy is
+    one of the timing reactions RTOS_OVERRUN_POLICY_DEFAULT, RTOS_OVERRUN_POLICY_CATCH_UP
+    or RTOS_OVERRUN_POLICY_SKIP, optionally combined by bitwise OR with the notifications
+    RTOS_OVERRUN_CALL_HOOK and RTOS_OVERRUN_SEND_EVENT.\n
+      RTOS_OVERRUN_POLICY_DEFAULT: The reaction is set by
+    #RTOS_OVERRUN_TASK_IS_IMMEDIATELY_DUE. This is the policy of all tasks after reset.\n
+      RTOS_OVERRUN_POLICY_CATCH_UP: The task keeps its time grid; it becomes due again
+    without being suspended. All missed activations are made up one after another.\n
+      RTOS_OVERRUN_POLICY_SKIP: The missed activations are dropped; the task is resumed
+    at the next point in time on its time grid, which is still in the future.\n
+      RTOS_OVERRUN_CALL_HOOK: The callback \a rtos_onTaskOverrun is invoked.\n
+      RTOS_OVERRUN_SEND_EVENT: The event #RTOS_EVT_TASK_OVERRUN is posted to the suspended
+    tasks, typically to a supervising task. */
+#define RTOS_OVERRUN_POLICY_DEFAULT     0x00
+#define RTOS_OVERRUN_POLICY_CATCH_UP    0x01
+#define RTOS_OVERRUN_POLICY_SKIP        0x02
+#define RTOS_OVERRUN_CALL_HOOK          0x04
+#define RTOS_OVERRUN_SEND_EVENT         0x08
+
+
 /** Function prototype decoration which declares a function of RTuinOS just a default
     implementation of the required functionality. The application code can redefine the
     function and override the default implementation.\n
@@ -324,7 +574,7 @@
 
 
 /**
- * Alias of function void rtos_sendEvent(uint16_t). Post a set of events to the suspended
+ * Alias of function void rtos_sendEvent(uintEventVec_t). Post a set of events to the suspended
  * tasks. Suspend the current task if the events resume another task of higher priority.
  *   @param eventVec
  * The set of events to be posted.
@@ -333,21 +583,96 @@
  *   @remark
  * This macro exists for backward compatibility only: The function \a rtos_sendEvent had
  * been named \a rtos_setEvent in the first release of RTuinOS, version 0.9.
- *   @see void rtos_sendEvent(uint16_t)
+ *   @see void rtos_sendEvent(uintEventVec_t)
  */
-#define /* void */ rtos_setEvent(/* uint16_t */ eventVec) rtos_sendEvent(eventVec)
+#define /* void */ rtos_setEvent(/* uintEventVec_t */ eventVec) rtos_sendEvent(eventVec)
 
 
 /*
  * Global type definitions
  */
 
+/** The type of an event vector, i.e. a set of events. Its width is configured by
+    #RTOS_EVENT_VECTOR_WIDTH. */
+#if RTOS_EVENT_VECTOR_WIDTH == 32
+typedef uint32_t uintEventVec_t;
+#else
+typedef uint16_t uintEventVec_t;
+#endif
+
 /** The type of any task.\n
       The function is of type void; it must never return.\n
       The function takes a single parameter. It is the event vector of the very event
     combination which made the task initially run. Typically this is just the delay timer
     event. */
-typedef void (*rtos_taskFunction_t)(uint16_t postedEventVec);
+typedef void (*rtos_taskFunction_t)(uintEventVec_t postedEventVec);
+
+#ifdef RTOS_TASK_LIST
+/** The index of each task of #RTOS_TASK_LIST is available as enumeration
+    rtos_idxTask_<taskFunction>. The tasks are numbered in the order of the list, the index
+    is the one to be used with e.g. \a rtos_getStackReserve. */
+#define RTOS_ENUM_IDX_TASK( taskFunction, prioClass, timeRoundRobin, timeDeadline          \
+                          , stackSize, startEventMask, startByAllEvents, startTimeout      \
+                          )                                                                \
+            rtos_idxTask_##taskFunction,
+enum {RTOS_TASK_LIST(RTOS_ENUM_IDX_TASK) rtos_noTasksInList};
+#undef RTOS_ENUM_IDX_TASK
+#endif
+
+/** The events of #RTOS_EVENT_LIST are enumerations of the names given in the list. Their
+    values are the bits of the events in the event vector, they are allocated in the order
+    of the list, starting with the first event, which is neither a semaphore nor a mutex.
+    Other than the events RTOS_EVT_EVENT_nn, the names can't be used in preprocessor
+    conditions. */
+#define RTOS_ENUM_IDX_EVENT(name)   rtos_idxEvt_##name,
+#define RTOS_ENUM_EVENT(name)       name = RTOS_EVT(rtos_idxEvt_##name),
+enum { rtos_idxEvtBeforeList = RTOS_NO_SEMAPHORE_EVENTS + RTOS_NO_MUTEX_EVENTS - 1
+     , RTOS_EVENT_LIST(RTOS_ENUM_IDX_EVENT)
+       rtos_idxEvtEndOfList
+     };
+enum {RTOS_EVENT_LIST(RTOS_ENUM_EVENT) rtos_evtEndOfList};
+#undef RTOS_ENUM_IDX_EVENT
+#undef RTOS_ENUM_EVENT
+
+/** The type of a work item of the deferred work queue. The function is executed by the
+    worker task; the argument is the one passed to \a rtos_postDeferredWork. */
+typedef void (*rtos_deferredWorkFunction_t)(uint16_t arg);
+
+#if RTOS_USE_TASK_STATISTICS == RTOS_FEATURE_ON
+/** The statistics of one kind of time span, which is measured in each activation of a
+    task. The unit of all time spans is the unit of the time stamps, see
+    #RTOS_TIMESTAMP_UNIT.\n
+      The histogram has logarithmic bins. A time span is divided by two to the power of
+    #RTOS_TASK_STATISTICS_SCALE first. Bin 0 counts the results null, bin i, i>0, counts
+    the results in the range [2^(i-1), 2^i). The last bin counts all greater results, too.
+    The counters saturate at their maximum value. */
+typedef struct
+{
+    /** The minimum and maximum of all time spans. If no time span has been measured yet,
+        then the minimum is greater than the maximum. */
+    uint32_t min, max;
+
+    /** The number of measured time spans per bin. */
+    uint16_t histogramAry[RTOS_TASK_STATISTICS_NO_BINS];
+
+} rtos_timeSpanStatistics_t;
+
+/** The timing statistics of a task, see \a rtos_getTaskStatistics. */
+typedef struct
+{
+    /** The release jitter is the time from the nominal due time of a regular task to the
+        point in time, when it has actually been made due. It is measured only if the task
+        has been resumed by the absolute timer. */
+    rtos_timeSpanStatistics_t releaseJitter;
+
+    /** The start latency is the time from making the task due till it becomes active. */
+    rtos_timeSpanStatistics_t startLatency;
+
+    /** The response time is the time from making the task due till it suspends again. */
+    rtos_timeSpanStatistics_t responseTime;
+
+} rtos_taskStatistics_t;
+#endif
 
 
 /*
@@ -374,20 +699,25 @@ extern uintSemaphore_t rtos_semaphoreAry[RTOS_NO_SEMAPHORE_EVENTS];
  * Global prototypes
  */
 
+#ifndef RTOS_TASK_LIST
 /* Initialze all application parameters of one task. To be called for each of the tasks in
-   setup(). */
+   setup(). Not available if the tasks are configured by #RTOS_TASK_LIST. */
 void rtos_initializeTask( uint8_t idxTask
                         , rtos_taskFunction_t taskFunction
                         , uint8_t prioClass
 #if RTOS_ROUND_ROBIN_MODE_SUPPORTED == RTOS_FEATURE_ON
                         , uintTime_t timeRoundRobin
+#endif
+#if RTOS_USE_EDF_PRIO_CLASS == RTOS_FEATURE_ON
+                        , uintTime_t timeDeadline
 #endif
                         , uint8_t * const pStackArea
                         , uint16_t stackSize
-                        , uint16_t startEventMask
+                        , uintEventVec_t startEventMask
                         , boolean startByAllEvents
                         , uintTime_t startTimeout
                         );
+#endif
 
 /** Configure and enable the interrupt which clocks the system time of RTuinOS. This
     function has a default implementation, the application may but need not to implement
@@ -411,6 +741,29 @@ extern void rtos_enableIRQUser00(void);
 extern void rtos_enableIRQUser01(void);
 #endif
 
+/** \cond Declare the application supplied callbacks, which set up the hardware to generate
+    the interrupts of #RTOS_APPL_INTERRUPT_LIST, and the top halves of these interrupts. */
+#define RTOS_DECLARE_ENABLE_FCT(vector, eventVec, enableFct)  extern void enableFct(void);
+#define RTOS_DECLARE_TOP_HALF(vector, topHalfFct, enableFct)                                \
+            extern uintEventVec_t topHalfFct(void);                                         \
+            extern void enableFct(void);
+RTOS_APPL_INTERRUPT_LIST(RTOS_DECLARE_ENABLE_FCT, RTOS_DECLARE_TOP_HALF)
+#undef RTOS_DECLARE_ENABLE_FCT
+#undef RTOS_DECLARE_TOP_HALF
+/** \endcond */
+
+#ifdef RTOS_TASK_LIST
+/** \cond Declare the application supplied task functions of #RTOS_TASK_LIST. They must not
+    be static. */
+#define RTOS_DECLARE_TASK_FCT( taskFunction, prioClass, timeRoundRobin, timeDeadline       \
+                             , stackSize, startEventMask, startByAllEvents, startTimeout   \
+                             )                                                             \
+            extern void taskFunction(uintEventVec_t postedEventVec);
+RTOS_TASK_LIST(RTOS_DECLARE_TASK_FCT)
+#undef RTOS_DECLARE_TASK_FCT
+/** \endcond */
+#endif
+
 /* Initialization of the internal data structures of RTuinOS and start of the timer
    interrupt (see void rtos_enableIRQTimerTic(void)). This function does not return but
    forks into the configured tasks.
@@ -419,15 +772,121 @@ void rtos_initRTOS(void);
 
 /* Post a set of events to the suspended tasks. Suspend the current task if the events
    resume another task of higher priority. */
-void rtos_sendEvent(uint16_t eventVec);
+void rtos_sendEvent(uintEventVec_t eventVec);
 
 /* Suspend task until a combination of events appears or a timeout elapses. */
-uint16_t rtos_waitForEvent(uint16_t eventMask, boolean all, uintTime_t timeout);
+uintEventVec_t rtos_waitForEvent( uintEventVec_t eventMask
+                                , boolean all
+                                , uintTime_t timeout
+                                );
+
+#ifdef RTOS_SCHEDULE_TABLE
+/* Suspend a time-triggered task until its next entry in the schedule table. */
+uintEventVec_t rtos_waitForNextScheduleSlot(void);
+#endif
+
+#if RTOS_USE_EVENT_DATA == RTOS_FEATURE_ON
+/* Post a set of events together with a data word for the mailbox of the receiving tasks. */
+void rtos_sendEventWithData(uintEventVec_t eventVec, uint16_t data);
+
+/* Pass a data word along with the events returned by the top half of an interrupt. */
+void rtos_setEventDataFromISR(uint16_t data);
+
+/* Suspend task like rtos_waitForEvent and get the contents of its mailbox on resume. */
+uintEventVec_t rtos_waitForEventWithData( uintEventVec_t eventMask
+                                        , boolean all
+                                        , uintTime_t timeout
+                                        , uint16_t *pData
+                                        );
+#endif
+
+#if RTOS_USE_SET_TASK_PRIORITY == RTOS_FEATURE_ON
+/* Change the priority class of a task at runtime. */
+void rtos_setTaskPriority(uint8_t idxTask, uint8_t prioClass);
+#endif
+
+#if RTOS_USE_TASK_CONTROL == RTOS_FEATURE_ON
+/* Take a task out of scheduling until it is resumed or restarted. */
+void rtos_suspendTask(uint8_t idxTask);
+
+/* Let a task, which had been taken out of scheduling, continue. */
+void rtos_resumeTask(uint8_t idxTask);
+
+/* Restart another task at the entry of its task function. */
+void rtos_restartTask(uint8_t idxTask);
+#endif
 
 /* How often could a real time task not be reactivated timely? */
 uint8_t rtos_getTaskOverrunCounter(uint8_t idxTask, boolean doReset);
 
+#if RTOS_USE_OVERRUN_POLICY == RTOS_FEATURE_ON
+/* Select the reaction of the kernel on an overrun of a regular task. */
+void rtos_setTaskOverrunPolicy(uint8_t idxTask, uint8_t overrunPolicy);
+
+/** A callback, which is invoked on an overrun of a task with policy
+    #RTOS_OVERRUN_CALL_HOOK. It is called from inside the kernel with globally disabled
+    interrupts. The function has a default implementation, the application may but need
+    not to implement it. */
+void rtos_onTaskOverrun(uint8_t idxTask);
+#endif
+
+#if RTOS_USE_TASK_STATISTICS == RTOS_FEATURE_ON
+/* Get the release jitter, start latency and response time statistics of a task. */
+void rtos_getTaskStatistics( uint8_t idxTask
+                           , rtos_taskStatistics_t *pStatistics
+                           , boolean doReset
+                           );
+#endif
+
+#if RTOS_USE_DEADLINE_MONITOR == RTOS_FEATURE_ON
+/* Set the relative deadline of a task, which is monitored in each activation. */
+void rtos_setTaskDeadline(uint8_t idxTask, uintTime_t timeDeadline);
+
+/* How often has a task not completed its activation before its deadline? */
+uint8_t rtos_getTaskDeadlineMissCounter(uint8_t idxTask, boolean doReset);
+#endif
+
 /* How many bytes of the stack of a task are still unused? */
 uint16_t rtos_getStackReserve(uint8_t idxTask);
 
+/* Get the current system time in tics. */
+uintTime_t rtos_getTime(void);
+
+#if RTOS_USE_CTC_SYSTEM_TIMER == RTOS_FEATURE_ON
+/* Get a high resolution time stamp composed of system time and timer counter. */
+uint32_t rtos_getTimestamp(void);
+#endif
+
+#if RTOS_CHECK_STACK_GUARD == RTOS_FEATURE_ON
+/** A callback, which is invoked if a task has used its stack up into the guard zone. It is
+    called from within the context switch, i.e. in interrupt context and with globally
+    disabled interrupts. The function has a default implementation, the application may
+    but need not to implement it. */
+void rtos_onStackGuardViolation(uint8_t idxTask);
+#endif
+
+#if RTOS_COUNTED_EVENT_MASK != 0
+/* Get the number of posts of a counted event since the previous query of the calling task. */
+uint8_t rtos_getNoPostedEvents(uintEventVec_t event);
+#endif
+
+#if RTOS_USE_DEFERRED_WORK == RTOS_FEATURE_ON
+/* Post a work item for later execution by the worker task. Can be called from an ISR. */
+boolean rtos_postDeferredWork(rtos_deferredWorkFunction_t workFunction, uint16_t arg);
+
+/* The task function of the worker task, which executes the deferred work items. */
+void rtos_deferredWorkTask(uintEventVec_t initialResumeCondition);
+
+/* Get the number of work items, which were lost because of a full queue. */
+uint8_t rtos_getNoLostDeferredWork(boolean doReset);
+#endif
+
+#if RTOS_INCREMENTAL_STACK_SCAN == RTOS_FEATURE_ON
+/* Advance the stack usage monitor by a few bytes. To be called from the idle task. */
+boolean rtos_scanStackReserve(uint8_t noBytes);
+
+/* How many bytes of the stack of a task were unused at the last scan? */
+uint16_t rtos_getCachedStackReserve(uint8_t idxTask);
+#endif
+
 #endif  /* RTOS_INCLUDED */
@@ -0,0 +1,314 @@
+/**
+ * @file stdout.c
+ *   stdout, the character stream used by the printf & co routines from the C standard
+ * library, is redirected into the stream Serial. Using printf, Arduino applications can
+ * communicate much easier with the console window as possible with the members of Serial
+ * for formatted writing.
+ *   The idea of the code has been found in the Arduino Forum, at
+ * http://forum.arduino.cc/index.php?topic=120440.0, visited at June 12, 2013. It has been
+ * published by an anonymous author.\n
+ *   Serial blocks if its buffer is full; a task, which writes more characters than fit
+ * into the buffer, is held in CPU wait cycles and its execution time depends on the Baud
+ * rate. Optionally, see #STDOUT_USE_RING_BUFFER, the characters are written into a large
+ * ring buffer instead and the writing task continues immediately. A task of low priority
+ * empties the buffer into Serial by regularly calling drain_stdout. If the buffer is full
+ * the character is either dropped and counted or the writing task is suspended until the
+ * draining task has made space, see #STDOUT_BLOCK_IF_FULL.\n
+ *   The module is shared by all applications. The ring buffer is configured in the
+ * application's rtos.config.h; by default it is not used.
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   init_stdout
+ *   puts_progmem
+ *   drain_stdout
+ *   getNoLostChars_stdout
+ * Local functions
+ *   serial_putchar
+ */
+
+/*
+ * Include files
+ */
+
+#include <Arduino.h>
+#include "rtos_assert.h"
+#include "rtos.h"
+#include "stdout.h"
+
+
+/*
+ * Defines
+ */
+ 
+ 
+/*
+ * Local type definitions
+ */
+ 
+ 
+/*
+ * Local prototypes
+ */
+ 
+ 
+/*
+ * Data definitions
+ */
+ 
+#if STDOUT_USE_RING_BUFFER == 1
+/** The ring buffer, which decouples the writing tasks from the Baud rate of Serial. */
+static char _ringBuffer[STDOUT_RING_BUFFER_SIZE];
+
+/** The index of the next character to write into the ring buffer. Written by the tasks,
+    which print, under mutual exclusion. */
+static volatile uint16_t _idxWrite = 0;
+
+/** The index of the next character to read from the ring buffer. Written only by the
+    draining task. */
+static volatile uint16_t _idxRead = 0;
+
+# if STDOUT_BLOCK_IF_FULL == 1
+/** The number of writing tasks, which are suspended or about to suspend because of a full
+    buffer. The draining task releases the semaphore #STDOUT_EVT_SEMAPHORE_SPACE once for
+    each of them. */
+static volatile uint8_t _noWaitingWriters = 0;
+# else
+/** The number of characters, which were dropped because of a full buffer. */
+static volatile uint16_t _noLostChars = 0;
+# endif
+#endif
+
+ 
+/*
+ * Function implementation
+ */
+
+/**
+ * This function writes a single character into Serial or into the ring buffer. It is
+ * associated with the global FILE pointer stdout, so any write access on stdout will use
+ * Serial as channel.
+ *   @return
+ * 0 if operation succeeded, 1 otherwise.
+ *   @param c
+ * The character to print.
+ *   @param f
+ * The C FILE to print to. Not used, as this function is solely associated and in use
+ * with our local FILE object.
+ *   @remark
+ * If the ring buffer is configured in blocking mode, the function must not be called from
+ * the idle task or prior to the start of RTuinOS when the buffer is full.
+ */ 
+
+static int serial_putchar(char c, FILE* f)
+{
+    ASSERT(f == stdout);
+    
+#if STDOUT_USE_RING_BUFFER == 1
+    for(;;)
+    {
+        /* Several tasks may print; the update of the write index is done under mutual
+           exclusion. The critical section is kept as short as possible. */
+        const uint8_t sreg = SREG;
+        cli();
+        uint16_t idxWrite = _idxWrite
+               , idxNext = idxWrite + 1;
+        if(idxNext >= STDOUT_RING_BUFFER_SIZE)
+            idxNext = 0;
+        if(idxNext != _idxRead)
+        {
+            _ringBuffer[idxWrite] = c;
+            _idxWrite = idxNext;
+            SREG = sreg;
+            return 0;
+        }
+# if STDOUT_BLOCK_IF_FULL == 1
+        ++ _noWaitingWriters;
+        SREG = sreg;
+
+        /* Wait until the draining task has made space in the buffer. A semaphore is used
+           rather than an ordinary event: If the draining task releases it after we left the
+           critical section but before we are suspended then the release is counted and
+           the wait returns immediately. */
+        rtos_waitForEvent( /* eventMask */ STDOUT_EVT_SEMAPHORE_SPACE
+                         , /* all */       false
+                         , /* timeout */   0
+                         );
+# else
+        SREG = sreg;
+        if(_noLostChars < 0xffffu)
+            ++ _noLostChars;
+        return 1;
+# endif
+    } /* End for(ever) */
+#else
+    /* The console requires a carriage return at any line end. Possible error information
+       is not evaluated. We'll probably get the same report in the next step anyway. */
+    if(c == '\n')
+        Serial.write('\r');
+
+    return Serial.write(c) == 1? 0 : 1;
+#endif
+    
+} /* End of serial_putchar */
+
+
+
+
+/**
+ * Initialization: The redirection of stdout into Serial, mainly for use by printf & co, is
+ * done. This needs to be done prior to the first use of stdout and it may be done prior to
+ * the initialization of Serial.
+ */
+
+void init_stdout()
+{
+    /* Create a persistent FILE object. */
+    static FILE myStdout;
+    
+    /* By default stdout, the pointer to the FILE object to use, is null, i.e. no standard
+       out is available. We let it point to our persistent FILE object. */
+    stdout = &myStdout;
+    
+    /* Initialize our FILE object ans associate it (and thus stdout) with the charater
+       write function, which will write the character into Serial. */
+    fdev_setup_stream (&myStdout, serial_putchar, NULL, _FDEV_SETUP_WRITE);
+
+} /* End of init_stdout */
+
+
+
+
+/**
+ * Write a null terminated string located in the CPU's flash ROM to stdout. End output with
+ * writing a newline character.
+ *   @return
+ * No failure is recognized and the function always returns the non-negative value 0.
+ *   @param string
+ * A pointer into the flash ROM.
+ *   @remark
+ * The function behaves like the function puts from the C library.
+ */
+
+int puts_progmem(const char *string)
+{
+    while(true)
+    {
+        char nextChar = pgm_read_byte_near(string++); 
+        if(nextChar == '\0')
+            break;
+        
+        putchar(nextChar);
+    }
+    
+    putchar('\n');
+
+    /* puts: "On success, a non-negative value is returned. On error, the function returns
+       EOF and sets the error indicator (ferror)." */
+    return 0;
+    
+} /* End of puts_progmem */
+
+
+
+
+#if STDOUT_USE_RING_BUFFER == 1
+/**
+ * Empty the ring buffer into Serial. This function needs to be called regularly by a task
+ * of low priority; it's the only reader of the buffer. The task is held in CPU wait cycles
+ * by Serial if the Baud rate doesn't permit to write all buffered characters at once, but
+ * this doesn't affect the tasks of higher priority.
+ *   @remark
+ * The function must not be called by more than one task.
+ */
+
+void drain_stdout()
+{
+    for(;;)
+    {
+        /* A 16 Bit access is not atomic; the writers could modify the index meanwhile. */
+        uint8_t sreg = SREG;
+        cli();
+        const uint16_t idxWrite = _idxWrite;
+        SREG = sreg;
+
+        uint16_t idxRead = _idxRead;
+        if(idxRead == idxWrite)
+            break;
+
+        const char c = _ringBuffer[idxRead];
+
+        /* The console requires a carriage return at any line end. Doing this here saves
+           space in the buffer. */
+        if(c == '\n')
+            Serial.write('\r');
+        Serial.write(c);
+
+        if(++idxRead >= STDOUT_RING_BUFFER_SIZE)
+            idxRead = 0;
+
+        sreg = SREG;
+        cli();
+        _idxRead = idxRead;
+# if STDOUT_BLOCK_IF_FULL == 1
+        uint8_t noWaitingWriters = _noWaitingWriters;
+        _noWaitingWriters = 0;
+# endif
+        SREG = sreg;
+
+# if STDOUT_BLOCK_IF_FULL == 1
+        /* Release the waiting writers, one semaphore count for each of them. A writer of
+           higher priority is resumed immediately and refills the buffer before we
+           continue. */
+        while(noWaitingWriters-- > 0)
+            rtos_sendEvent(STDOUT_EVT_SEMAPHORE_SPACE);
+# endif
+    } /* End for(ever) */
+
+} /* End of drain_stdout */
+
+
+
+
+# if STDOUT_BLOCK_IF_FULL != 1
+/**
+ * Get the number of characters, which could not be printed since the ring buffer was
+ * full.
+ *   @return
+ * Get the number of lost characters. The counter saturates at its implementation limit.
+ *   @param doReset
+ * If true, the counter is reset to null after reading.
+ */
+
+uint16_t getNoLostChars_stdout(boolean doReset)
+{
+    const uint8_t sreg = SREG;
+    cli();
+    uint16_t noLostChars = _noLostChars;
+    if(doReset)
+        _noLostChars = 0;
+    SREG = sreg;
+
+    return noLostChars;
+
+} /* End of getNoLostChars_stdout */
+# endif
+#endif /* STDOUT_USE_RING_BUFFER == 1 */
+
+
+
+
@@ -0,0 +1,86 @@
+#ifndef STDOUT_INCLUDED
+#define STDOUT_INCLUDED
+/**
+ * @file stdout.h
+ * Definition of global interface of module stdout.c
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Include files
+ */
+
+#include <Arduino.h>
+#include "rtos.h"
+
+
+/*
+ * Defines
+ */
+
+/** If 1, stdout writes into a ring buffer, which is emptied into Serial by a task of low
+    priority; this task regularly calls drain_stdout. The printing tasks are no longer held
+    in CPU wait cycles by Serial. If 0, stdout writes directly into Serial. An application
+    may override the default in its rtos.config.h. */
+#ifndef STDOUT_USE_RING_BUFFER
+# define STDOUT_USE_RING_BUFFER 0
+#endif
+
+/** The size of the ring buffer in Byte. One Byte of the buffer is not usable. An
+    application may override the default in its rtos.config.h. */
+#ifndef STDOUT_RING_BUFFER_SIZE
+# define STDOUT_RING_BUFFER_SIZE 1024
+#endif
+
+/** The behavior if the ring buffer is full. If 1, the writing task is suspended until the
+    draining task has made space; this requires a semaphore, which is named by
+    #STDOUT_EVT_SEMAPHORE_SPACE in the application's rtos.config.h. If 0, the character is
+    dropped and counted, see getNoLostChars_stdout. */
+#ifndef STDOUT_BLOCK_IF_FULL
+# define STDOUT_BLOCK_IF_FULL 0
+#endif
+
+#if STDOUT_USE_RING_BUFFER == 1 && STDOUT_BLOCK_IF_FULL == 1                            \
+    && !defined(STDOUT_EVT_SEMAPHORE_SPACE)
+# error Blocking stdout requires the definition of a semaphore STDOUT_EVT_SEMAPHORE_SPACE
+#endif
+
+
+/*
+ * Global type definitions
+ */
+
+
+/*
+ * Global data declarations
+ */
+
+
+/*
+ * Global prototypes
+ */
+
+void init_stdout();
+int puts_progmem(const char *string);
+#if STDOUT_USE_RING_BUFFER == 1
+void drain_stdout();
+# if STDOUT_BLOCK_IF_FULL != 1
+uint16_t getNoLostChars_stdout(boolean doReset);
+# endif
+#endif
+
+#endif  /* STDOUT_INCLUDED */
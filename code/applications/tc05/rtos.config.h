@@ -36,10 +36,13 @@
 #define RTOS_ROUND_ROBIN_MODE_SUPPORTED     RTOS_FEATURE_OFF
 
 
-/** Number of tasks in the system. Tasks aren't created dynamically. This number of tasks
-    will always be existent and alive. Permitted range is 0..127.\n
-      A runtime check is not done. The code will crash in case of a bad setting. */
-#define RTOS_NO_TASKS    3
+/** The tasks of the application. #RTOS_NO_TASKS is derived from the list; the stack areas
+    and the initialization of the tasks are generated. */
+#define RTOS_TASK_LIST(RTOS_TASK)                                                          \
+    /*        taskFunction    prio RR  EDF stack startEventMask         all    timeout */  \
+    RTOS_TASK(task00_class00, 0,   0,  0,  256,  RTOS_EVT_DELAY_TIMER,  false, 0)          \
+    RTOS_TASK(task01_class00, 0,   0,  0,  256,  RTOS_EVT_DELAY_TIMER,  false, 3)          \
+    RTOS_TASK(task00_class01, 1,   0,  0,  256,  EVT_TRIGGER_TASK00_C1, false, 5)
 
 
 /** Number of distinct priorities of tasks. Since several tasks may share the same
@@ -91,6 +94,13 @@
 #define RTOS_NO_MUTEX_EVENTS    0
 
 
+/** The events of the application. */
+#define RTOS_EVENT_LIST(RTOS_EVENT)                                                        \
+    RTOS_EVENT(EVT_TRIGGER_TASK00_C1)                                                      \
+    RTOS_EVENT(EVT_RELEASE_TASK00_C0)                                                      \
+    RTOS_EVENT(EVT_NOBODY_IS_LISTENING)
+
+
 /** Select the interrupt which clocks the system time. Side effects to consider: This
     interrupt (like all others which possibly result in a context switch) need to be
     inhibited by rtos_enterCriticalSection.\n
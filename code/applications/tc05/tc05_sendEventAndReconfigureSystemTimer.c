@@ -28,7 +28,10 @@
  * aren't any. The code in the task proves the correct task timing.\n
  *   The display of the task stack consumption is demonstrated. To prove operability the
  * task T00_C0 invokes a subroutine only after a while. The console output shows a related
- * decrease of the stack reserve.
+ * decrease of the stack reserve.\n
+ *   The tasks and the events are declared in the task and event lists in rtos.config.h.
+ * The application doesn't define the stack areas and it doesn't initialize the tasks in
+ * setup().
  *
  * Copyright (C) 2012 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
  *
@@ -49,12 +52,12 @@
  *   setup
  *   rtos_enableIRQTimerTic
  *   loop
- * Local functions
- *   blink
- *   subRoutine
  *   task00_class00
  *   task01_class00
  *   task00_class01
+ * Local functions
+ *   blink
+ *   subRoutine
  */
 
 /*
@@ -73,11 +76,6 @@
 /** Pin 13 has an LED connected on most Arduino boards. */
 #define LED 13
 
-/** Stack size of all the tasks. */
-#define STACK_SIZE_TASK00_C0   256
-#define STACK_SIZE_TASK01_C0   256
-#define STACK_SIZE_TASK00_C1   256
-
 
 /*
  * Local type definitions
@@ -88,19 +86,11 @@
  * Local prototypes
  */
 
-static void task00_class00(uint16_t postedEventVec);
-static void task01_class00(uint16_t postedEventVec);
-static void task00_class01(uint16_t postedEventVec);
-
 
 /*
  * Data definitions
  */
 
-static uint8_t _taskStack00_C0[STACK_SIZE_TASK00_C0]
-             , _taskStack01_C0[STACK_SIZE_TASK01_C0]
-             , _taskStack00_C1[STACK_SIZE_TASK00_C1];
-
 static volatile uint16_t _noLoopsIdleTask = 0;
 static volatile uint16_t _noLoopsTask00_C0 = 0;
 static volatile uint16_t _noLoopsTask01_C0 = 0;
@@ -135,13 +125,13 @@ static void blink(uint8_t noFlashes)
 
         /* Blink takes many hundreds of milli seconds. To prevent too many timeouts in
            task00_C0 we post the event also inside of blink. */
-        rtos_sendEvent(/* eventVec */ RTOS_EVT_EVENT_03);
+        rtos_sendEvent(/* eventVec */ EVT_RELEASE_TASK00_C0);
     }
 
     /* Wait for a second after the last flash - this command could easily be invoked
        immediately again and the series need to be separated. */
     delay(500);
-    rtos_sendEvent(/* eventVec */ RTOS_EVT_EVENT_03);
+    rtos_sendEvent(/* eventVec */ EVT_RELEASE_TASK00_C0);
     delay(500-TI_FLASH);
 
 #undef TI_FLASH
@@ -241,7 +231,7 @@ void rtos_enableIRQTimerTic(void)
  * A task function must never return; this would cause a reset.
  */
 
-static void task00_class00(uint16_t initCondition)
+void task00_class00(uint16_t initCondition)
 
 {
     uint32_t ti1, ti2=0;
@@ -262,7 +252,7 @@ static void task00_class00(uint16_t initCondition)
         /* Wait for an event from the idle task. The idle task is asynchrounous and its
            speed depends on the system load. The behavior is thus not perfectly
            predictable. */
-        if(rtos_waitForEvent( /* eventMask */ RTOS_EVT_EVENT_03 | RTOS_EVT_DELAY_TIMER
+        if(rtos_waitForEvent( /* eventMask */ EVT_RELEASE_TASK00_C0 | RTOS_EVT_DELAY_TIMER
                             , /* all */ false
                             , /* timeout */ 200 /*ms*/
                             )
@@ -324,7 +314,7 @@ static void task00_class00(uint16_t initCondition)
  * A task function must never return; this would cause a reset.
  */
 
-static void task01_class00(uint16_t initCondition)
+void task01_class00(uint16_t initCondition)
 
 {
     for(;;)
@@ -340,7 +330,7 @@ static void task01_class00(uint16_t initCondition)
         /* Release high priority task for a single cycle. It should continue operation
            before we return from the suspend function sendEvent. Check it. */
         u = _noLoopsTask00_C1;
-        rtos_sendEvent(/* eventVec */ RTOS_EVT_EVENT_00);
+        rtos_sendEvent(/* eventVec */ EVT_TRIGGER_TASK00_C1);
         ASSERT(u+1 == _noLoopsTask00_C1)
 
         /* Double-check that this task keep in sync with the triggered task of higher
@@ -365,10 +355,10 @@ static void task01_class00(uint16_t initCondition)
  * A task function must never return; this would cause a reset.
  */
 
-static void task00_class01(uint16_t initCondition)
+void task00_class01(uint16_t initCondition)
 
 {
-    ASSERT(initCondition == RTOS_EVT_EVENT_00)
+    ASSERT(initCondition == EVT_TRIGGER_TASK00_C1)
 
     /* This tasks cycles once when it is awaked by the event. */
     do
@@ -376,11 +366,11 @@ static void task00_class01(uint16_t initCondition)
         /* As long as we stay in the loop we didn't see a timeout. */
         ++ _noLoopsTask00_C1;
     }
-    while(rtos_waitForEvent( /* eventMask */ RTOS_EVT_EVENT_00 | RTOS_EVT_DELAY_TIMER
+    while(rtos_waitForEvent( /* eventMask */ EVT_TRIGGER_TASK00_C1 | RTOS_EVT_DELAY_TIMER
                            , /* all */ false
                            , /* timeout */ 15 /*ms*/
                            )
-          == RTOS_EVT_EVENT_00
+          == EVT_TRIGGER_TASK00_C1
          );
 
     /* We must never get here. Otherwise the test case failed. In compilation mode
@@ -395,7 +385,8 @@ static void task00_class01(uint16_t initCondition)
 
 
 /**
- * The initalization of the RTOS tasks and general board initialization.
+ * General board initialization. The RTOS tasks have already been initialized from the task
+ * list in rtos.config.h.
  */
 
 void setup(void)
@@ -408,39 +399,6 @@ void setup(void)
        operability of code. */
     pinMode(LED, OUTPUT);
 
-    /* Task 0 of priority class 0 */
-    rtos_initializeTask( /* idxTask */          0
-                       , /* taskFunction */     task00_class00
-                       , /* prioClass */        0
-                       , /* pStackArea */       &_taskStack00_C0[0]
-                       , /* stackSize */        sizeof(_taskStack00_C0)
-                       , /* startEventMask */   RTOS_EVT_DELAY_TIMER
-                       , /* startByAllEvents */ false
-                       , /* startTimeout */     0
-                       );
-
-    /* Task 1 of priority class 0 */
-    rtos_initializeTask( /* idxTask */          1
-                       , /* taskFunction */     task01_class00
-                       , /* prioClass */        0
-                       , /* pStackArea */       &_taskStack01_C0[0]
-                       , /* stackSize */        sizeof(_taskStack01_C0)
-                       , /* startEventMask */   RTOS_EVT_DELAY_TIMER
-                       , /* startByAllEvents */ false
-                       , /* startTimeout */     3
-                       );
-
-    /* Task 0 of priority class 1 */
-    rtos_initializeTask( /* idxTask */          2
-                       , /* taskFunction */     task00_class01
-                       , /* prioClass */        1
-                       , /* pStackArea */       &_taskStack00_C1[0]
-                       , /* stackSize */        sizeof(_taskStack00_C1)
-                       , /* startEventMask */   RTOS_EVT_EVENT_00
-                       , /* startByAllEvents */ false
-                       , /* startTimeout */     5
-                       );
-
 } /* End of setup */
 
 
@@ -463,11 +421,11 @@ void loop(void)
     ++ _noLoopsIdleTask;
 
     /* An event can be posted even if nobody is listening for it. */
-    rtos_sendEvent(/* eventVec */ RTOS_EVT_EVENT_04);
+    rtos_sendEvent(/* eventVec */ EVT_NOBODY_IS_LISTENING);
 
     /* This event will release task 0 of class 0. However we do not get here again fast
        enough to avoid all timeouts in that task. */
-    rtos_sendEvent(/* eventVec */ RTOS_EVT_EVENT_03);
+    rtos_sendEvent(/* eventVec */ EVT_RELEASE_TASK00_C0);
 
     Serial.println("RTuinOS is idle");
     Serial.print("noLoopsIdleTask: "); Serial.println(_noLoopsIdleTask);
@@ -488,7 +446,7 @@ void loop(void)
 
         /* The RTuinOS task overrun counter is not reliable for very slow tasks. We've
            implemented our own counter inside the task function of the slow task task00_C0. */
-        if(idxStack == 0)
+        if(idxStack == rtos_idxTask_task00_class00)
             Serial.println(_task00_C0_trueTaskOverrunCnt);
         else
             Serial.println(rtos_getTaskOverrunCounter(idxStack, /* doReset */ false));
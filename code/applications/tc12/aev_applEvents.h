@@ -34,10 +34,13 @@
 #define EVT_SEMAPHORE_ELEM_IN_QUEUE     (RTOS_EVT_SEMAPHORE_00)
 
 /** A mutex is used synchronize the access to the terminal output for reporting. */
-#define EVT_MUTEX_SERIAL                (RTOS_EVT_MUTEX_01)
+#define EVT_MUTEX_SERIAL                (RTOS_EVT_MUTEX_02)
 
 /** This event is sent by the irregular idle task to trigger the queue reading task. */
-#define EVT_TRIGGER_CONSUMER_TASK       (RTOS_EVT_EVENT_02)
+#define EVT_TRIGGER_CONSUMER_TASK       (RTOS_EVT_EVENT_03)
+
+/* The second semaphore, RTOS_EVT_SEMAPHORE_01, is used by stdout; it releases a task,
+   which waits for space in the ring buffer. See rtos.config.h. */
 
 
 /*
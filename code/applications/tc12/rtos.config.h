@@ -39,14 +39,14 @@
 /** Number of tasks in the system. Tasks aren't created dynamically. This number of tasks
     will always be existent and alive. Permitted range is 0..127.\n
       A runtime check is not done. The code will crash in case of a bad setting. */
-#define RTOS_NO_TASKS    2
+#define RTOS_NO_TASKS    3
 
 
 /** Number of distinct priorities of tasks. Since several tasks may share the same
     priority, this number is lower or equal to NO_TASKS. Permitted range is 0..NO_TASKS,
     but 1..NO_TASKS if at least one task is defined.\n
       A runtime check is not done. The code will crash in case of a bad setting. */
-#define RTOS_NO_PRIO_CLASSES 2
+#define RTOS_NO_PRIO_CLASSES 3
 
 
 /** Since many tasks will belong to distinct priority classes, the maximum number of tasks
@@ -79,7 +79,7 @@
     and efficient for the application the array of semaphores is declared extern to
     RTuinOS. Please refer to rtos.h for the declaration of \a rtos_semaphoreAry and define
     \b and \b initialize this array in your application code. */
-#define RTOS_NO_SEMAPHORE_EVENTS    1
+#define RTOS_NO_SEMAPHORE_EVENTS    2
 
 
 /** The number of events, which behave like mutexes. When posted, they are not broadcasted
@@ -290,6 +290,21 @@ RTOS_DEFINE_TYPE_OF_SYSTEM_TIME(8)
 #define RTOS_OVERRUN_TASK_IS_IMMEDIATELY_DUE  RTOS_FEATURE_ON
 
 
+/** The console output of this application is written into the ring buffer of stdout,
+    which is emptied into Serial by a task of lowest priority. See stdout.h. */
+#define STDOUT_USE_RING_BUFFER  1
+
+/** The size of the ring buffer of stdout in Byte. */
+#define STDOUT_RING_BUFFER_SIZE 1024
+
+/** A task, which prints into the full ring buffer, is suspended until the draining task
+    has made space. */
+#define STDOUT_BLOCK_IF_FULL    1
+
+/** The semaphore, which a task waits for when it prints into the full ring buffer. */
+#define STDOUT_EVT_SEMAPHORE_SPACE  (RTOS_EVT_SEMAPHORE_01)
+
+
 #if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
 /** The implementation of a semaphore is a simple unsigned integer. The value means the
     number of resources managed by the semaphore. In a resource management system it may be
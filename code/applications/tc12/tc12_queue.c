@@ -19,7 +19,10 @@
  * alternating access to the console output: Both tasks write their progress messages into
  * Serial. Caution, this is not an example of proper code design but just to make it more
  * complex and a better test case. The mutual exclusion from the serial output degrades the
- * accurate timing of the basically regular consumer task.
+ * accurate timing of the basically regular consumer task.\n
+ *   The many printf statements don't block the tasks: stdout writes into a ring buffer,
+ * which is emptied into Serial by a third task of lowest priority. See rtos.config.h
+ * for the configuration.
  *   @remark: This application produces a lot of screen output and requires a terminal Baud
  * rate higher then the standard setting. It'll produce a lot of trash in the Arduino
  * console window if you do not switch the Baud rate in Arduino's Serial Monitor to 115200
@@ -54,6 +57,7 @@
  *   taskT0C0_producer
  *   tC0C0
  *   taskT0C1_consumer
+ *   taskDrainStdout
  */
 
 /*
@@ -90,7 +94,7 @@
 
 /** The indexes of the tasks are named to make index based API functions of RTuinOS safely
     usable. */
-enum {_idxTaskT0C0, _idxTaskT0C1, _noTasks};
+enum {_idxTaskT0C0, _idxTaskT0C1, _idxTaskDrainStdout, _noTasks};
 
 
 /*
@@ -104,6 +108,7 @@ enum {_idxTaskT0C0, _idxTaskT0C1, _noTasks};
  
 static void taskT0C1_consumer(uint16_t initCondition);
 static void tT0C0(uint16_t initCondition);
+static void taskDrainStdout(uint16_t initCondition);
  
  
 /*
@@ -111,7 +116,8 @@ static void tT0C0(uint16_t initCondition);
  */
  
 static uint8_t _taskStackT0C1[STACK_SIZE]
-             , _taskStackT0C0[STACK_SIZE];
+             , _taskStackT0C0[STACK_SIZE]
+             , _taskStackDrainStdout[STACK_SIZE];
              
              
 /** The CPU load as computed in the idle task. A shared global variable is used because it is
@@ -120,13 +126,14 @@ static uint8_t _taskStackT0C1[STACK_SIZE]
 static volatile uint8_t _cpuLoad = 200;
  
  
-/** The semaphore of type uint8_t counts the number of samples in the queue, which are
-    already produced but not yet consumed. The start value needs to be null.
+/** The first semaphore of type uint8_t counts the number of samples in the queue, which
+    are already produced but not yet consumed. The second one is used by stdout to release
+    tasks, which wait for space in the ring buffer. The start values need to be null.
       @remark Although this variable is shared between tasks and although its value is
    shared by others tasks it must not be declared as volatile. Actually, no task will
    directly read or write to this variable, tasks do this only indirectly by calling the
    related RTuinOS API functions - and to the RTuinOS code the variable is not volatile. */
-uintSemaphore_t rtos_semaphoreAry[RTOS_NO_SEMAPHORE_EVENTS] = {0};
+uintSemaphore_t rtos_semaphoreAry[RTOS_NO_SEMAPHORE_EVENTS] = {0, 0};
 
 
 /*
@@ -321,6 +328,32 @@ static void taskT0C1_consumer(uint16_t eventToWaitForVec)
 
 
 
+/**
+ * The task of lowest priority, which empties the ring buffer of stdout into Serial. It is
+ * held in CPU wait cycles by Serial as long as the buffer contains more characters than
+ * Serial can take but this doesn't hinder the other tasks.
+ *   @param initCondition
+ * The task gets the vector of events, which made it initially due.
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */ 
+
+static void taskDrainStdout(uint16_t initCondition)
+{
+    do
+    {
+        drain_stdout();
+    }
+    while(rtos_delay(TIME_IN_MS(10)));
+
+    /* A task function must never return; this would cause a reset. */
+    ASSERT(false);
+
+} /* End of taskDrainStdout */
+
+
+
+
 /**
  * The initialization of the RTOS tasks and general board initialization.
  */ 
@@ -336,11 +369,11 @@ void setup(void)
 
     ASSERT(_noTasks == RTOS_NO_TASKS);
 
-    /* Configure task 0 of priority class 0. The producer has the lower priority. It is
+    /* Configure task 0 of priority class 1. The producer has the lower priority. It is
        started immediately. */
     rtos_initializeTask( /* idxTask */          _idxTaskT0C0
                        , /* taskFunction */     tT0C0
-                       , /* prioClass */        0
+                       , /* prioClass */        1
                        , /* pStackArea */       &_taskStackT0C0[0]
                        , /* stackSize */        sizeof(_taskStackT0C0)
                        , /* startEventMask */   RTOS_EVT_DELAY_TIMER
@@ -348,17 +381,29 @@ void setup(void)
                        , /* startTimeout */     0
                        );
 
-    /* Configure task 0 of priority class 1. The consumer has the higher priority. It is
+    /* Configure task 0 of priority class 2. The consumer has the higher priority. It is
        started by: Data available AND access to object Serial granted. */
     rtos_initializeTask( /* idxTask */          _idxTaskT0C1
                        , /* taskFunction */     taskT0C1_consumer
-                       , /* prioClass */        1
+                       , /* prioClass */        2
                        , /* pStackArea */       &_taskStackT0C1[0]
                        , /* stackSize */        sizeof(_taskStackT0C1)
                        , /* startEventMask */   RTOS_EVT_DELAY_TIMER
                        , /* startByAllEvents */ false
                        , /* startTimeout */     10
                        );
+
+    /* Configure the only task of priority class 0. The task, which empties the buffer of stdout
+       into Serial, has the lowest priority. */
+    rtos_initializeTask( /* idxTask */          _idxTaskDrainStdout
+                       , /* taskFunction */     taskDrainStdout
+                       , /* prioClass */        0
+                       , /* pStackArea */       &_taskStackDrainStdout[0]
+                       , /* stackSize */        sizeof(_taskStackDrainStdout)
+                       , /* startEventMask */   RTOS_EVT_DELAY_TIMER
+                       , /* startByAllEvents */ false
+                       , /* startTimeout */     0
+                       );
 } /* End of setup */
 
 
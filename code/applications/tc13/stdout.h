@@ -1,50 +0,0 @@
-#ifndef STDOUT_INCLUDED
-#define STDOUT_INCLUDED
-/**
- * @file tc13/stdout.h
- * Definition of global interface of module stdout.c
- *
- * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
- *
- * This program is free software: you can redistribute it and/or modify it
- * under the terms of the GNU Lesser General Public License as published by the
- * Free Software Foundation, either version 3 of the License, or any later
- * version.
- *
- * This program is distributed in the hope that it will be useful, but WITHOUT
- * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
- * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
- * for more details.
- *
- * You should have received a copy of the GNU Lesser General Public License
- * along with this program. If not, see <http://www.gnu.org/licenses/>.
- */
-
-/*
- * Include files
- */
-
-
-/*
- * Defines
- */
-
-
-/*
- * Global type definitions
- */
-
-
-/*
- * Global data declarations
- */
-
-
-/*
- * Global prototypes
- */
-
-void init_stdout();
-int puts_progmem(const char *string);
-
-#endif  /* STDOUT_INCLUDED */
@@ -1,6 +1,9 @@
 /**
  * @file adc_analogInput.cpp
- *   The ADC task code: Process the analog input.
+ *   The ADC task code: Process the analog input. The conversion complete interrupt has a
+ * short top half, which only reads the conversion result and posts its processing as a
+ * deferred work item. The ADC task is the worker task of the deferred work queue,
+ * rtos_deferredWorkTask, which executes the item.
  *
  * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
  *
@@ -20,9 +23,11 @@
 /* Module interface
  *   adc_initAfterPowerUp
  *   adc_nextInput
- *   adc_onConversionComplete
+ *   adc_onConversionCompleteTopHalf
+ *   adc_getResult
  * Local functions
  *   selectAdcInput
+ *   onConversionComplete
  */
 
 /*
@@ -31,6 +36,8 @@
 
 #include <Arduino.h>
 #include "rtos.h"
+#include "rtos_assert.h"
+#include "dcf_decimationFilter.h"
 #include "aev_applEvents.h"
 #include "dpy_display.h"
 #include "adc_analogInput.h"
@@ -40,11 +47,35 @@
  * Defines
  */
  
+/** Transform a linear input number 0..15 into the binary format, which is written
+    directly into the ADC register MUX5:0: Two null bits are inserted at position b3 and
+    b4. */
+#define MUX_OF_INPUT(input)     ((((input) & 0x8) << 2) + ((input) & 0x7))
+
 
 /*
  * Local type definitions
  */
  
+/** The static configuration of a channel of the scan sequence. */
+typedef struct
+{
+    /** The number of subsequent conversion results, which are filtered to form the
+        result of the channel. This is the decimation ratio of the channel's filter. The
+        value needs to be a power of two in the range 1..64. */
+    uint8_t noOversampledSamples;
+
+    /** The order of the CIC decimation filter of the channel, 1..#DCF_MAX_ORDER.
+        #DCF_ORDER_BOXCAR means to simply sum up the samples. Higher orders improve the
+        anti-aliasing but delay the response to input changes. */
+    uint8_t filterOrder;
+
+    /** The channel is measured only in every n-th scan, n being this value. In the other
+        scans it is skipped and keeps its previous result. The range is 1..255. */
+    uint8_t decimation;
+
+} channelConfig_t;
+
  
 /*
  * Local prototypes
@@ -59,11 +90,42 @@
     should be about 960 Hz. */
 volatile uint32_t adc_noAdcResults = 0;
 
-/** The voltage at the buton input. */
-volatile uint16_t adc_buttonVoltage = 0;
-
-/** The voltage measured at the user selected analog input, see \a _userSelectedInput. */
-volatile uint16_t adc_inputVoltage = 0;
+/** The configuration of the scan sequence. The channels are measured in the order of this
+    table. The first channel is the button input; it needs to be measured in every scan.
+    The sum of the samples of all channels in a scan determines the rate of the event
+    #EVT_ADC_SCAN_COMPLETE; with 2*32 samples it is about 15 Hz. */
+static const channelConfig_t _channelConfigAry[ADC_NO_CHANNELS] =
+    { /* ADC_IDX_CHANNEL_BUTTONS */    {ADC_NO_AVERAGED_SAMPLES, DCF_ORDER_BOXCAR, 1}
+    , /* ADC_IDX_CHANNEL_USER_INPUT */ {ADC_NO_AVERAGED_SAMPLES, /* filterOrder */ 2, 1}
+    };
+
+/** The ADC input per channel as value of the ADC register MUX5:0. The entry of the user
+    selected input is written by another task, see adc_nextInput.
+      @remark The initial value of the user selected input must be chosen in close
+    correspondence with the variable \a _userSelectedInputLin. */
+static volatile uint8_t _muxAry[ADC_NO_CHANNELS] =
+    { /* ADC_IDX_CHANNEL_BUTTONS */    MUX_OF_INPUT(ADC_INPUT_LCD_SHIELD_BUTTONS)
+    , /* ADC_IDX_CHANNEL_USER_INPUT */ ADC_INPUT_INTERNAL_BAND_GAP
+    };
+
+/** The count down of the decimation per channel. The channel is measured in the scan,
+    in which its counter reaches null. */
+static uint8_t _decimationCntAry[ADC_NO_CHANNELS];
+
+/** The decimation filter per channel. A filter only sees the samples of its channel. */
+static dcf_filter_t _filterAry[ADC_NO_CHANNELS];
+
+/** The number of Bits the filter result of a channel is shifted to the right. The
+    normalization makes the result independent of the filter order: It is the sum of
+    #ADC_NO_AVERAGED_SAMPLES samples for all channels. */
+static uint8_t _resultShiftAry[ADC_NO_CHANNELS];
+
+/** The results of the channels. The ADC task fills the back buffer while the clients read
+    the front buffer. The buffers are swapped at the end of each scan. */
+static uint16_t _resultAry[2][ADC_NO_CHANNELS];
+
+/** The index of the front buffer in \a _resultAry. */
+static uint8_t _idxFrontBuffer = 0;
 
 /** The user selected ADC input as a linear number between 0 and 16. (16 references the
     internal band gap voltage reference as ADC input.
@@ -74,15 +136,6 @@ volatile uint16_t adc_inputVoltage = 0;
     and must never be changed. */
 static uint8_t _userSelectedInputLin = 16;
 
-/** The user selected ADC input. Caution, the value is expected as can be written directly
-    into the ADC register MUX5:0. The numbers of the normal inputs in the range 0..15 are
-    split by two inserted null bits at position b3 and b4 and the internal band gap
-    reference is selected by the constant 0x1e.
-      @remark The initial value must be chosen in close correspondence with the other
-    variable \a _userSelectedInputLin. */
-static volatile uint8_t _userSelectedInputMux = ADC_INPUT_INTERNAL_BAND_GAP;
-
-
 /*
  * Function implementation
  */
@@ -120,15 +173,40 @@ static void selectAdcInput(uint8_t input)
 
 void adc_initAfterPowerUp()
 {
+    /* The sequencer relies on a scan, which always begins with the button input. */
+    ASSERT(ADC_IDX_CHANNEL_BUTTONS == 0  &&  _channelConfigAry[0].decimation == 1);
+
+    /* All channels are measured in the first scan. */
+    uint8_t idxChannel;
+    for(idxChannel=0; idxChannel<ADC_NO_CHANNELS; ++idxChannel)
+    {
+        const channelConfig_t * const pConfig = &_channelConfigAry[idxChannel];
+        const uint8_t R = pConfig->noOversampledSamples;
+
+        /* R needs to be a power of two and the filter result needs to fit into the 16 Bit
+           result after normalization. */
+        ASSERT(R >= 1  &&  R <= 64  &&  (R & (R-1)) == 0  &&  pConfig->decimation >= 1);
+        _decimationCntAry[idxChannel] = 1;
+
+        dcf_initFilter(&_filterAry[idxChannel], pConfig->filterOrder, R);
+
+        /* The gain of the filter is R^N. Normalize it to R, i.e. shift by (N-1)*log2(R). */
+        uint8_t log2R = 0;
+        while((1u << log2R) < R)
+            ++ log2R;
+        _resultShiftAry[idxChannel] = (pConfig->filterOrder - 1) * log2R;
+        ASSERT(10 + pConfig->filterOrder*log2R <= 32);
+    }
+
     /* Setup the ADC configuration. */
 
     /* ADMUX */
 #define VAL_ADLAR   0    /* ADLAR: Result must not be left aligned. */
 
-/** The initial setting for register MUX needs be be the button input in order to be inline
-    with the initialization of the state machine doing the result evaluation, see void
-    adc_onConversionComplete(void). */
-#define VAL_MUX ((((ADC_INPUT_LCD_SHIELD_BUTTONS) & 0x8) << 2) + ((ADC_INPUT_LCD_SHIELD_BUTTONS) & 0x7))
+/** The initial setting for register MUX needs be be the first channel of the scan
+    sequence, the button input, in order to be inline with the initialization of the
+    sequencer, see void onConversionComplete(uint16_t). */
+#define VAL_MUX MUX_OF_INPUT(ADC_INPUT_LCD_SHIELD_BUTTONS)
 
     ADMUX = (ADC_VAL_ADMUX_REFS << 6)
             + (VAL_ADLAR << 5)
@@ -206,21 +284,17 @@ void adc_nextInput(boolean up)
 
     /* Transform the linear input number into the binary format, which can be used directly
        at run time, when the input is selected.
-         The variable _userSelectedInput is read by the ADC task without access
+         The MUX value of the channel is read by the ADC task without access
        synchronization. It can be safely written by other tasks as as long as we use a
        single simple 8 Bit write operation. Therefore we need an intermediate variable. */
     uint8_t tmpMux;
     if(_userSelectedInputLin == 16)
         tmpMux = ADC_INPUT_INTERNAL_BAND_GAP;
     else
-    {
-        /* Insert two null bits into the binary number to make it the valid 6 Bit MUX
-           value. */
-        tmpMux = ((_userSelectedInputLin & 0x8) << 2) + (_userSelectedInputLin & 0x7);
-    }
+        tmpMux = MUX_OF_INPUT(_userSelectedInputLin);
 
     /* Now write to the target variable in an atomic operation. */
-    _userSelectedInputMux = tmpMux;
+    _muxAry[ADC_IDX_CHANNEL_USER_INPUT] = tmpMux;
 
     /* Display selection of new ADC input. */
     dpy_display.printAdcInput(_userSelectedInputLin);
@@ -231,73 +305,143 @@ void adc_nextInput(boolean up)
 
 
 /**
- * The main function of the ADC task: It is the handler for the conversion complete
- * interrupt. It reads the new input sample from the ADC registers and processes it.
+ * The main function of the ADC task: It is the deferred work item, which is posted by the
+ * top half of the conversion complete interrupt. It processes the new input sample.
  * Processing means to do some averaging as a kind of simple down sampling and notify the
  * sub-sequent, slower running clients of the data.\n
- *   There are two kinds of data and two related clients: The analog input 0, which the LCD
- * shield's buttons are connected to, is read regularly and the input values are passed to
- * the button evaluation task, which implements the user interface state machine.\n
- *   A user selected ADC input is measured and converted to Volt. The client of this
- * information is a simple display task.
+ *   The channels are measured in a cyclic scan sequence, which is defined by table \a
+ * _channelConfigAry. Each channel filters and decimates its own number of samples and may
+ * be skipped in some scans by decimation. The filter is a CIC filter of configurable
+ * order, see dcf_decimationFilter.c. The results are collected in a back buffer; at the
+ * end of a scan the buffers are swapped and all clients are notified by a single
+ * broadcasted event, #EVT_ADC_SCAN_COMPLETE. They read the results with adc_getResult.\n
+ *   Channel #ADC_IDX_CHANNEL_BUTTONS is the analog input 0, which the LCD shield's
+ * buttons are connected to. Its result is evaluated by the button task, which implements
+ * the user interface state machine. Channel #ADC_IDX_CHANNEL_USER_INPUT is a user
+ * selected ADC input; its result is converted to Volt and displayed.
+ *   @param adcResult
+ * The conversion result as read from the ADC by the top half of the interrupt.
  */
 
-void adc_onConversionComplete()
+static void onConversionComplete(uint16_t adcResult)
 {
-    /* We need a state machine here. There are two alternating series of conversions: Read
-       the LCD shield's button input every first time and the "true", user selected input
-       every second time.
-         Averaging: Each series accumulates 64 samples. */
-    static boolean readButton_ = true;
-    static uint16_t accumuatedAdcResult_ = 0;
-    static uint8_t noMean_ = ADC_NO_AVERAGED_SAMPLES;
-    
-    /* Accumulate all samples of the running series. Add the new ADC conversion result.
-       First read ADCL then ADCH. Two statements are needed as it is not guaranteed in
-       which order an expression a+b is evaluated. */
-    accumuatedAdcResult_ += ADCL;
-    accumuatedAdcResult_ += (ADCH<<8);
-
-    /* Accumulate up to 64 values to do averaging and anti-aliasing for slower reporting
-       task. */
-    if(--noMean_ == 0)
+    static uint8_t idxChannel_ = 0;
+
+#ifdef DEBUG
+    /* Test: Our ADC interrupt should be synchronous with Arduino's TIMER0_OVF (see
+       wiring.c). No conversion result must have been lost on the way through the deferred
+       work queue. */
+    extern volatile unsigned long timer0_overflow_count;
+    static uint32_t deltaCnt_ = 0;
+    if(adc_noAdcResults == 0)
+        deltaCnt_ = timer0_overflow_count;
+    ASSERT(adc_noAdcResults + deltaCnt_ == timer0_overflow_count);
+    ASSERT(rtos_getNoLostDeferredWork(/* doReset */ false) == 0);
+#endif
+
+    /* Filter the configured number of values to do anti-aliasing for slower reporting
+       tasks. Most invocations end here. */
+    uint32_t filterResult;
+    if(dcf_filterSample(&_filterAry[idxChannel_], adcResult, &filterResult))
     {
-        /* A new down-sampled result is available for one of our clients. Since the clients
-           have a lower priority as this task we don't need a critical section to update
-           the client's input. */
-        if(readButton_)
+        /* A new down-sampled result is available for the current channel. The clients
+           don't read the back buffer, no critical section is required. */
+        const uint8_t idxBackBuffer = _idxFrontBuffer ^ 1;
+        _resultAry[idxBackBuffer][idxChannel_] =
+                                    (uint16_t)(filterResult >> _resultShiftAry[idxChannel_]);
+
+        /* Advance to the next channel, which is due in the running scan. A channel, which
+           is skipped due to its decimation, inherits its previous result. The first
+           channel is due in every scan, so the loop ends at the latest with the
+           wrap-around to the next scan. */
+        boolean isScanComplete = false;
+        while(true)
         {
-            /* New ADC input is the user selected input. We do this as early as possible in
-               the processing here, to have it safely completed before the next conversion
-               start interrupt fires. */
-            selectAdcInput(_userSelectedInputMux);
-            
-            /* Notify the new result to the button evaluation task. */
-            adc_buttonVoltage = accumuatedAdcResult_;
-            rtos_sendEvent(EVT_TRIGGER_TASK_BUTTON);
+            if(++idxChannel_ >= ADC_NO_CHANNELS)
+            {
+                idxChannel_ = 0;
+                isScanComplete = true;
+            }
+            if(--_decimationCntAry[idxChannel_] == 0)
+                break;
+            _resultAry[idxBackBuffer][idxChannel_] = _resultAry[idxBackBuffer^1][idxChannel_];
         }
-        else
+
+        /* Select the new ADC input. We do this as early as possible in the processing
+           here, to have it safely completed before the next conversion start interrupt
+           fires. */
+        selectAdcInput(_muxAry[idxChannel_]);
+        _decimationCntAry[idxChannel_] = _channelConfigAry[idxChannel_].decimation;
+
+        /* Publish the completed scan. The clients have a lower priority as this task and
+           they can't run before this function has completed. */
+        if(isScanComplete)
         {
-            /* New ADC input is the user selected input. We do this as early as possible in
-               the processing here, to have it safely completed before the next conversion
-               start interrupt fires. */
-            selectAdcInput(ADC_INPUT_LCD_SHIELD_BUTTONS);
-           
-            /* Notify the new result to the button evaluation task. */
-            adc_inputVoltage = accumuatedAdcResult_;
-            rtos_sendEvent(EVT_TRIGGER_TASK_DISPLAY_VOLTAGE);
+            _idxFrontBuffer = idxBackBuffer;
+            rtos_sendEvent(EVT_ADC_SCAN_COMPLETE);
         }
-
-        /* Start next series on averaged samples. */
-        readButton_ = !readButton_;
-        noMean_ = ADC_NO_AVERAGED_SAMPLES;
-        accumuatedAdcResult_ = 0;
     }
         
     /* Count the read cycles. The frequency should be about 960 Hz. */
     ++ adc_noAdcResults;
 
-} /* End of adc_onConversionComplete */
+} /* End of onConversionComplete */
+
+
+
+
+/**
+ * The top half of the ADC conversion complete interrupt, see #RTOS_APPL_INTERRUPT_LIST in
+ * rtos.config.h. It reads the new conversion result from the ADC registers and posts its
+ * processing as deferred work item. The time spent with globally disabled interrupts is
+ * reduced to reading the hardware and posting the item.
+ *   @return
+ * Get the event, which wakes the worker task of the deferred work queue.
+ */
+
+uintEventVec_t adc_onConversionCompleteTopHalf()
+{
+    /* Read the new ADC conversion result. First read ADCL then ADCH. Two statements are
+       needed as it is not guaranteed in which order an expression a+b is evaluated. */
+    uint16_t adcResult = ADCL;
+    adcResult += (ADCH<<8);
+
+    /* A result, which doesn't fit into the queue, is lost. This is counted by the kernel
+       and checked in DEBUG compilation by the work item. */
+    rtos_postDeferredWork(onConversionComplete, adcResult);
+
+    return EVT_DEFERRED_WORK;
+
+} /* End of adc_onConversionCompleteTopHalf */
+
+
+
+
+/**
+ * Get the result of a channel from the last recent completed scan.
+ *   @return
+ * Get the accumulated ADC conversion results of the channel. The value is the sum of as
+ * many samples as configured for the channel.
+ *   @param idxChannel
+ * The index of the channel in the scan sequence, e.g. #ADC_IDX_CHANNEL_BUTTONS.
+ *   @remark
+ * The function can be called by tasks of same or lower priority as the ADC task. It
+ * doesn't touch the global interrupt enable flag and may be used inside a critical
+ * section. Two subsequent calls may see the results of different scans.
+ */
+
+uint16_t adc_getResult(uint8_t idxChannel)
+{
+    ASSERT(idxChannel < ADC_NO_CHANNELS);
+
+    const uint8_t sreg = SREG;
+    cli();
+    const uint16_t result = _resultAry[_idxFrontBuffer][idxChannel];
+    SREG = sreg;
+
+    return result;
+
+} /* End of adc_getResult */
 
 
 
@@ -32,22 +32,48 @@
  * Defines
  */
 
-/** Scaling from binary ADC results to voltage (e.g. adc_buttonVoltage) in V. worldValue =
+/** Scaling from binary ADC results to voltage (e.g. adc_getResult(ADC_IDX_CHANNEL_BUTTONS)) in V. worldValue =
     #ADC_SCALING_BIN_TO_V(binaryValue) [V]. */
 #define ADC_SCALING_BIN_TO_V(binVal)                                                        \
             ((ADC_U_REF/(double)(ADC_NO_AVERAGED_SAMPLES)/1024.0)*(double)(binVal))
 
+/** Scaling from binary ADC results to voltage in mV. The conversion is done in fixed point
+    arithmetics with a binary scaling of the factor of 2^16; the double operations are
+    limited to the compile time. worldValue = #ADC_SCALING_BIN_TO_MV(binaryValue) [mV]. */
+#define ADC_SCALING_BIN_TO_MV(binVal)                                                       \
+        ((uint16_t)(((uint32_t)(binVal)                                                     \
+                     * (uint32_t)(ADC_U_REF*1000.0*65536.0                                  \
+                                  / (double)(ADC_NO_AVERAGED_SAMPLES) / 1024.0 + 0.5        \
+                                 )                                                          \
+                     + 0x8000ul                                                             \
+                    ) >> 16                                                                 \
+                   )                                                                        \
+        )
+
 /** Do not change: The ADC input which the buttons of the LCD shield are connected to. */
 #define ADC_INPUT_LCD_SHIELD_BUTTONS    0
 
+/** The number of channels in the scan sequence, see table _channelConfigAry in
+    adc_analogInput.cpp. Up to 16 channels are possible. */
+#define ADC_NO_CHANNELS                 2
+
+/** The index of the channel, which measures the button input, in the scan sequence. */
+#define ADC_IDX_CHANNEL_BUTTONS         0
+
+/** The index of the channel, which measures the user selected input, in the scan
+    sequence. */
+#define ADC_IDX_CHANNEL_USER_INPUT      1
+
 /** The selection of the internal reference voltage 1.1 V as ADC input as compatible with
     variable \a adc_userSelectedInput. */
 #define ADC_INPUT_INTERNAL_BAND_GAP 0x1e
 
 /** The number of subsequent ADC conversion results, which are averaged before the mean
-    value is passed to the waiting client tasks. The values 1..64 are possible. The smaller
-    the value the higher the overhead of the task processing. A value greater than about 40
-    leads to a significant degradation of the responsiveness to button down events. */
+    value is passed to the waiting client tasks. The powers of two 1..64 are possible. The
+    smaller the value the higher the overhead of the task processing. A value greater than
+    about 40 leads to a significant degradation of the responsiveness to button down
+    events.\n
+      The value is the oversampling factor of both channels of the scan sequence. */
 #define ADC_NO_AVERAGED_SAMPLES     32
 
 /** Value of ADC register ADMUX/REFS1:0. It selects the reference voltage or full scale
@@ -86,22 +112,6 @@
 extern volatile uint32_t adc_noAdcResults;
 
 
-/** The voltage measured at analog input #ADC_INPUT_LCD_SHIELD_BUTTONS which the buttons of
-    the LCD shield are connected to. Scaling: worldValue = 5/1024/#ADC_NO_AVERAGED_SAMPLES
-    * \a adc_buttonVoltage [V].
-      @remark The values are written by the ADC task without access synchronization. They
-    can be safely read only by tasks of same or lower priority and the latter need a
-    critical section to do so. */
-extern volatile uint16_t adc_buttonVoltage;
-
-
-/** The voltage measured at the user selected analog input, see \a adc_userSelectedInput.
-    Scaling: worldValue = 5/1024/#ADC_NO_AVERAGED_SAMPLES * \a adc_inputVoltage [V].
-      @remark The values are written by the ADC task without access synchronization. They
-    can be safely read only by tasks of same or lower priority and the latter need a
-    critical section to do so. */
-extern volatile uint16_t adc_inputVoltage;
-
 
 /*
  * Global prototypes
@@ -114,8 +124,11 @@ void adc_initAfterPowerUp();
 /** Select the next or previous input for the next conversion. */
 void adc_nextInput(boolean up);
 
-/** Main function of ADC task. Process next conversion result. */
-void adc_onConversionComplete();
+/** Top half of the ADC conversion complete interrupt. Post the processing of the result. */
+uintEventVec_t adc_onConversionCompleteTopHalf();
+
+/** Get the result of a channel from the last recent completed scan. */
+uint16_t adc_getResult(uint8_t idxChannel);
 
 
 #endif  /* ADC_ANALOGINPUT_INCLUDED */
@@ -35,18 +35,15 @@
 /** A mutex is applied to share the display between different tasks. */
 #define EVT_MUTEX_LCD                       (RTOS_EVT_MUTEX_00)
 
-/** An ordinary event is used to trigger the idle-follower task, which is capable to
-    acquire the display for displaying the results of the idle task. */
-#define EVT_TRIGGER_IDLE_FOLLOWER_TASK      (RTOS_EVT_EVENT_01)
-
-/** An ordinary event is used to trigger the button evaluation task. */
-#define EVT_TRIGGER_TASK_BUTTON             (RTOS_EVT_EVENT_02)
-
-/** An ordinary event is used to trigger the ADC result display task. */
-#define EVT_TRIGGER_TASK_DISPLAY_VOLTAGE    (RTOS_EVT_EVENT_03)
-
-/** A simple event is used to signal a new ADC conversion result. */
-#define EVT_ADC_CONVERSION_COMPLETE         (RTOS_EVT_ISR_USER_00)
+/* The ordinary events are declared in RTOS_EVENT_LIST in rtos.config.h, so that the task
+   list can refer to them:
+     EVT_TRIGGER_IDLE_FOLLOWER_TASK is used to trigger the idle-follower task, which is
+   capable to acquire the display for displaying the results of the idle task.
+     EVT_ADC_SCAN_COMPLETE is a broadcasted event, which signals the completion of a scan
+   of all ADC channels. It triggers the button evaluation task and the ADC result display
+   task.
+     EVT_DEFERRED_WORK wakes the worker task of the deferred work queue, which processes
+   the ADC conversion results. It is configured as RTOS_EVT_DEFERRED_WORK. */
 
 
 /*
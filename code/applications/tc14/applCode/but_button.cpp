@@ -127,17 +127,14 @@ static enumButton_t decodeLCDButton(uint16_t adcVal)
  *   @remark
  * This function is trigered by an RTOS event whenever a new voltage input value is
  * available. Therefore it doesn't have a parameter. Instead, it reads its input by side
- * effect from \a adc_buttonVoltage.
+ * effect from adc_getResult(#ADC_IDX_CHANNEL_BUTTONS).
  */
 
 void but_onNewButtonVoltage()
 {
     /* Get the currently recognized button. The input voltage is written by a task of
-       higher priority and accordingly, we need to apply a critical section to read the
-       value. */
-    cli();
-    uint16_t buttonVoltage = adc_buttonVoltage;
-    sei();
+       higher priority; the access function applies the needed critical section. */
+    uint16_t buttonVoltage = adc_getResult(ADC_IDX_CHANNEL_BUTTONS);
     enumButton_t btn = decodeLCDButton(buttonVoltage);
 
     /* Debouncing: The recognized button is unsafe. The voltage measurement averages the
@@ -4,7 +4,12 @@
  * from different RTuinOS tasks. The display becomes a shared resource.\n
  *   The class only offers some application specific, formatted print functions. No other
  * information than anticpated by these functions can be written to the display. With other
- * words, the entire layout design of the application output is controlled by this module.
+ * words, the entire layout design of the application output is controlled by this module.\n
+ *   The print functions don't write to the LCD but into a RAM shadow of the display, the
+ * frame buffer. This takes only a few microseconds, the mutex, which protects the frame
+ * buffer, is held only shortly. A task of low priority regularly calls
+ * dpy_display_t::flush, which compares the frame buffer with the contents of the display
+ * and transfers only the changed characters to the LCD.
  *
  * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
  *
@@ -28,7 +33,10 @@
  *   dpy_display_t::printTime
  *   dpy_display_t::printVoltage
  *   dpy_display_t::printCpuLoad
+ *   dpy_display_t::flush
  * Local functions
+ *   dpy_display_t::writeFrameBuffer
+ *   dpy_display_t::writeThrough
  *   dpy_display_t::acquireMutex
  *   dpy_display_t::releaseMutex
  */
@@ -43,6 +51,7 @@
 #include "rtos.h"
 #include "rtos_assert.h"
 #include "aev_applEvents.h"
+#include "fxp_fixedPoint.h"
 #include "dpy_display.h"
 
 
@@ -86,7 +95,12 @@ dpy_display_t::dpy_display_t()
     : LiquidCrystal(8, 9, 4, 5, 6, 7)
 {
     /* Initialize LCD shield. */
-    begin(16, 2);
+    begin(DPY_NO_COLS, DPY_NO_ROWS);
+
+    /* begin() clears the display. Frame buffer and the image of the display content are
+       initialized accordingly. */
+    memset(_frameBuffer, ' ', sizeof(_frameBuffer));
+    memset(_shownBuffer, ' ', sizeof(_shownBuffer));
 
 } /* End of dpy_display_t::dpy_display_t */
 
@@ -135,7 +149,10 @@ void dpy_display_t::printGreeting()
  * Print the invariant parts of the display layout. This function must be called once at
  * the beginning, prior to the call of any of the other formatted print commands.\n
  *   The function must not be called at run time, when concurrent tasks try to access the
- * display. This function will not acquire the mutex for safe access of the display.
+ * display. This function will not acquire the mutex for safe access of the display.\n
+ *   The text is written into the frame buffer and directly to the display. Both lines
+ * are completely written; this brings the frame buffer in sync with the display after
+ * printGreeting, which bypasses the frame buffer.
  */
 
 void dpy_display_t::printBackground()
@@ -151,13 +168,11 @@ void dpy_display_t::printBackground()
        that modules interface ... */
     sprintf(lcdLine, "ADC: BG         ");
     ASSERT(noChars < (int)sizeof(lcdLine));
-    setCursor(/* col */ 0, /* row */ 0);
-    print(lcdLine);
+    writeThrough(/* col */ 0, /* row */ 0, lcdLine);
 
     sprintf(lcdLine, "      V        %%");
     ASSERT(noChars < (int)sizeof(lcdLine));
-    setCursor(/* col */ 0, /* row */ 1);
-    print(lcdLine);
+    writeThrough(/* col */ 0, /* row */ 1, lcdLine);
 
 } /* End of dpy_display_t::printBackground */
 
@@ -194,10 +209,9 @@ void dpy_display_t::printAdcInput(int8_t idxInput)
        should, we simply deny printing. */
     if(acquireMutex())
     {
-        setCursor(/* col */ 5, /* row */ 0);
-        print(lcdString);
+        writeFrameBuffer(/* col */ 5, /* row */ 0, lcdString);
 
-        /* And release the mutex as soon as possible after writing to the underlaying class has
+        /* And release the mutex as soon as possible after writing to the frame buffer has
            been done. */
         releaseMutex();
     }
@@ -237,10 +251,9 @@ void dpy_display_t::printTime(uint8_t hour, uint8_t min, uint8_t sec)
     if(acquireMutex())
     {
         /* "16-sizeof" means to display right aligned. */
-        setCursor(/* col */ 16-(sizeof(lcdString)-1), /* row */ 0);
-        print(lcdString);
+        writeFrameBuffer(/* col */ 16-(sizeof(lcdString)-1), /* row */ 0, lcdString);
 
-        /* And release the mutex as soon as possible after writing to the underlaying class has
+        /* And release the mutex as soon as possible after writing to the frame buffer has
            been done. */
         releaseMutex();
     }
@@ -255,28 +268,29 @@ void dpy_display_t::printTime(uint8_t hour, uint8_t min, uint8_t sec)
  * idle task. (It acquires the mutex for safe access of the display, which is forbidden for
  * the idle task.)
  *   @param voltage
- * The value to print. Scaling is 1 V. The range is [0..10). Exceeding the range will lead
- * to a runtime error!
+ * The value to print. Scaling is 1 mV. The range is [0..10000). Exceeding the range will
+ * lead to the display of "#####".
+ *   @remark
+ * The formatting is done in fixed point arithmetics. Formerly, the float value had been
+ * printed with sprintf(lcdString, "%5.3f", voltage). This required to link the stdio
+ * library with floating point support, which consumed about 1.5 kByte of flash ROM, and
+ * the conversion took a few thousand CPU cycles. The fixed point formatting takes about
+ * 300 cycles.
  */
 
-void dpy_display_t::printVoltage(float voltage)
+void dpy_display_t::printVoltage(uint16_t voltage)
 {
     char lcdString[5+1];
-#ifdef DEBUG
-    int noChars =
-#endif
-    sprintf(lcdString, "%5.3f", (double)voltage);
-    ASSERT(noChars < (int)sizeof(lcdString));
+    fxp_formatUInt16(lcdString, sizeof(lcdString)-1, voltage, /* noFractDigits */ 3);
 
     /* Get access to the display, or wait until anybody else has finished respectively. A
        timeout has been defined which should never elapse, but who knows. In case it
        should, we simply deny printing. */
     if(acquireMutex())
     {
-        setCursor(/* col */ 0, /* row */ 1);
-        print(lcdString);
+        writeFrameBuffer(/* col */ 0, /* row */ 1, lcdString);
 
-        /* And release the mutex as soon as possible after writing to the underlaying class has
+        /* And release the mutex as soon as possible after writing to the frame buffer has
            been done. */
         releaseMutex();
     }
@@ -297,23 +311,24 @@ void dpy_display_t::printVoltage(float voltage)
 
 void dpy_display_t::printCpuLoad(uint8_t cpuLoad)
 {
+    /* The input is converted to a resolution of 0.1% and printed with one fractional
+       digit. */
     char lcdString[5+1];
-#ifdef DEBUG
-    int noChars =
-#endif
-    sprintf(lcdString, "%5.1f", (double)cpuLoad/2.0);
-    ASSERT(noChars < (int)sizeof(lcdString));
+    fxp_formatUInt16( lcdString
+                    , sizeof(lcdString)-1
+                    , (uint16_t)cpuLoad * 5u
+                    , /* noFractDigits */ 1
+                    );
 
     /* Get access to the display, or wait until anybody else has finished respectively. A
        timeout has been defined which should never elapse, but who knows. In case it
        should, we simply deny printing. */
     if(acquireMutex())
     {
-        setCursor(/* col */ 10, /* row */ 1);
-        print(lcdString);
+        writeFrameBuffer(/* col */ 10, /* row */ 1, lcdString);
 
-        /* And release the mutex as soon as possible after writing to the underlaying class
-           has been done. */
+        /* And release the mutex as soon as possible after writing to the frame buffer has
+           been done. */
         releaseMutex();
     }
 } /* End of dpy_display_t::printCpuLoad */
@@ -321,6 +336,52 @@ void dpy_display_t::printCpuLoad(uint8_t cpuLoad)
 
 
 
+/**
+ * Transfer all changes of the frame buffer to the display. Only the characters, which
+ * differ from the current contents of the display, are written to the LCD.\n
+ *   The function needs to be called regularly by a single task of low priority. It is the
+ * only one, which accesses the LCD at run time, so the slow bus transfers to the LCD are
+ * done without holding the mutex.
+ */
+
+void dpy_display_t::flush()
+{
+    char frameBuffer[DPY_NO_ROWS][DPY_NO_COLS];
+
+    /* Take a consistent snapshot of the frame buffer. */
+    if(!acquireMutex())
+        return;
+    memcpy(frameBuffer, _frameBuffer, sizeof(frameBuffer));
+    releaseMutex();
+
+    uint8_t row, col;
+    for(row=0; row<DPY_NO_ROWS; ++row)
+    {
+        /* The cursor of the LCD advances automatically after writing a character. It
+           needs to be set only at the beginning of a series of changed characters. */
+        boolean isCursorValid = false;
+        for(col=0; col<DPY_NO_COLS; ++col)
+        {
+            const char c = frameBuffer[row][col];
+            if(c != _shownBuffer[row][col])
+            {
+                if(!isCursorValid)
+                {
+                    setCursor(col, row);
+                    isCursorValid = true;
+                }
+                write((uint8_t)c);
+                _shownBuffer[row][col] = c;
+            }
+            else
+                isCursorValid = false;
+        }
+    }
+} /* End of dpy_display_t::flush */
+
+
+
+
 
 /**
  * At runtime, when the \b RTuinOS tasks compete for the display, strict synchronization is
@@ -373,6 +434,49 @@ inline void dpy_display_t::releaseMutex()
 
 
 
+/**
+ * Write a string into the frame buffer. The caller needs to own the mutex.
+ *   @param col
+ * The column of the first character.
+ *   @param row
+ * The row of the string.
+ *   @param text
+ * The string to write. It must not exceed the end of the row.
+ */
+
+void dpy_display_t::writeFrameBuffer(uint8_t col, uint8_t row, const char *text)
+{
+    const size_t len = strlen(text);
+    ASSERT(row < DPY_NO_ROWS  &&  col + len <= DPY_NO_COLS);
+    memcpy(&_frameBuffer[row][col], text, len);
+
+} /* End of dpy_display_t::writeFrameBuffer */
+
+
+
+/**
+ * Write a string into the frame buffer and directly to the display. This function must
+ * not be used at run time, when concurrent tasks try to access the display.
+ *   @param col
+ * The column of the first character.
+ *   @param row
+ * The row of the string.
+ *   @param text
+ * The string to write. It must not exceed the end of the row.
+ */
+
+void dpy_display_t::writeThrough(uint8_t col, uint8_t row, const char *text)
+{
+    const size_t len = strlen(text);
+    writeFrameBuffer(col, row, text);
+    memcpy(&_shownBuffer[row][col], text, len);
+    setCursor(col, row);
+    print(text);
+
+} /* End of dpy_display_t::writeThrough */
+
+
+
 
 
 
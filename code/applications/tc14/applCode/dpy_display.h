@@ -32,6 +32,12 @@
  * Defines
  */
 
+/** The number of characters per row of the display. */
+#define DPY_NO_COLS     16
+
+/** The number of rows of the display. */
+#define DPY_NO_ROWS     2
+
 
 /*
  * Global type definitions
@@ -41,7 +47,8 @@
     standard library LiquidCrystal and reduces it to the printf functions needed for this
     application of the display. Furthermore the print functions implement all needed task
     synchronization: The display is shared by several tasks, which will all write their
-    specific information into the display. */
+    specific information into the display. The print functions only write into a frame
+    buffer in RAM, which is transferred to the display by method flush. */
 class dpy_display_t: private LiquidCrystal
 {
 public:
@@ -62,15 +69,27 @@ public:
     /** Formatted printing of current time. */
     void printTime(uint8_t hour, uint8_t min, uint8_t sec);
 
-    /** Formatted printing of voltage. */
-    void printVoltage(float voltage);
+    /** Formatted printing of voltage. Scaling: 1 mV */
+    void printVoltage(uint16_t voltage);
 
     /** Formatted printing of current CPU load. Scaling: 0.5% */
     void printCpuLoad(uint8_t cpuLoad);
 
+    /** Transfer the changes of the frame buffer to the display. To be regularly called by
+        a task of low priority. */
+    void flush(void);
+
 private:
     inline boolean acquireMutex(void);
     inline void releaseMutex(void);
+    void writeFrameBuffer(uint8_t col, uint8_t row, const char *text);
+    void writeThrough(uint8_t col, uint8_t row, const char *text);
+
+    /** The frame buffer: The contents of the display as written by the print functions. */
+    char _frameBuffer[DPY_NO_ROWS][DPY_NO_COLS];
+
+    /** The characters, which are currently shown on the display. */
+    char _shownBuffer[DPY_NO_ROWS][DPY_NO_COLS];
 
 }; /* End of class dpy_display_t */
 
@@ -36,10 +36,36 @@
 #define RTOS_ROUND_ROBIN_MODE_SUPPORTED     RTOS_FEATURE_OFF
 
 
-/** Number of tasks in the system. Tasks aren't created dynamically. This number of tasks
-    will always be existent and alive. Permitted range is 0..127.\n
-      A runtime check is not done. The code will crash in case of a bad setting. */
-#define RTOS_NO_TASKS    5
+/** The priority classes of the tasks. The worker task of the deferred work queue,
+    rtos_deferredWorkTask, processes the ADC conversion results and has the highest one. */
+#define PRIO_CLASS_LOW      0
+#define PRIO_CLASS_BUTTON   1
+#define PRIO_CLASS_ADC      2
+
+/** The period times of the regular tasks in system timer tics. They are used as start
+    timeout, too. The period of taskRTC is defined by the clock module; tc14_adcInput.cpp
+    checks at compile time that both values are identical. */
+#define TASK_TIME_RTC               123
+#define TASK_TIME_FLUSH_DISPLAY     25
+
+/** The tasks of the application. #RTOS_NO_TASKS is derived from the list; the stack areas
+    are generated and the invariant task data is kept in flash ROM. The events are declared
+    in #RTOS_EVENT_LIST, see aev_applEvents.h for their meaning. */
+#define RTOS_TASK_LIST(RTOS_TASK)                                                          \
+    /*        taskFunction           prioClass          RR EDF stack                       \
+                startEventMask                  all    startTimeout */                     \
+    RTOS_TASK(rtos_deferredWorkTask, PRIO_CLASS_ADC,    0, 0,  256,                        \
+                EVT_DEFERRED_WORK,              false, 0)                                  \
+    RTOS_TASK(taskRTC,               PRIO_CLASS_LOW,    0, 0,  256,                        \
+                RTOS_EVT_ABSOLUTE_TIMER,        false, TASK_TIME_RTC)                      \
+    RTOS_TASK(taskIdleFollower,      PRIO_CLASS_LOW,    0, 0,  256,                        \
+                EVT_TRIGGER_IDLE_FOLLOWER_TASK, false, 0)                                  \
+    RTOS_TASK(taskButton,            PRIO_CLASS_BUTTON, 0, 0,  256,                        \
+                EVT_ADC_SCAN_COMPLETE,          false, 0)                                  \
+    RTOS_TASK(taskDisplayVoltage,    PRIO_CLASS_LOW,    0, 0,  256,                        \
+                EVT_ADC_SCAN_COMPLETE,          false, 0)                                  \
+    RTOS_TASK(taskFlushDisplay,      PRIO_CLASS_LOW,    0, 0,  256,                        \
+                RTOS_EVT_ABSOLUTE_TIMER,        false, TASK_TIME_FLUSH_DISPLAY)
 
 
 /** Number of distinct priorities of tasks. Since several tasks may share the same
@@ -55,7 +81,7 @@
     structures. Set the value as low as possible. Permitted range is min(1, NO_TASKS)..127,
     but a value greater than NO_TASKS is not reasonable.\n
       A runtime check is not done. The code will crash in case of a bad setting. */
-#define RTOS_MAX_NO_TASKS_IN_PRIO_CLASS 3
+#define RTOS_MAX_NO_TASKS_IN_PRIO_CLASS 4
 
 
 /** The number of events, which behave like semaphores. When posted, they are not
@@ -91,6 +117,14 @@
 #define RTOS_NO_MUTEX_EVENTS    1
 
 
+/** The ordinary events of the application. They follow the mutex of the display. See
+    aev_applEvents.h for their meaning. */
+#define RTOS_EVENT_LIST(RTOS_EVENT)                                                        \
+    RTOS_EVENT(EVT_TRIGGER_IDLE_FOLLOWER_TASK)                                             \
+    RTOS_EVENT(EVT_ADC_SCAN_COMPLETE)                                                      \
+    RTOS_EVENT(EVT_DEFERRED_WORK)
+
+
 /** Select the interrupt which clocks the system time. Side effects to consider: This
     interrupt (like all others which possibly result in a context switch) need to be
     inhibited by rtos_enterCriticalSection.\n
@@ -119,12 +153,12 @@
       Now the interrupt is enabled and if it occurs it'll post the event
     #RTOS_EVT_ISR_USER_00. You will probably have a task of high priority which is waiting
     for this event in order to handle the interrupt when it is resumed by the event. */
-#define RTOS_USE_APPL_INTERRUPT_00 RTOS_FEATURE_ON
+#define RTOS_USE_APPL_INTERRUPT_00 RTOS_FEATURE_OFF
 
 /** The name of the interrupt vector which is assigned to application interrupt 0. The
     supported vector names can be derived from table 14-1 on page 105 in the CPU manual,
     doc2549.pdf (see http://www.atmel.com). */
-#define RTOS_ISR_USER_00    ADC_vect
+#define RTOS_ISR_USER_00    xxx_vect
 
 
 /** Enable the application defined interrupt 1. See #RTOS_USE_APPL_INTERRUPT_00 for
@@ -136,6 +170,14 @@
 #define RTOS_ISR_USER_01    xxx_vect
 
 
+/** The ADC conversion complete interrupt has a top half, which only reads the conversion
+    result from the ADC and posts its processing as deferred work item, see
+    #RTOS_USE_DEFERRED_WORK. The top half returns the event, which wakes the worker task.
+    See #RTOS_APPL_INTERRUPT_LIST in rtos.config.template.h for the syntax. */
+#define RTOS_APPL_INTERRUPT_LIST(RTOS_ISR_TO_EVENT, RTOS_ISR_TO_TOP_HALF)                \
+    RTOS_ISR_TO_TOP_HALF(ADC_vect, adc_onConversionCompleteTopHalf, enableIRQAdc)
+
+
 /** A macro which expands to the code which defines all types which are related to the
     system timer. We need the unsigned and the related signed type. The macro is applied
     just once, see below and #RTOS_DEFINE_TYPE_OF_SYSTEM_TIME_DOXYGEN_TAG. */
@@ -294,6 +336,23 @@ RTOS_DEFINE_TYPE_OF_SYSTEM_TIME(8)
 #define RTOS_OVERRUN_TASK_IS_IMMEDIATELY_DUE  RTOS_FEATURE_ON
 
 
+/** The task stacks of this application sum up to 1.5 kByte. They are filled with the
+    pattern byte for the stack usage report by the idle task rather than at startup. The
+    first reports show the stack reserve as unknown. */
+#define RTOS_LAZY_STACK_PAINTING RTOS_FEATURE_ON
+
+
+/** The ADC conversion results are processed as deferred work items by the worker task
+    rtos_deferredWorkTask. The ADC interrupt only reads the hardware and posts the item. */
+#define RTOS_USE_DEFERRED_WORK  RTOS_FEATURE_ON
+
+/** The maximum number of pending work items. The value needs to be a power of two. */
+#define RTOS_DEFERRED_WORK_QUEUE_SIZE   8
+
+/** The event, which wakes the worker task of the deferred work queue. */
+#define RTOS_EVT_DEFERRED_WORK  EVT_DEFERRED_WORK
+
+
 #if RTOS_USE_SEMAPHORE == RTOS_FEATURE_ON
 /** The implementation of a semaphore is a simple unsigned integer. The value means the
     number of resources managed by the semaphore. In a resource management system it may be
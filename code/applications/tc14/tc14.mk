@@ -29,10 +29,10 @@
 # You should have received a copy of the GNU Lesser General Public License
 # along with this program. If not, see <http://www.gnu.org/licenses/>.
 
-# This sample requires the floating point support for the standard I/O library (printf in
-# the first place).
-IO_FLOAT_LIB = 1
-$(info tc14.mk: tc14 makes use of the stdio library with floating point support for printf & co)
+# This sample doesn't require the floating point support for the standard I/O library
+# (printf in the first place): The display output and the console output of the DEBUG
+# compilation are formatted in fixed point arithmetics, see fxp_fixedPoint.h.
+IO_FLOAT_LIB = 0
 
 # The standard list of source code directories is extended by some folders, which have been
 # introduced specifically for this sample. Please note the makefile convention to let path
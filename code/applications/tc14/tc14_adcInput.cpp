@@ -22,10 +22,13 @@
  * all.\n
  *   This RTuinOS sample application uses timer/counter 0 in the unchanged Arduino standard
  * configuration to trigger the conversions of the ADC. The overflow interrupt is used for
- * this purpose yielding a conversion rate of about 977 Hz. A task of high priority is
- * awaken on each conversion-complete event and reads the conversion result. The read
- * values are down-sampled and passed to a much slower secondary task, which prints them on
- * the Arduino LCD shield (using the LiquidCrystal library).\n
+ * this purpose yielding a conversion rate of about 977 Hz. The conversion-complete
+ * interrupt has a short top half, which reads the conversion result and posts its
+ * processing to the deferred work queue; the worker task of high priority is awaken and
+ * processes the result. The read values are down-sampled and passed to a much slower
+ * secondary task, which prints them on the Arduino LCD shield (using the LiquidCrystal
+ * library). The inputs are measured in a table driven scan sequence; a single broadcasted
+ * event per completed scan notifies all consumers of the results.\n
  *   Proper down-sampling is a CPU time consuming operation, which is hard to implement on
  * a tiny eight Bit controller. Here we use the easiest possible to implement filter with
  * rectangular impulse response. It adds the last recent N input values and divides the
@@ -53,8 +56,10 @@
  * is purposely accessed by different tasks, which are asynchronous to one another. To do
  * so, the display has been associated with a mutex and each display writing task will
  * acquire the mutex first. All of this has been encapsulated in the class dpy_display_t and
- * all a task needs to do is calling a simple function printXXX. (Please find more detailed
- * considerations about the use of library LiquidCrystal in the RTuinOS manual.)\n
+ * all a task needs to do is calling a simple function printXXX. The print functions only
+ * update a frame buffer in RAM; a task of low priority (taskFlushDisplay) transfers the
+ * changed characters to the LCD. (Please find more detailed considerations about the use
+ * of library LiquidCrystal in the RTuinOS manual.)\n
  * *) The the input voltage displaying task (taskDisplayVoltage) is regular but not by an
  * RTOS timer operation as usual but because it is associated with the ADC conversion
  * complete interrupt (which is purposely triggered by a regular hardware event). So this
@@ -83,9 +88,24 @@
  * put a number of RTOS elements in it to demonstrate and test the capabilities of RTuinOS.
  * Production code would probably look different (and less exciting).
  * @remark
- *   The compilation of this sample requires linkage against the stdio library with
- * floating point support for printf & co. The selection of this library is done in the
- * makefile "callback" into tc14.mk (see above).
+ *   The display output and the console output of the DEBUG compilation are formatted in
+ * fixed point arithmetics, see fxp_fixedPoint.h. The stdio library with floating point
+ * support for printf & co is not required. (The binary log, see #USE_BINARY_LOG, records
+ * some float values, but their formatting is done on the host.)
+ * @remark
+ *   In DEBUG compilation the idle task reports the state of the application to the
+ * console. By default, this is done by printf. Set #USE_BINARY_LOG to 1 to get deferred
+ * binary logging instead, see blg_binaryLog.h: The console output is then not readable
+ * in the Arduino Serial Monitor but needs to be captured into a file and rendered with the
+ * host tool code/tools/binaryLogDecoder/blgDecoder.c.
+ * @remark
+ *   The tasks are declared in the task list in rtos.config.h, see #RTOS_TASK_LIST. The
+ * invariant task data is kept in flash ROM and the calls of rtos_initializeTask are
+ * replaced by a loop over the flash ROM table. Compared to the former initialization of
+ * the tasks in setup(), the task objects in RAM lack the fields taskFunction, pStackArea
+ * and stackSize; this saves 6 Byte for each of the six tasks and the idle task. The impact
+ * on the flash ROM consumption is not stated here; the figures for both ways of task
+ * initialization are reported by avr-size after linking, see makefile.
  *
  * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
  *
@@ -103,16 +123,16 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  *
  * Module interface
- *   rtos_enableIRQUser00
- *   setup
- *   loop
- * Local functions
- *   blink
- *   taskOnADCComplete
+ *   enableIRQAdc
  *   taskRTC
  *   taskIdleFollower
  *   taskButton
  *   taskDisplayVoltage
+ *   taskFlushDisplay
+ *   setup
+ *   loop
+ * Local functions
+ *   blink
  */
 
 /*
@@ -124,7 +144,9 @@
 #include "rtos.h"
 #include "rtos_assert.h"
 #include "gsl_systemLoad.h"
+#include "blg_binaryLog.h"
 #include "stdout.h"
+#include "fxp_fixedPoint.h"
 #include "aev_applEvents.h"
 #include "dpy_display.h"
 #include "but_button.h"
@@ -139,15 +161,15 @@
 /** Pin 13 has an LED connected on most Arduino boards. */
 #define LED 13
 
-/** The index to the task objects as needed for requesting the overrun counter or the stack
-    usage. */
-enum { idxTaskOnADCComplete
-     , idxTaskRTC
-     , idxTaskIdleFollower
-     , idxTaskButton
-     , idxTaskDisplayVoltage
-     , noTasks
-     };
+/** The console output of the DEBUG compilation is either written by printf (0) or as
+    deferred binary log (1), which needs to be rendered on the host. */
+#define USE_BINARY_LOG  0
+
+/* The start timeout of taskRTC in the task list in rtos.config.h is its period, which is
+   defined by the clock module. */
+#if TASK_TIME_RTC != CLK_TASK_TIME_RTUINOS_STANDARD_TICS
+# error TASK_TIME_RTC in rtos.config.h differs from CLK_TASK_TIME_RTUINOS_STANDARD_TICS
+#endif
 
 
 /*
@@ -164,14 +186,6 @@ enum { idxTaskOnADCComplete
  * Data definitions
  */
 
-static volatile uint16_t _adcResult = 0;
-static volatile uint32_t _noAdcResults = 0;
-static uint8_t _stackTaskOnADCComplete[256];
-static uint8_t _stackTaskRTC[256];
-static uint8_t _stackTaskIdleFollower[256];
-static uint8_t _stackTaskButton[256];
-static uint8_t _stackTaskDisplayVoltage[256];
-
 /* Results of the idle task. */
 volatile uint8_t _cpuLoad = 200;
 
@@ -209,10 +223,10 @@ static void blink(uint8_t noFlashes)
  * The ADC is already configured when this callback is invoked from the RTuinOS kernel
  * initialization code. The callback is just used to release the interrupt on ADC
  * conversion complete - only now the kernel is ready to accept and handle these
- * interrupts.
+ * interrupts. See #RTOS_APPL_INTERRUPT_LIST in rtos.config.h.
  */
 
-void rtos_enableIRQUser00()
+void enableIRQAdc()
 {
     /* Complete the ADC configuration: Enable interrupt. */
 
@@ -225,54 +239,7 @@ void rtos_enableIRQUser00()
              | (1 << ADIF)  /* Reset the "conversion-ready" flag by writing a one. */
              | (1 << ADIE)  /* Allow interrupts on conversion-ready. */
              ;
-} /* End of rtos_enableIRQUser00 */
-
-
-
-/**
- * This task is triggered one by one by the interrupts triggered by the ADC, when it
- * completes a conversion. The task reads the ADC result register and processes the
- * sequence of values. The processing result is input to a slower, reporting task.
- *   @param initialResumeCondition
- * The vector of events which made the task due the very first time.
- */
-
-static void taskOnADCComplete(uint16_t initialResumeCondition)
-{
-    ASSERT(initialResumeCondition == EVT_ADC_CONVERSION_COMPLETE);
-
-#ifdef DEBUG
-    /* Test: Our ADC interrupt should be synchronous with Arduino's TIMER0_OVF (see
-       wiring.c). */
-    extern volatile unsigned long timer0_overflow_count;
-    uint32_t deltaCnt = timer0_overflow_count;
-#endif
-
-    do
-    {
-        /* Test: Our ADC interrupt should be synchronous with Arduino's TIMER0_OVF. */
-        ASSERT(adc_noAdcResults + deltaCnt == timer0_overflow_count);
-
-        /* Call the actual interrupt handler code. */
-        adc_onConversionComplete();
-    }
-    while(rtos_waitForEvent( EVT_ADC_CONVERSION_COMPLETE | RTOS_EVT_DELAY_TIMER
-                           , /* all */ false
-                           , /* timeout */ 1
-                           )
-#ifdef DEBUG
-          == EVT_ADC_CONVERSION_COMPLETE
-#endif
-         );
-
-    /* The following assertion fires if the ADC interrupt isn't timely. The wait condition
-       specifies a sharp timeout. True production code would be designed more failure
-       tolerant and e.g. not specify a timeout at all. This code would cause a reset in
-       case. */
-    ASSERT(false);
-
-} /* End of taskOnADCComplete */
-
+} /* End of enableIRQAdc */
 
 
 
@@ -282,7 +249,7 @@ static void taskOnADCComplete(uint16_t initialResumeCondition)
  * The vector of events which made the task due the very first time.
  */
 
-static void taskRTC(uint16_t initialResumeCondition)
+void taskRTC(uint16_t initialResumeCondition)
 {
     ASSERT(initialResumeCondition == RTOS_EVT_ABSOLUTE_TIMER);
 
@@ -310,7 +277,7 @@ static void taskRTC(uint16_t initialResumeCondition)
  * The vector of events which made the task due the very first time.
  */
 
-static void taskIdleFollower(uint16_t initialResumeCondition)
+void taskIdleFollower(uint16_t initialResumeCondition)
 {
     ASSERT(initialResumeCondition == EVT_TRIGGER_IDLE_FOLLOWER_TASK);
     do
@@ -335,14 +302,14 @@ static void taskIdleFollower(uint16_t initialResumeCondition)
  * The vector of events which made the task due the very first time.
  */
 
-static void taskButton(uint16_t initialResumeCondition)
+void taskButton(uint16_t initialResumeCondition)
 {
-    ASSERT(initialResumeCondition == EVT_TRIGGER_TASK_BUTTON);
+    ASSERT(initialResumeCondition == EVT_ADC_SCAN_COMPLETE);
     do
     {
         but_onNewButtonVoltage();
     }
-    while(rtos_waitForEvent(EVT_TRIGGER_TASK_BUTTON, /* all */ false, 0));
+    while(rtos_waitForEvent(EVT_ADC_SCAN_COMPLETE, /* all */ false, 0));
     ASSERT(false);
 
 } /* End of taskButton */
@@ -358,9 +325,9 @@ static void taskButton(uint16_t initialResumeCondition)
  * The vector of events which made the task due the very first time.
  */
 
-static void taskDisplayVoltage(uint16_t initialResumeCondition)
+void taskDisplayVoltage(uint16_t initialResumeCondition)
 {
-    ASSERT(initialResumeCondition == EVT_TRIGGER_TASK_DISPLAY_VOLTAGE);
+    ASSERT(initialResumeCondition == EVT_ADC_SCAN_COMPLETE);
     
     /* The rate of the result values is about once every 133 ms, which makes the display
        quite nervous. And it would become even faster is the averaging constant
@@ -372,35 +339,41 @@ static void taskDisplayVoltage(uint16_t initialResumeCondition)
        here typically consist of some samples from the former input and some from the new
        input. We do no longer see a sharp switch but a kind of cross fading. */
 #define NO_AVERAGED_SAMPLES     5
-#define SCALING_BIN_TO_V(binVal)                                                            \
-        ((ADC_U_REF/(double)((uint32_t)NO_AVERAGED_SAMPLES*ADC_NO_AVERAGED_SAMPLES)/1024.0) \
-         *(double)(binVal)                                                                  \
+/* The conversion to mV is done in fixed point arithmetics with a binary scaling of the
+   factor of 2^16. The double operations are limited to the compile time. */
+#define SCALING_BIN_TO_MV(binVal)                                                           \
+        ((uint16_t)(((uint32_t)(binVal)                                                     \
+                     * (uint32_t)(ADC_U_REF*1000.0*65536.0                                  \
+                                  / ((double)NO_AVERAGED_SAMPLES*ADC_NO_AVERAGED_SAMPLES)   \
+                                  / 1024.0 + 0.5                                            \
+                                 )                                                          \
+                     + 0x8000ul                                                             \
+                    ) >> 16                                                                 \
+                   )                                                                        \
         )
 
     static uint32_t accumuatedAdcResult_ = 0;
     static uint8_t noMean_ = NO_AVERAGED_SAMPLES;
     do
     {
-        /* This low priority task needs to apply a critical section to read the result of
-           the ADC interrupt task of high priority. */
-        cli();
-        accumuatedAdcResult_ += adc_inputVoltage;
-        sei();
+        /* This low priority task reads the result of the ADC task of high priority; the
+           access function applies the needed critical section. */
+        accumuatedAdcResult_ += adc_getResult(ADC_IDX_CHANNEL_USER_INPUT);
         
         if(--noMean_ == 0)
         {
-            dpy_display.printVoltage(SCALING_BIN_TO_V(accumuatedAdcResult_));
+            dpy_display.printVoltage(SCALING_BIN_TO_MV(accumuatedAdcResult_));
             
             /* Start next series on averaged samples. */
             noMean_ = NO_AVERAGED_SAMPLES;
             accumuatedAdcResult_ = 0;
         }
     }        
-    while(rtos_waitForEvent(EVT_TRIGGER_TASK_DISPLAY_VOLTAGE, /* all */ false, 0));
+    while(rtos_waitForEvent(EVT_ADC_SCAN_COMPLETE, /* all */ false, 0));
     ASSERT(false);
     
 #undef NO_AVERAGED_SAMPLES
-#undef SCALING_BIN_TO_V
+#undef SCALING_BIN_TO_MV
 } /* End of taskDisplayVoltage */
 
 
@@ -408,7 +381,32 @@ static void taskDisplayVoltage(uint16_t initialResumeCondition)
 
 
 /**
- * The initalization of the RTOS tasks and general board initialization.
+ * A regular task of low priority, which transfers the changes of the display contents
+ * from the frame buffer to the LCD. This is the only task, which is blocked by the slow
+ * bus transfers to the LCD.
+ *   @param initialResumeCondition
+ * The vector of events which made the task due the very first time.
+ */
+
+void taskFlushDisplay(uint16_t initialResumeCondition)
+{
+    ASSERT(initialResumeCondition == RTOS_EVT_ABSOLUTE_TIMER);
+    do
+    {
+        dpy_display.flush();
+    }
+    while(rtos_suspendTaskTillTime(/* deltaTimeTillResume */ TASK_TIME_FLUSH_DISPLAY));
+    ASSERT(false);
+
+} /* End of taskFlushDisplay */
+
+
+
+
+
+/**
+ * General board initialization. The RTOS tasks are initialized from the task list in
+ * rtos.config.h.
  */
 
 void setup()
@@ -444,63 +442,6 @@ void setup()
        multitasking begins. */
     dpy_display.printBackground();
 
-    /* Configure the interrupt task of highest priority class. */
-    ASSERT(noTasks == RTOS_NO_TASKS);
-    rtos_initializeTask( /* idxTask */          idxTaskOnADCComplete
-                       , /* taskFunction */     taskOnADCComplete
-                       , /* prioClass */        RTOS_NO_PRIO_CLASSES-1
-                       , /* pStackArea */       &_stackTaskOnADCComplete[0]
-                       , /* stackSize */        sizeof(_stackTaskOnADCComplete)
-                       , /* startEventMask */   EVT_ADC_CONVERSION_COMPLETE
-                       , /* startByAllEvents */ false
-                       , /* startTimeout */     0
-                       );
-
-    /* Configure the real time clock task of lowest priority class. */
-    rtos_initializeTask( /* idxTask */          idxTaskRTC
-                       , /* taskFunction */     taskRTC
-                       , /* prioClass */        0
-                       , /* pStackArea */       &_stackTaskRTC[0]
-                       , /* stackSize */        sizeof(_stackTaskRTC)
-                       , /* startEventMask */   RTOS_EVT_ABSOLUTE_TIMER
-                       , /* startByAllEvents */ false
-                       , /* startTimeout */     CLK_TASK_TIME_RTUINOS_STANDARD_TICS
-                       );
-
-    /* Configure the idle follower task of lowest priority class. */
-    rtos_initializeTask( /* idxTask */          idxTaskIdleFollower
-                       , /* taskFunction */     taskIdleFollower
-                       , /* prioClass */        0
-                       , /* pStackArea */       &_stackTaskIdleFollower[0]
-                       , /* stackSize */        sizeof(_stackTaskIdleFollower)
-                       , /* startEventMask */   EVT_TRIGGER_IDLE_FOLLOWER_TASK
-                       , /* startByAllEvents */ false
-                       , /* startTimeout */     0
-                       );
-
-    /* Configure the button evaluation task. Its priority is below the interrupt but - as
-       it implements user interaction - above the priority of the display tasks. */
-    rtos_initializeTask( /* idxTask */          idxTaskButton
-                       , /* taskFunction */     taskButton
-                       , /* prioClass */        1
-                       , /* pStackArea */       &_stackTaskButton[0]
-                       , /* stackSize */        sizeof(_stackTaskButton)
-                       , /* startEventMask */   EVT_TRIGGER_TASK_BUTTON
-                       , /* startByAllEvents */ false
-                       , /* startTimeout */     0
-                       );
-
-    /* Configure the result display task. */
-    rtos_initializeTask( /* idxTask */          idxTaskDisplayVoltage
-                       , /* taskFunction */     taskDisplayVoltage
-                       , /* prioClass */        0
-                       , /* pStackArea */       &_stackTaskDisplayVoltage[0]
-                       , /* stackSize */        sizeof(_stackTaskDisplayVoltage)
-                       , /* startEventMask */   EVT_TRIGGER_TASK_DISPLAY_VOLTAGE
-                       , /* startByAllEvents */ false
-                       , /* startTimeout */     0
-                       );
-    
     /* Initialize other modules. */
     adc_initAfterPowerUp();
     
@@ -525,7 +466,11 @@ void loop()
     blink(3);
     
 #ifdef DEBUG
+# if USE_BINARY_LOG == 1
+    blg_log0("\nRTuinOS is idle\n");
+# else
     printf("\nRTuinOS is idle\n");
+# endif
 #endif
 
     /* Share result of CPU load computation with the displaying idle follower task. No
@@ -536,27 +481,86 @@ void loop()
 
 #ifdef DEBUG
     cli();
-    uint16_t adcResult       = adc_inputVoltage;
-    uint16_t adcResultButton = adc_buttonVoltage;
+    uint16_t adcResult       = adc_getResult(ADC_IDX_CHANNEL_USER_INPUT);
+    uint16_t adcResultButton = adc_getResult(ADC_IDX_CHANNEL_BUTTONS);
     uint32_t noAdcResults = adc_noAdcResults;
     uint8_t hour = clk_noHour
           , min  = clk_noMin
           , sec  = clk_noSec;
     sei();
 
+# if USE_BINARY_LOG == 1
+    /* Only the raw values are recorded; the formatting is done by the decoder on the
+       host. */
+    blg_log3("At %02u:%02u:%02u:\n", hour, min, sec);
+    blg_log2("ADC result %7lu at %7.2f s: ", noAdcResults, 1e-3*millis());
+    blg_log2( "%.4f V (input), %.4f V (buttons)\n"
+            , ADC_SCALING_BIN_TO_V(adcResult)
+            , ADC_SCALING_BIN_TO_V(adcResultButton)
+            );
+    blg_log1("CPU load: %.1f %%\n", (double)_cpuLoad/2.0);
+# else
+    /* The values are formatted in fixed point arithmetics. printf with floating point
+       formats would require to link the stdio library with floating point support. */
+    char strUInput[5+1], strUButtons[5+1], strCpuLoad[5+1];
+    fxp_formatUInt16( strUInput
+                    , sizeof(strUInput)-1
+                    , ADC_SCALING_BIN_TO_MV(adcResult)
+                    , /* noFractDigits */ 3
+                    );
+    fxp_formatUInt16( strUButtons
+                    , sizeof(strUButtons)-1
+                    , ADC_SCALING_BIN_TO_MV(adcResultButton)
+                    , /* noFractDigits */ 3
+                    );
+    fxp_formatUInt16( strCpuLoad
+                    , sizeof(strCpuLoad)-1
+                    , (uint16_t)_cpuLoad * 5u
+                    , /* noFractDigits */ 1
+                    );
+    const uint32_t tiMillis = millis();
     printf("At %02u:%02u:%02u:\n", hour, min, sec);
-    printf( "ADC result %7lu at %7.2f s: %.4f V (input), %.4f V (buttons)\n"
+    printf( "ADC result %7lu at %4lu.%02u s: %s V (input), %s V (buttons)\n"
           , noAdcResults
-          , 1e-3*millis()
-          , ADC_SCALING_BIN_TO_V(adcResult)
-          , ADC_SCALING_BIN_TO_V(adcResultButton)
+          , tiMillis / 1000u
+          , (unsigned int)(tiMillis % 1000u) / 10u
+          , strUInput
+          , strUButtons
           );
-    printf("CPU load: %.1f %%\n", (double)_cpuLoad/2.0);
-    ASSERT(rtos_getTaskOverrunCounter(/* idxTask */ idxTaskRTC, /* doReset */ false) == 0);
+    printf("CPU load: %s %%\n", strCpuLoad);
+# endif
+    ASSERT(rtos_getTaskOverrunCounter(/* idxTask */ rtos_idxTask_taskRTC, /* doReset */ false) == 0);
     
     uint8_t u;
     for(u=0; u<RTOS_NO_TASKS; ++u)
-        printf("Unused stack area of task %u: %u Byte\n", u, rtos_getStackReserve(u));
+    {
+        /* The stacks are filled with the pattern byte only after startup. */
+        const uint16_t stackReserve = rtos_getStackReserve(u);
+# if USE_BINARY_LOG == 1
+        if(stackReserve == RTOS_STACK_RESERVE_UNKNOWN)
+        {
+            blg_log1("Unused stack area of task %u: unknown\n", u);
+        }
+        else
+        {
+            blg_log2("Unused stack area of task %u: %u Byte\n", u, stackReserve);
+        }
+# else
+        if(stackReserve == RTOS_STACK_RESERVE_UNKNOWN)
+            printf("Unused stack area of task %u: unknown\n", u);
+        else
+            printf("Unused stack area of task %u: %u Byte\n", u, stackReserve);
+# endif
+    }
+
+# if USE_BINARY_LOG == 1
+    /* The idle task sends the log to the console. Serial may block, which doesn't harm
+       any other task. */
+    uint8_t logBuf[32];
+    uint16_t noBytes;
+    while((noBytes = blg_readLog(logBuf, sizeof(logBuf))) > 0)
+        Serial.write(logBuf, noBytes);
+# endif
 #endif
 
     /* Trigger the follower task, which is capable to safely display the results. */
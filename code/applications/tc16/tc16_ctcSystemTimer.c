@@ -0,0 +1,271 @@
+/**
+ * @file tc16_ctcSystemTimer.c
+ *   Test case 16 of RTuinOS. The built-in high resolution system timer is used: A 16 Bit
+ * timer is operated in CTC mode with a period time, which is configured at compile time in
+ * rtos.config.h (see RTOS_CTC_TIC_PERIOD_US). This test case should be compiled and run
+ * with the tic periods 1000 us, 500 us and 250 us.\n
+ *   A regular task measures its own period time with the Arduino function micros(). The
+ * average over a number of cycles is compared with the nominal period time, which is
+ * derived from #RTOS_TIC. Both timers are clocked by the same crystal, so the result needs
+ * to match up to the resolution of micros().\n
+ *   micros() needs to be the original function of the Arduino library, which is clocked by
+ * timer 0 independently of the system timer. #RTOS_PROVIDE_ARDUINO_TIME must not be
+ * configured in this test case; the substitutes are tested in tc26.\n
+ *   The idle task measures the duration of the system timer interrupt and its share of
+ * the CPU time. It polls the counter register of the system timer in a tight loop. When
+ * the counter wraps around, the interrupt has fired in between and the observed
+ * difference of the counter values is the duration of the interrupt plus one loop cycle.
+ * The minimum over many interrupts is taken; it belongs to the interrupts, which don't
+ * switch the context and which are not accompanied by other interrupts.\n
+ *   Observations:\n
+ * The console shows the configured and the realized tic period, the measured task period
+ * and the minimum execution time of the system timer interrupt together with its
+ * percentage of the CPU time. Deviations of the task period are counted as errors.
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Module interface
+ *   task00_class00
+ *   setup
+ *   loop
+ * Local functions
+ *   measureIsrDuration
+ */
+
+/*
+ * Include files
+ */
+
+#include <Arduino.h>
+#include "rtos.h"
+#include "rtos_assert.h"
+
+
+/*
+ * Defines
+ */
+
+/** The period time of the regular task in system timer tics. It is about 100 ms,
+    regardless of the configured tic period. */
+#define TASK_PERIOD ((uintTime_t)(0.1/RTOS_TIC + 0.5))
+
+/** The number of cycles of the regular task, which are averaged for the period time
+    measurement. */
+#define NO_AVERAGED_CYCLES  10
+
+/** The number of system timer interrupts observed by the idle task for a measurement of
+    the interrupt execution time. */
+#define NO_OBSERVED_IRQS    1000
+
+/* The task period is measured with micros(). It needs to be independent of the system
+   timer. */
+#if RTOS_PROVIDE_ARDUINO_TIME == RTOS_FEATURE_ON
+# error Test case requires the original micros() of the Arduino library
+#endif
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The measured average period time of the regular task in us. */
+static volatile uint32_t _tiAvgTaskPeriod = 0;
+
+/** The number of measurements of the task period, which were out of tolerance. */
+static volatile uint16_t _noErrPeriod = 0;
+
+/** The number of completed measurements of the task period. */
+static volatile uint16_t _noMeasurements = 0;
+
+
+/*
+ * Function implementation
+ */
+
+
+/**
+ * The regular task of this test case. It measures its own period time.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void task00_class00(uintEventVec_t initCondition)
+
+{
+    uint32_t tiStart = micros();
+    uint8_t cntCycles = 0;
+
+    for(;;)
+    {
+        rtos_suspendTaskTillTime(/* deltaTimeTillRelease */ TASK_PERIOD);
+
+        if(++cntCycles >= NO_AVERAGED_CYCLES)
+        {
+            const uint32_t tiNow = micros()
+                         , tiAvg = (tiNow - tiStart) / NO_AVERAGED_CYCLES;
+
+            /* The nominal period time is a compile time constant. The tolerance is the
+               resolution of micros() (4 us) plus a possible jitter of the task start. */
+            const uint32_t tiNominal = (uint32_t)(TASK_PERIOD * RTOS_TIC * 1e6 + 0.5);
+            if(tiAvg + 8 < tiNominal  ||  tiAvg > tiNominal + 8)
+                ++ _noErrPeriod;
+
+            _tiAvgTaskPeriod = tiAvg;
+            ++ _noMeasurements;
+
+            tiStart = tiNow;
+            cntCycles = 0;
+        }
+    } /* End for(ever) */
+
+} /* End of task00_class00 */
+
+
+
+
+
+/**
+ * Measure the execution time of the system timer interrupt. The counter register of the
+ * system timer is polled in a tight loop. A wrap-around of the counter value means that
+ * the interrupt has fired in between.
+ *   @param pMinIsrTime
+ * The minimum observed duration of the interrupt in timer clock tics is returned by
+ * reference.
+ *   @param pLoopTime
+ * The duration of a single cycle of the polling loop in timer clock tics is returned by
+ * reference. This time is included in *pMinIsrTime.
+ */
+
+static void measureIsrDuration(uint16_t *pMinIsrTime, uint16_t *pLoopTime)
+{
+    uint16_t tcnt
+           , tcntLast
+           , diff
+           , minIsrTime = 0xffff
+           , loopTime = 0xffff
+           , noIrqs = 0;
+
+    tcntLast = RTOS_CTC_TCNT;
+    while(noIrqs < NO_OBSERVED_IRQS)
+    {
+        tcnt = RTOS_CTC_TCNT;
+        if(tcnt < tcntLast)
+        {
+            /* The counter has been reset by the compare match, the interrupt has been
+               executed in between. */
+            diff = tcnt + (RTOS_CTC_OCR_VALUE + 1u) - tcntLast;
+            if(diff < minIsrTime)
+                minIsrTime = diff;
+            ++ noIrqs;
+        }
+        else
+        {
+            diff = tcnt - tcntLast;
+            if(diff > 0  &&  diff < loopTime)
+                loopTime = diff;
+        }
+        tcntLast = tcnt;
+    }
+
+    *pMinIsrTime = minIsrTime;
+    *pLoopTime = loopTime;
+
+} /* End of measureIsrDuration */
+
+
+
+
+
+/**
+ * The initalization of the RTOS tasks and general board initialization.
+ */
+
+void setup(void)
+{
+    /* Start serial port at 9600 bps. */
+    Serial.begin(9600);
+    Serial.println("\n" RTOS_RTUINOS_STARTUP_MSG);
+
+} /* End of setup */
+
+
+
+
+/**
+ * The application owned part of the idle task. This routine is repeatedly called whenever
+ * there's some execution time left. It's interrupted by any other task when it becomes
+ * due.
+ *   @remark
+ * Different to all other tasks, the idle task routine may and should return. (The task as
+ * such doesn't terminate). This has been designed in accordance with the meaning of the
+ * original Arduino loop function.
+ */
+
+void loop(void)
+{
+    uint16_t minIsrTime, loopTime;
+    double tiIsr;
+
+    measureIsrDuration(&minIsrTime, &loopTime);
+
+    /* The duration of the interrupt is the observed difference of counter values minus one
+       cycle of the polling loop. */
+    if(minIsrTime > loopTime)
+        minIsrTime -= loopTime;
+    tiIsr = (double)minIsrTime * RTOS_CTC_PRESCALER / F_CPU;
+
+    Serial.print("Tic period configured [us]: ");
+    Serial.println(RTOS_CTC_TIC_PERIOD_US);
+    Serial.print("Tic period realized [us]: ");
+    Serial.print(RTOS_TIC*1e6, 3);
+    Serial.print(" (prescaler: ");
+    Serial.print(RTOS_CTC_PRESCALER);
+    Serial.print(", OCR: ");
+    Serial.print(RTOS_CTC_OCR_VALUE);
+    Serial.println(")");
+
+    Serial.print("Task period nominal [us]: ");
+    Serial.print((uint32_t)(TASK_PERIOD * RTOS_TIC * 1e6 + 0.5));
+    Serial.print(", measured: ");
+    Serial.print(_tiAvgTaskPeriod);
+    Serial.print(", errors: ");
+    Serial.print(_noErrPeriod);
+    Serial.print(" of ");
+    Serial.println(_noMeasurements);
+
+    Serial.print("System timer ISR [us]: ");
+    Serial.print(tiIsr*1e6, 2);
+    Serial.print(", CPU load [%]: ");
+    Serial.println(tiIsr/RTOS_TIC*100.0, 2);
+
+    Serial.print("Task overruns: ");
+    Serial.println(rtos_getTaskOverrunCounter(/* idxTask */ 0, /* doReset */ false));
+
+    delay(2000);
+
+} /* End of loop */
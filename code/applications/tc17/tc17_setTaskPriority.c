@@ -0,0 +1,295 @@
+/**
+ * @file tc17_setTaskPriority.c
+ *   Test case 17 of RTuinOS. The priority of tasks is changed at runtime with \a
+ * rtos_setTaskPriority. The test proves that the change becomes effective immediately,
+ * i.e. inside the call of \a rtos_setTaskPriority, if it requires a task switch, and that
+ * a suspended task is re-queued in the list of tasks, which wait for a mutex.\n
+ *   Task A of lowest priority runs regularly. In each cycle it acquires the mutex and
+ * starts the tasks C and D of medium priority, which then request the mutex, too. C
+ * requests it first and would normally get it first.\n
+ *   Case 1: A makes task B due, which has the same, lowest priority. B can't preempt A.
+ * Then A raises the priority of B and B needs to become active before A returns from \a
+ * rtos_setTaskPriority. B lowers its own priority again and A needs to become active
+ * before B returns from its call of \a rtos_setTaskPriority.\n
+ *   Case 2: A raises the priority of the suspended task D above the one of C. This must
+ * not switch the task. When A releases the mutex, D needs to get it before C although C
+ * has requested it first.\n
+ *   All tasks check the progress of the test by a shared step counter. A task, which sees
+ * an unexpected step, counts an error.\n
+ *   Observations:\n
+ * The idle task prints the number of completed test cycles and the number of errors. The
+ * number of errors needs to stay zero.
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Module interface
+ *   taskA
+ *   taskB
+ *   taskC
+ *   taskD
+ *   setup
+ *   loop
+ * Local functions
+ *   checkStep
+ */
+
+/*
+ * Include files
+ */
+
+#include <Arduino.h>
+#include "rtos.h"
+#include "rtos_assert.h"
+
+
+/*
+ * Defines
+ */
+
+/** The period time of task A in system timer tics. */
+#define TASK_PERIOD 50
+
+/** The mutex, which is requested by the tasks A, C and D. */
+#define EVT_MUTEX   RTOS_EVT_MUTEX_00
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The progress of the current test cycle. */
+static volatile uint8_t _step = 0;
+
+/** The number of completed test cycles. */
+static volatile uint16_t _noCycles = 0;
+
+/** The number of recognized errors. */
+static volatile uint16_t _noErrors = 0;
+
+
+/*
+ * Function implementation
+ */
+
+
+/**
+ * Check the progress of the test and advance to the next step.
+ *   @param expectedStep
+ * The step, which the test needs to have reached in the calling situation. An error is
+ * counted if the actual step differs.
+ *   @param nextStep
+ * The step counter is set to this value.
+ */
+
+static void checkStep(uint8_t expectedStep, uint8_t nextStep)
+{
+    if(_step != expectedStep)
+        ++ _noErrors;
+    _step = nextStep;
+
+} /* End of checkStep */
+
+
+
+
+/**
+ * Task A of low priority, which controls the test cycles.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskA(uintEventVec_t initCondition)
+
+{
+    for(;;)
+    {
+        rtos_suspendTaskTillTime(/* deltaTimeTillRelease */ TASK_PERIOD);
+
+        /* The mutex is free at the beginning of a cycle, we get it without suspending. */
+        checkStep(/* expectedStep */ 0, /* nextStep */ 1);
+        rtos_waitForEvent(/* eventMask */ EVT_MUTEX, /* all */ false, /* timeout */ 0);
+
+        /* C and D have higher priority. They become active, request the mutex and are
+           suspended again. C is the first in the queue. */
+        rtos_sendEvent(EVT_START_TASK_C);
+        rtos_sendEvent(EVT_START_TASK_D);
+
+        /* Case 1: B becomes due but it can't preempt this task of same priority. */
+        rtos_sendEvent(EVT_TRIGGER_TASK_B);
+        checkStep(/* expectedStep */ 1, /* nextStep */ 2);
+
+        /* B needs to become active inside the call. */
+        rtos_setTaskPriority(rtos_idxTask_taskB, PRIO_MEDIUM);
+        checkStep(/* expectedStep */ 3, /* nextStep */ 4);
+
+        /* Case 2: D is suspended, no task switch. */
+        rtos_setTaskPriority(rtos_idxTask_taskD, PRIO_HIGH);
+        checkStep(/* expectedStep */ 4, /* nextStep */ 5);
+
+        /* D needs to get the mutex first. It becomes active inside the call. It passes the
+           mutex to C and C becomes active after D. */
+        rtos_sendEvent(EVT_MUTEX);
+        checkStep(/* expectedStep */ 7, /* nextStep */ 0);
+
+        ++ _noCycles;
+
+    } /* End for(ever) */
+
+} /* End of taskA */
+
+
+
+
+/**
+ * Task B is of low priority. It is raised to higher priority by task A and lowers its
+ * priority itself.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskB(uintEventVec_t initCondition)
+
+{
+    for(;;)
+    {
+        /* We are here because A has raised our priority. */
+        checkStep(/* expectedStep */ 2, /* nextStep */ 3);
+
+        /* A needs to become active inside the call. It has finished the cycle, when we
+           return. */
+        rtos_setTaskPriority(rtos_idxTask_taskB, PRIO_LOW);
+        checkStep(/* expectedStep */ 0, /* nextStep */ 0);
+
+        rtos_waitForEvent(/* eventMask */ EVT_TRIGGER_TASK_B, /* all */ false, /* timeout */ 0);
+
+    } /* End for(ever) */
+
+} /* End of taskB */
+
+
+
+
+/**
+ * Task C of medium priority requests the mutex first but gets it after task D.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskC(uintEventVec_t initCondition)
+
+{
+    for(;;)
+    {
+        rtos_waitForEvent(/* eventMask */ EVT_MUTEX, /* all */ false, /* timeout */ 0);
+        checkStep(/* expectedStep */ 6, /* nextStep */ 7);
+        rtos_sendEvent(EVT_MUTEX);
+
+        rtos_waitForEvent(/* eventMask */ EVT_START_TASK_C, /* all */ false, /* timeout */ 0);
+
+    } /* End for(ever) */
+
+} /* End of taskC */
+
+
+
+
+/**
+ * Task D of medium priority requests the mutex second. Task A raises its priority while it
+ * is waiting for the mutex, so that it gets it first.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskD(uintEventVec_t initCondition)
+
+{
+    for(;;)
+    {
+        rtos_waitForEvent(/* eventMask */ EVT_MUTEX, /* all */ false, /* timeout */ 0);
+        checkStep(/* expectedStep */ 5, /* nextStep */ 6);
+
+        /* Back to the original priority. No task switch, we are still above A and C is
+           suspended. */
+        rtos_setTaskPriority(rtos_idxTask_taskD, PRIO_MEDIUM);
+
+        /* C gets the mutex. It has the same priority and becomes active when we suspend. */
+        rtos_sendEvent(EVT_MUTEX);
+        rtos_waitForEvent(/* eventMask */ EVT_START_TASK_D, /* all */ false, /* timeout */ 0);
+
+    } /* End for(ever) */
+
+} /* End of taskD */
+
+
+
+
+/**
+ * The initalization of the RTOS tasks and general board initialization.
+ */
+
+void setup(void)
+{
+    /* Start serial port at 9600 bps. */
+    Serial.begin(9600);
+    Serial.println("\n" RTOS_RTUINOS_STARTUP_MSG);
+
+} /* End of setup */
+
+
+
+
+/**
+ * The application owned part of the idle task. This routine is repeatedly called whenever
+ * there's some execution time left. It's interrupted by any other task when it becomes
+ * due.
+ *   @remark
+ * Different to all other tasks, the idle task routine may and should return. (The task as
+ * such doesn't terminate). This has been designed in accordance with the meaning of the
+ * original Arduino loop function.
+ */
+
+void loop(void)
+{
+    Serial.print("Test cycles: ");
+    Serial.print(_noCycles);
+    Serial.print(", errors: ");
+    Serial.println(_noErrors);
+
+    delay(1000);
+
+} /* End of loop */
+
+
+
+
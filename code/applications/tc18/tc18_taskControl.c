@@ -0,0 +1,321 @@
+/**
+ * @file tc18_taskControl.c
+ *   Test case 18 of RTuinOS. A supervising task halts, resumes and restarts other tasks
+ * with \a rtos_suspendTask, \a rtos_resumeTask and \a rtos_restartTask.\n
+ *   Task A of low priority is the supervisor. Task B of higher priority runs regularly.
+ * Task C of higher priority waits for an event, which is posted by A. Task D of lowest
+ * priority is triggered by an event of A and it is busy for several tics.\n
+ *   Case 1: A halts B, which waits for its next due time, and waits some time. B must not
+ * run. A resumes B; the due time of B has passed meanwhile, so B needs to become active
+ * before A returns from \a rtos_resumeTask.\n
+ *   Case 2: A halts C, which waits for its event. A posts the event; C must not run. A
+ * resumes C; the event posted meanwhile is lost and C still waits. A posts the event again
+ * and C needs to become active before A returns from \a rtos_sendEvent.\n
+ *   Case 3: A restarts C. C needs to enter its task function before A returns from \a
+ * rtos_restartTask.\n
+ *   Case 4: A triggers D and waits. D becomes active and it is preempted when A becomes due
+ * again. A halts D, which is due, and waits again; D must not run. A resumes D; D must not
+ * preempt A. D needs to continue its activation when A waits once more.\n
+ *   Observations:\n
+ * The idle task prints the number of completed test cycles and the number of errors. The
+ * number of errors needs to stay zero.
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Module interface
+ *   taskA
+ *   taskB
+ *   taskC
+ *   taskD
+ *   setup
+ *   loop
+ * Local functions
+ *   check
+ */
+
+/*
+ * Include files
+ */
+
+#include <Arduino.h>
+#include "rtos.h"
+#include "rtos_assert.h"
+
+
+/*
+ * Defines
+ */
+
+/** The period time of task B in system timer tics. */
+#define TASK_PERIOD_B   10
+
+/** The busy time of task D in each activation in system timer tics. */
+#define TIME_BUSY_D     10
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The number of activations of task B. */
+static volatile uint16_t _cntB = 0;
+
+/** The number of activations of task C by its event. */
+static volatile uint16_t _cntC = 0;
+
+/** The number of times task C has entered its task function. */
+static volatile uint16_t _noStartsC = 0;
+
+/** The progress of task D. The counter is incremented all the time task D is busy. */
+static volatile uint32_t _cntD = 0;
+
+/** Task D is in the middle of an activation. */
+static volatile boolean _isBusyD = false;
+
+/** The number of completed test cycles. */
+static volatile uint16_t _noCycles = 0;
+
+/** The number of recognized errors. */
+static volatile uint16_t _noErrors = 0;
+
+
+/*
+ * Function implementation
+ */
+
+
+/**
+ * Count an error if a test condition is not fulfilled.
+ *   @param condition
+ * The expected condition.
+ */
+
+static void check(boolean condition)
+{
+    if(!condition)
+        ++ _noErrors;
+
+} /* End of check */
+
+
+
+
+/**
+ * Task A of low priority, which halts, resumes and restarts the other tasks.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskA(uintEventVec_t initCondition)
+
+{
+    uint16_t cnt;
+    uint32_t cntD;
+
+    for(;;)
+    {
+        /* Case 1: B is halted. Its due time passes while we wait. */
+        rtos_suspendTask(rtos_idxTask_taskB);
+        cnt = _cntB;
+        rtos_delay(3*TASK_PERIOD_B);
+        check(_cntB == cnt);
+
+        /* B needs to become active inside the call. */
+        rtos_resumeTask(rtos_idxTask_taskB);
+        check(_cntB != cnt);
+
+        /* Case 2: C waits for its event. It is halted and doesn't receive the event. */
+        rtos_suspendTask(rtos_idxTask_taskC);
+        cnt = _cntC;
+        rtos_sendEvent(EVT_TRIGGER_TASK_C);
+        check(_cntC == cnt);
+
+        /* C continues waiting. The event posted meanwhile is lost. */
+        rtos_resumeTask(rtos_idxTask_taskC);
+        check(_cntC == cnt);
+
+        /* C needs to become active inside the call. */
+        rtos_sendEvent(EVT_TRIGGER_TASK_C);
+        check(_cntC == cnt+1);
+
+        /* Case 3: C needs to enter its task function inside the call. */
+        cnt = _noStartsC;
+        rtos_restartTask(rtos_idxTask_taskC);
+        check(_noStartsC == cnt+1);
+
+        /* Case 4: D becomes due by our event but it runs only while we wait. It is
+           preempted when we become due again. */
+        rtos_sendEvent(EVT_TRIGGER_TASK_D);
+        rtos_delay(2);
+        check(_isBusyD);
+
+        /* D is halted while due. It doesn't run while we wait. */
+        rtos_suspendTask(rtos_idxTask_taskD);
+        cntD = _cntD;
+        rtos_delay(3);
+        check(_cntD == cntD);
+
+        /* D is due again but it has a lower priority; it doesn't preempt us. */
+        rtos_resumeTask(rtos_idxTask_taskD);
+        check(_cntD == cntD);
+
+        /* D continues its activation where it had been preempted. */
+        rtos_delay(1);
+        check(_isBusyD  &&  _cntD != cntD);
+
+        /* Let D complete its activation before the next test cycle. */
+        rtos_delay(TIME_BUSY_D);
+        check(!_isBusyD);
+
+        ++ _noCycles;
+
+    } /* End for(ever) */
+
+} /* End of taskA */
+
+
+
+
+/**
+ * Task B of high priority runs regularly.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskB(uintEventVec_t initCondition)
+
+{
+    for(;;)
+    {
+        ++ _cntB;
+        rtos_suspendTaskTillTime(/* deltaTimeTillRelease */ TASK_PERIOD_B);
+
+    } /* End for(ever) */
+
+} /* End of taskB */
+
+
+
+
+/**
+ * Task C of high priority waits for an event. It is restarted by task A in every test
+ * cycle.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskC(uintEventVec_t initCondition)
+
+{
+    /* A restarted task starts with the delay timer event. */
+    check(initCondition == RTOS_EVT_DELAY_TIMER);
+    ++ _noStartsC;
+
+    for(;;)
+    {
+        rtos_waitForEvent(/* eventMask */ EVT_TRIGGER_TASK_C, /* all */ false, /* timeout */ 0);
+        ++ _cntC;
+
+    } /* End for(ever) */
+
+} /* End of taskC */
+
+
+
+
+/**
+ * Task D of lowest priority is busy for several tics, whenever it is triggered by task A.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskD(uintEventVec_t initCondition)
+
+{
+    for(;;)
+    {
+        rtos_waitForEvent(/* eventMask */ EVT_TRIGGER_TASK_D, /* all */ false, /* timeout */ 0);
+
+        _isBusyD = true;
+        const uintTime_t tiStart = rtos_getTime();
+        while((uintTime_t)(rtos_getTime() - tiStart) < TIME_BUSY_D)
+            ++ _cntD;
+        _isBusyD = false;
+
+    } /* End for(ever) */
+
+} /* End of taskD */
+
+
+
+
+/**
+ * The initalization of the RTOS tasks and general board initialization.
+ */
+
+void setup(void)
+{
+    /* Start serial port at 9600 bps. */
+    Serial.begin(9600);
+    Serial.println("\n" RTOS_RTUINOS_STARTUP_MSG);
+
+} /* End of setup */
+
+
+
+
+/**
+ * The application owned part of the idle task. This routine is repeatedly called whenever
+ * there's some execution time left. It's interrupted by any other task when it becomes
+ * due.
+ *   @remark
+ * Different to all other tasks, the idle task routine may and should return. (The task as
+ * such doesn't terminate). This has been designed in accordance with the meaning of the
+ * original Arduino loop function.
+ */
+
+void loop(void)
+{
+    Serial.print("Test cycles: ");
+    Serial.print(_noCycles);
+    Serial.print(", errors: ");
+    Serial.println(_noErrors);
+
+    delay(1000);
+
+} /* End of loop */
+
+
+
+
@@ -0,0 +1,215 @@
+/**
+ * @file tc19_scheduleTable.c
+ *   Test case 19 of RTuinOS. Two time-triggered tasks are released by the schedule table,
+ * which is configured in rtos.config.h. The hyperperiod is ten system timer tics.\n
+ *   The task of high priority has the entries at offset 0 and 4. It checks that the time
+ * between its releases alternates between four and six tics.\n
+ *   The task of low priority has the entry at offset 7, its period is ten tics. In every
+ * fourth activation it consumes more than a period of CPU time. Its next entry is skipped
+ * and counted as task overrun. The task checks the time between its releases and its own
+ * overrun counter. It is preempted by the task of high priority, which must not be
+ * delayed.\n
+ *   Observations:\n
+ * The idle task prints the number of completed test cycles and the number of errors. The
+ * number of errors needs to stay zero.
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Module interface
+ *   taskLow
+ *   taskHigh
+ *   setup
+ *   loop
+ * Local functions
+ *   check
+ */
+
+/*
+ * Include files
+ */
+
+#include <Arduino.h>
+#include "rtos.h"
+#include "rtos_assert.h"
+
+
+/*
+ * Defines
+ */
+
+/** The busy time of the task of low priority in its long activations, in system timer
+    tics. */
+#define TIME_BUSY   12
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The number of completed test cycles, i.e. of long activations of the task of low
+    priority. */
+static volatile uint16_t _noCycles = 0;
+
+/** The number of recognized errors. */
+static volatile uint16_t _noErrors = 0;
+
+
+/*
+ * Function implementation
+ */
+
+
+/**
+ * Count an error if a test condition is not fulfilled.
+ *   @param condition
+ * The expected condition.
+ */
+
+static void check(boolean condition)
+{
+    if(!condition)
+        ++ _noErrors;
+
+} /* End of check */
+
+
+
+
+/**
+ * Task of low priority with one entry in the schedule table. Every fourth activation is
+ * too long.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskLow(uintEventVec_t initCondition)
+
+{
+    uintTime_t tiLastRelease = rtos_getTime();
+    uint8_t cntActivations = 0;
+    boolean isOverrun = false;
+
+    for(;;)
+    {
+        rtos_waitForNextScheduleSlot();
+
+        /* The entry after a long activation has been skipped. */
+        const uintTime_t tiRelease = rtos_getTime();
+        check((uintTime_t)(tiRelease - tiLastRelease)
+              == (isOverrun? 2: 1)*RTOS_SCHEDULE_HYPERPERIOD
+             );
+        check(rtos_getTaskOverrunCounter(rtos_idxTask_taskLow, /* doReset */ true)
+              == (isOverrun? 1: 0)
+             );
+        tiLastRelease = tiRelease;
+
+        isOverrun = ++cntActivations % 4 == 0;
+        if(isOverrun)
+        {
+            while((uintTime_t)(rtos_getTime() - tiRelease) < TIME_BUSY)
+                ;
+            ++ _noCycles;
+        }
+    } /* End for(ever) */
+
+} /* End of taskLow */
+
+
+
+
+/**
+ * Task of high priority with two entries in the schedule table.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskHigh(uintEventVec_t initCondition)
+
+{
+    /* The task is started at offset 0. The next release is at offset 4. */
+    uintTime_t tiLastRelease = rtos_getTime()
+             , expectedPeriod = 4;
+
+    for(;;)
+    {
+        rtos_waitForNextScheduleSlot();
+
+        const uintTime_t tiRelease = rtos_getTime();
+        check((uintTime_t)(tiRelease - tiLastRelease) == expectedPeriod);
+        check(rtos_getTaskOverrunCounter(rtos_idxTask_taskHigh, /* doReset */ false) == 0);
+        tiLastRelease = tiRelease;
+        expectedPeriod = RTOS_SCHEDULE_HYPERPERIOD - expectedPeriod;
+
+    } /* End for(ever) */
+
+} /* End of taskHigh */
+
+
+
+
+/**
+ * The initalization of the RTOS tasks and general board initialization.
+ */
+
+void setup(void)
+{
+    /* Start serial port at 9600 bps. */
+    Serial.begin(9600);
+    Serial.println("\n" RTOS_RTUINOS_STARTUP_MSG);
+
+} /* End of setup */
+
+
+
+
+/**
+ * The application owned part of the idle task. This routine is repeatedly called whenever
+ * there's some execution time left. It's interrupted by any other task when it becomes
+ * due.
+ *   @remark
+ * Different to all other tasks, the idle task routine may and should return. (The task as
+ * such doesn't terminate). This has been designed in accordance with the meaning of the
+ * original Arduino loop function.
+ */
+
+void loop(void)
+{
+    Serial.print("Test cycles: ");
+    Serial.print(_noCycles);
+    Serial.print(", errors: ");
+    Serial.println(_noErrors);
+
+    delay(1000);
+
+} /* End of loop */
+
+
+
+
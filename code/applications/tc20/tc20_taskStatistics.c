@@ -0,0 +1,299 @@
+/**
+ * @file tc20_taskStatistics.c
+ *   Test case 20 of RTuinOS. The timing statistics of the tasks are recorded by the kernel
+ * and queried with \a rtos_getTaskStatistics.\n
+ *   Two regular tasks of different priority run with different periods. The task of low
+ * priority consumes more than a system timer tic of CPU time in each activation and it is
+ * preempted by the task of high priority from time to time.\n
+ *   The idle task reads the statistics and checks their plausibility: The minimum must not
+ * exceed the maximum, the histograms need to count all activations of the tasks and the
+ * task of high priority needs to start in the same tic it is released in. The response
+ * time of the task of low priority can't be less than its busy time.\n
+ *   Observations:\n
+ * The idle task prints minimum and maximum of the measured times in us, the histogram of
+ * the response time of the task of low priority and the number of errors. The number of
+ * errors needs to stay zero.
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Module interface
+ *   taskLow
+ *   taskHigh
+ *   setup
+ *   loop
+ * Local functions
+ *   check
+ *   getNoSamples
+ *   printTimeSpan
+ */
+
+/*
+ * Include files
+ */
+
+#include <Arduino.h>
+#include "rtos.h"
+#include "rtos_assert.h"
+
+
+/*
+ * Defines
+ */
+
+/** The period times of the tasks in system timer tics. */
+#define TASK_PERIOD_LOW     5
+#define TASK_PERIOD_HIGH    2
+
+/** The busy time of the task of low priority in each activation, in system timer tics. */
+#define TIME_BUSY   2
+
+/** The duration of a system timer tic in the unit of the time stamps. */
+#define TIC_IN_TIMESTAMP_UNITS  (RTOS_CTC_OCR_VALUE+1ul)
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The number of completed activations of the tasks. */
+static volatile uint16_t _cntActivationsAry[RTOS_NO_TASKS] = {0, 0};
+
+/** The number of recognized errors. */
+static volatile uint16_t _noErrors = 0;
+
+
+/*
+ * Function implementation
+ */
+
+
+/**
+ * Count an error if a test condition is not fulfilled.
+ *   @param condition
+ * The expected condition.
+ */
+
+static void check(boolean condition)
+{
+    if(!condition)
+        ++ _noErrors;
+
+} /* End of check */
+
+
+
+
+/**
+ * Get the number of measured time spans, which is the sum of all bins of a histogram.
+ *   @return
+ * Get the number of samples.
+ *   @param pStat
+ * The statistics of one kind of time span.
+ */
+
+static uint32_t getNoSamples(const rtos_timeSpanStatistics_t *pStat)
+{
+    uint32_t noSamples = 0;
+    uint8_t idxBin;
+
+    for(idxBin=0; idxBin<RTOS_TASK_STATISTICS_NO_BINS; ++idxBin)
+        noSamples += pStat->histogramAry[idxBin];
+
+    return noSamples;
+
+} /* End of getNoSamples */
+
+
+
+
+/**
+ * Print minimum and maximum of a kind of time span in us.
+ *   @param name
+ * The name of the time span.
+ *   @param pStat
+ * The statistics of the time span.
+ */
+
+static void printTimeSpan(const char *name, const rtos_timeSpanStatistics_t *pStat)
+{
+    Serial.print(name);
+    Serial.print(": ");
+    Serial.print(pStat->min * RTOS_TIMESTAMP_UNIT * 1e6);
+    Serial.print(" .. ");
+    Serial.print(pStat->max * RTOS_TIMESTAMP_UNIT * 1e6);
+    Serial.println(" us");
+
+} /* End of printTimeSpan */
+
+
+
+
+/**
+ * Task of low priority. It consumes more than a tic of CPU time in each activation.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskLow(uintEventVec_t initCondition)
+
+{
+    for(;;)
+    {
+        const uintTime_t tiStart = rtos_getTime();
+        while((uintTime_t)(rtos_getTime() - tiStart) < TIME_BUSY)
+            ;
+        ++ _cntActivationsAry[rtos_idxTask_taskLow];
+
+        rtos_suspendTaskTillTime(/* deltaTimeTillRelease */ TASK_PERIOD_LOW);
+
+    } /* End for(ever) */
+
+} /* End of taskLow */
+
+
+
+
+/**
+ * Task of high priority, which is released regularly and returns quickly.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskHigh(uintEventVec_t initCondition)
+
+{
+    for(;;)
+    {
+        ++ _cntActivationsAry[rtos_idxTask_taskHigh];
+        rtos_suspendTaskTillTime(/* deltaTimeTillRelease */ TASK_PERIOD_HIGH);
+
+    } /* End for(ever) */
+
+} /* End of taskHigh */
+
+
+
+
+/**
+ * The initalization of the RTOS tasks and general board initialization.
+ */
+
+void setup(void)
+{
+    /* Start serial port at 9600 bps. */
+    Serial.begin(9600);
+    Serial.println("\n" RTOS_RTUINOS_STARTUP_MSG);
+
+} /* End of setup */
+
+
+
+
+/**
+ * The application owned part of the idle task. This routine is repeatedly called whenever
+ * there's some execution time left. It's interrupted by any other task when it becomes
+ * due.
+ *   @remark
+ * Different to all other tasks, the idle task routine may and should return. (The task as
+ * such doesn't terminate). This has been designed in accordance with the meaning of the
+ * original Arduino loop function.
+ */
+
+void loop(void)
+{
+    rtos_taskStatistics_t statAry[RTOS_NO_TASKS];
+    uint16_t cntActivationsAry[RTOS_NO_TASKS];
+    uint8_t idxTask, idxBin;
+
+    /* The idle task runs only while both tasks are suspended; all activations have been
+       completed. Read counters and statistics without being interrupted by a release of a
+       task to get consistent figures. */
+    cli();
+    {
+        for(idxTask=0; idxTask<RTOS_NO_TASKS; ++idxTask)
+        {
+            rtos_getTaskStatistics(idxTask, &statAry[idxTask], /* doReset */ false);
+            cntActivationsAry[idxTask] = _cntActivationsAry[idxTask];
+        }
+    }
+    sei();
+
+    for(idxTask=0; idxTask<RTOS_NO_TASKS; ++idxTask)
+    {
+        const rtos_taskStatistics_t * const pStat = &statAry[idxTask];
+        const uint32_t noResponses = getNoSamples(&pStat->responseTime)
+                     , noStarts = getNoSamples(&pStat->startLatency)
+                     , noReleasesByTimer = getNoSamples(&pStat->releaseJitter);
+
+        /* Both tasks are regularly released by the absolute timer. The first activation is
+           started by the delay timer and has no release jitter. */
+        check(noResponses == cntActivationsAry[idxTask]);
+        check(noStarts == noResponses);
+        check(noReleasesByTimer == (noStarts > 0? noStarts-1: 0));
+        if(noReleasesByTimer > 0)
+            check(pStat->releaseJitter.min <= pStat->releaseJitter.max);
+        if(noResponses > 0)
+        {
+            check(pStat->startLatency.min <= pStat->startLatency.max);
+            check(pStat->responseTime.min <= pStat->responseTime.max);
+            check(pStat->startLatency.max <= pStat->responseTime.max);
+        }
+    }
+
+    /* The task of high priority preempts the other one without delay. */
+    if(cntActivationsAry[rtos_idxTask_taskHigh] > 0)
+        check(statAry[rtos_idxTask_taskHigh].startLatency.max < TIC_IN_TIMESTAMP_UNITS);
+    if(cntActivationsAry[rtos_idxTask_taskLow] > 0)
+    {
+        check(statAry[rtos_idxTask_taskLow].responseTime.min
+              >= (TIME_BUSY-1)*TIC_IN_TIMESTAMP_UNITS
+             );
+    }
+
+    printTimeSpan("Jitter high", &statAry[rtos_idxTask_taskHigh].releaseJitter);
+    printTimeSpan("Latency high", &statAry[rtos_idxTask_taskHigh].startLatency);
+    printTimeSpan("Latency low", &statAry[rtos_idxTask_taskLow].startLatency);
+    printTimeSpan("Response low", &statAry[rtos_idxTask_taskLow].responseTime);
+    Serial.print("Histogram response low:");
+    for(idxBin=0; idxBin<RTOS_TASK_STATISTICS_NO_BINS; ++idxBin)
+    {
+        Serial.print(" ");
+        Serial.print(statAry[rtos_idxTask_taskLow].responseTime.histogramAry[idxBin]);
+    }
+    Serial.print("\nErrors: ");
+    Serial.println(_noErrors);
+
+    delay(1000);
+
+} /* End of loop */
+
+
+
+
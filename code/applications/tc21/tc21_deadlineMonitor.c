@@ -0,0 +1,250 @@
+/**
+ * @file tc21_deadlineMonitor.c
+ *   Test case 21 of RTuinOS. The deadline of a regular task is monitored by the kernel and
+ * a deadline miss is reported to a supervising task with event EVT_DEADLINE_MISS.\n
+ *   The worker task of low priority has a period of ten tics and a relative deadline of
+ * four tics. Normally it completes after one tic. In every fourth activation it is busy
+ * for six tics. It still completes long before its next due time, so there is no task
+ * overrun, but the deadline is missed.\n
+ *   The supervisor task of high priority waits for the deadline miss event. It needs to
+ * become active in the tic after the deadline, i.e. while the worker is still busy. It
+ * checks that the miss has been counted once, that it belongs to a long activation and
+ * that no task overrun has been counted.\n
+ *   The test case needs to be compiled and run a second time with #RTOS_EVT_DEADLINE_MISS
+ * set to null in rtos.config.h. The deadlines are then not checked in the system timer
+ * tic but only when the worker suspends. The worker checks itself that the miss of a long
+ * activation has not been counted before its suspend command and that it has been counted
+ * once after it. The supervisor must never be resumed in this configuration.\n
+ *   Observations:\n
+ * The idle task prints the number of activations of the worker, the number of deadline
+ * misses and the number of errors. The number of misses needs to be one fourth of the
+ * number of activations and the number of errors needs to stay zero.
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Module interface
+ *   taskWorker
+ *   taskSupervisor
+ *   setup
+ *   loop
+ * Local functions
+ *   check
+ */
+
+/*
+ * Include files
+ */
+
+#include <Arduino.h>
+#include "rtos.h"
+#include "rtos_assert.h"
+
+
+/*
+ * Defines
+ */
+
+/** The period time and the relative deadline of the worker task in system timer tics. */
+#define TASK_PERIOD     10
+#define TASK_DEADLINE   4
+
+/** The busy time of the worker task in its normal and in its long activations, in system
+    timer tics. */
+#define TIME_BUSY_SHORT 1
+#define TIME_BUSY_LONG  6
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The number of activations of the worker task. */
+static volatile uint16_t _cntWorker = 0;
+
+/** The worker task is in the middle of an activation. */
+static volatile boolean _isWorkerBusy = false;
+
+/** The number of reported deadline misses. */
+static volatile uint16_t _noDeadlineMisses = 0;
+
+/** The number of recognized errors. */
+static volatile uint16_t _noErrors = 0;
+
+
+/*
+ * Function implementation
+ */
+
+
+/**
+ * Count an error if a test condition is not fulfilled.
+ *   @param condition
+ * The expected condition.
+ */
+
+static void check(boolean condition)
+{
+    if(!condition)
+        ++ _noErrors;
+
+} /* End of check */
+
+
+
+
+/**
+ * Worker task of low priority. Every fourth activation is too long and misses the
+ * deadline. If the deadline miss event is not configured, the task checks the recognition
+ * of the miss at its suspend command.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskWorker(uintEventVec_t initCondition)
+
+{
+    for(;;)
+    {
+        _isWorkerBusy = true;
+
+        const boolean isLate = ++_cntWorker % 4 == 0;
+        const uintTime_t tiStart = rtos_getTime()
+                       , timeBusy = isLate? TIME_BUSY_LONG: TIME_BUSY_SHORT;
+        while((uintTime_t)(rtos_getTime() - tiStart) < timeBusy)
+            ;
+
+        _isWorkerBusy = false;
+
+        /* Without the event, the deadline has passed unnoticed so far. */
+        if(RTOS_EVT_DEADLINE_MISS == 0)
+        {
+            check(rtos_getTaskDeadlineMissCounter(rtos_idxTask_taskWorker, /* doReset */ false)
+                  == 0
+                 );
+        }
+
+        rtos_suspendTaskTillTime(/* deltaTimeTillRelease */ TASK_PERIOD);
+
+        /* Without the event, the miss has been recognized by the suspend command. */
+        if(RTOS_EVT_DEADLINE_MISS == 0)
+        {
+            const uint8_t noMisses =
+                        rtos_getTaskDeadlineMissCounter( rtos_idxTask_taskWorker
+                                                       , /* doReset */ true
+                                                       );
+            check(noMisses == (isLate? 1: 0));
+            _noDeadlineMisses += noMisses;
+        }
+
+    } /* End for(ever) */
+
+} /* End of taskWorker */
+
+
+
+
+/**
+ * Supervisor task of high priority, which is notified about deadline misses.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskSupervisor(uintEventVec_t initCondition)
+
+{
+    for(;;)
+    {
+        rtos_waitForEvent( /* eventMask */ EVT_DEADLINE_MISS
+                         , /* all */       false
+                         , /* timeout */   0
+                         );
+
+        /* The miss is reported while the late activation is still going on. The event is
+           posted only if it is configured as deadline miss event. */
+        check(RTOS_EVT_DEADLINE_MISS != 0);
+        check(_isWorkerBusy  &&  _cntWorker % 4 == 0);
+        check(rtos_getTaskDeadlineMissCounter(rtos_idxTask_taskWorker, /* doReset */ true)
+              == 1
+             );
+        check(rtos_getTaskOverrunCounter(rtos_idxTask_taskWorker, /* doReset */ false) == 0);
+        ++ _noDeadlineMisses;
+
+    } /* End for(ever) */
+
+} /* End of taskSupervisor */
+
+
+
+
+/**
+ * The initalization of the RTOS tasks and general board initialization.
+ */
+
+void setup(void)
+{
+    /* Start serial port at 9600 bps. */
+    Serial.begin(9600);
+    Serial.println("\n" RTOS_RTUINOS_STARTUP_MSG);
+
+
+    /* Only the worker task has a deadline. */
+    rtos_setTaskDeadline(rtos_idxTask_taskWorker, TASK_DEADLINE);
+
+} /* End of setup */
+
+
+
+
+/**
+ * The application owned part of the idle task. This routine is repeatedly called whenever
+ * there's some execution time left. It's interrupted by any other task when it becomes
+ * due.
+ *   @remark
+ * Different to all other tasks, the idle task routine may and should return. (The task as
+ * such doesn't terminate). This has been designed in accordance with the meaning of the
+ * original Arduino loop function.
+ */
+
+void loop(void)
+{
+    Serial.print("Activations: ");
+    Serial.print(_cntWorker);
+    Serial.print(", deadline misses: ");
+    Serial.print(_noDeadlineMisses);
+    Serial.print(", errors: ");
+    Serial.println(_noErrors);
+
+    delay(1000);
+
+} /* End of loop */
+
+
+
+
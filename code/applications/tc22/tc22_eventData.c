@@ -0,0 +1,323 @@
+/**
+ * @file tc22_eventData.c
+ *   Test case 22 of RTuinOS. Data words are passed together with events into the mailbox
+ * of the receiving tasks, see \a rtos_sendEventWithData and \a rtos_setEventDataFromISR.\n
+ *   A producer task of low priority regularly sends a sequence number to a consumer task of
+ * high priority with \a rtos_sendEventWithData. Every other time, it posts the event
+ * without data by \a rtos_sendEvent; the consumer needs to find the previous sequence
+ * number unchanged in its mailbox in this case. The consumer waits with a timeout, which
+ * is shorter than the period of the producer. If it is resumed by the timeout then the
+ * mailbox must not have changed either.\n
+ *   Timer 4 is configured as application interrupt with a top half. On every interrupt, it
+ * sets its interrupt count as data word. It returns an event only on every second
+ * interrupt. A second consumer task of high priority waits for this event and checks that
+ * it sees each even count and never the data word of an interrupt, which didn't post an
+ * event.\n
+ *   Observations:\n
+ * The idle task prints the number of received data words of both consumers and the
+ * number of errors. The number of errors needs to stay zero.
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Module interface
+ *   taskProducer
+ *   taskConsumerTask
+ *   taskConsumerIsr
+ *   setup
+ *   loop
+ *   enableIRQTimer4
+ *   onTimer4Overflow
+ * Local functions
+ *   check
+ */
+
+/*
+ * Include files
+ */
+
+#include <Arduino.h>
+#include "rtos.h"
+#include "rtos_assert.h"
+
+
+/*
+ * Defines
+ */
+
+/** The period time of the producer task in system timer tics. */
+#define TASK_PERIOD_PRODUCER    10
+
+/** The timeout of the consumer of the producer's data in system timer tics. It is shorter
+    than the period of the producer so that some of its waits end with a timeout. */
+#define TIMEOUT_CONSUMER    7
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The last recent sequence number sent by the producer. */
+static volatile uint16_t _seqNo = 0;
+
+/** The number of data words received from the producer task and from the interrupt. */
+static volatile uint16_t _noDataFromTask = 0;
+static volatile uint16_t _noDataFromIsr = 0;
+
+/** The number of timer 4 interrupts. */
+static uint16_t _cntIsr = 0;
+
+/** The number of recognized errors. */
+static volatile uint16_t _noErrors = 0;
+
+
+/*
+ * Function implementation
+ */
+
+
+/**
+ * Count an error if a test condition is not fulfilled.
+ *   @param condition
+ * The expected condition.
+ */
+
+static void check(boolean condition)
+{
+    if(!condition)
+        ++ _noErrors;
+
+} /* End of check */
+
+
+
+
+/**
+ * Callback from RTuinOS: The application interrupt, timer 4 overflow, is configured and
+ * released.
+ */
+
+void enableIRQTimer4()
+{
+#ifdef __AVR_ATmega2560__
+    /* Timer 4 is reconfigured as in test case tc08: Phase and frequency correct PWM mode,
+       WGM4 = %1001, with the CPU clock divided by 1024, CS4 = %101. The frequency is
+       7812.5 Hz/OCR4A. */
+    TCCR4A &= ~0x03; /* Lower half word of WGM */
+    TCCR4A |=  0x01;
+
+    TCCR4B &= ~0x1f; /* Upper half word of WGM and CS */
+    TCCR4B |=  0x15;
+
+    /* We choose 78 as initial value, or f_irq = 100 Hz. The consumer of the interrupt data
+       has plenty of time to process a data word before the next one is posted. */
+    OCR4A = 78u;
+
+    TIMSK4 |= 1;    /* Enable overflow interrupt. */
+#else
+# error Modification of code for other AVR CPU required
+#endif
+
+} /* End of enableIRQTimer4 */
+
+
+
+
+/**
+ * The top half of the timer 4 interrupt. It sets the interrupt count as data word. An
+ * event is posted only on every second interrupt. The data word of an interrupt, which
+ * returns no event, must never be seen by a task.
+ *   @return
+ * Get the events to post. Either EVT_DATA_FROM_ISR or none.
+ */
+
+uintEventVec_t onTimer4Overflow()
+{
+    ++ _cntIsr;
+    rtos_setEventDataFromISR(_cntIsr);
+    return (_cntIsr & 0x01) == 0? EVT_DATA_FROM_ISR: 0;
+
+} /* End of onTimer4Overflow */
+
+
+
+
+/**
+ * Producer task of low priority. It regularly sends the next sequence number to the
+ * consumer task. Every other time, it sends the event without data.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskProducer(uintEventVec_t initCondition)
+
+{
+    for(;;)
+    {
+        /* The sequence number is updated before sending; the consumer preempts the
+           producer and reads it. */
+        const uint16_t seqNo = ++_seqNo;
+        if((seqNo & 0x01) != 0)
+            rtos_sendEventWithData(EVT_DATA_FROM_TASK, /* data */ seqNo);
+        else
+            rtos_sendEvent(EVT_DATA_FROM_TASK);
+
+        rtos_suspendTaskTillTime(/* deltaTimeTillRelease */ TASK_PERIOD_PRODUCER);
+
+    } /* End for(ever) */
+
+} /* End of taskProducer */
+
+
+
+
+/**
+ * Consumer task of high priority, which receives the sequence numbers of the producer.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskConsumerTask(uintEventVec_t initCondition)
+
+{
+    /* The mailbox is empty after initialization. */
+    uint16_t expectedData = 0;
+
+    for(;;)
+    {
+        uint16_t data;
+        const uintEventVec_t eventVec = rtos_waitForEventWithData
+                                            ( /* eventMask */ EVT_DATA_FROM_TASK
+                                                              | RTOS_EVT_DELAY_TIMER
+                                            , /* all */       false
+                                            , /* timeout */   TIMEOUT_CONSUMER
+                                            , &data
+                                            );
+
+        /* The consumer preempts the producer. It sees each sequence number. Only those
+           sent with data change the mailbox. */
+        if(eventVec == EVT_DATA_FROM_TASK)
+        {
+            if((_seqNo & 0x01) != 0)
+            {
+                check(data == _seqNo);
+                expectedData = data;
+                ++ _noDataFromTask;
+            }
+        }
+        else
+            check(eventVec == RTOS_EVT_DELAY_TIMER);
+
+        check(data == expectedData);
+
+    } /* End for(ever) */
+
+} /* End of taskConsumerTask */
+
+
+
+
+/**
+ * Consumer task of high priority, which receives the data words of the interrupt.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskConsumerIsr(uintEventVec_t initCondition)
+
+{
+    uint16_t expectedData = 0;
+
+    for(;;)
+    {
+        uint16_t data;
+        rtos_waitForEventWithData( /* eventMask */ EVT_DATA_FROM_ISR
+                                 , /* all */       false
+                                 , /* timeout */   0
+                                 , &data
+                                 );
+
+        /* The task is resumed by every second interrupt and it is fast enough to see all
+           of them. The odd counts must not be delivered. Interrupts may have occurred
+           before the task waited for the first time. */
+        check((data & 0x01) == 0);
+        check(data == (uint16_t)(expectedData + 2)  ||  _noDataFromIsr == 0);
+        expectedData = data;
+        ++ _noDataFromIsr;
+
+    } /* End for(ever) */
+
+} /* End of taskConsumerIsr */
+
+
+
+
+/**
+ * The initalization of the RTOS tasks and general board initialization.
+ */
+
+void setup(void)
+{
+    /* Start serial port at 9600 bps. */
+    Serial.begin(9600);
+    Serial.println("\n" RTOS_RTUINOS_STARTUP_MSG);
+
+} /* End of setup */
+
+
+
+
+/**
+ * The application owned part of the idle task. This routine is repeatedly called whenever
+ * there's some execution time left. It's interrupted by any other task when it becomes
+ * due.
+ *   @remark
+ * Different to all other tasks, the idle task routine may and should return. (The task as
+ * such doesn't terminate). This has been designed in accordance with the meaning of the
+ * original Arduino loop function.
+ */
+
+void loop(void)
+{
+    Serial.print("Data from task: ");
+    Serial.print(_noDataFromTask);
+    Serial.print(", data from ISR: ");
+    Serial.print(_noDataFromIsr);
+    Serial.print(", errors: ");
+    Serial.println(_noErrors);
+
+    delay(1000);
+
+} /* End of loop */
+
+
+
+
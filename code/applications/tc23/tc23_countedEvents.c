@@ -0,0 +1,298 @@
+/**
+ * @file tc23_countedEvents.c
+ *   Test case 23 of RTuinOS. The posts of an event by an interrupt are counted by the
+ * kernel and queried with \a rtos_getNoPostedEvents, see #RTOS_COUNTED_EVENT_MASK.\n
+ *   Timer 4 is configured as application interrupt with a top half. It counts its
+ * occurrences and posts the counted event EVT_TIMER4 with about 1 kHz.\n
+ *   A task of low priority is busy for several system timer tics in each activation. The
+ * interrupt posts a burst of events meanwhile, of which the event Bit holds only one. The
+ * task processes the whole burst in its next activation; it checks that the sum of all
+ * queried counts always equals the count of the interrupt.\n
+ *   A task of high priority makes the same check. It is resumed by each interrupt and
+ * typically sees a single post. Both tasks query the same counted event; each of them
+ * gets its own count.\n
+ *   Observations:\n
+ * The idle task prints the number of activations of the task of low priority, the largest
+ * burst it has processed in one activation and the number of errors. The largest burst
+ * needs to be about five and the number of errors needs to stay zero.
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Module interface
+ *   taskBatch
+ *   taskSingle
+ *   setup
+ *   loop
+ *   enableIRQTimer4
+ *   onTimer4Overflow
+ * Local functions
+ *   check
+ *   waitForPosts
+ */
+
+/*
+ * Include files
+ */
+
+#include <Arduino.h>
+#include "rtos.h"
+#include "rtos_assert.h"
+
+
+/*
+ * Defines
+ */
+
+/** The event, which is posted by the timer 4 interrupt. It is counted, see
+    #RTOS_COUNTED_EVENT_MASK in rtos.config.h. */
+#define EVT_TIMER4  (RTOS_EVT_EVENT_00)
+
+/** The busy time of the task of low priority in each activation, in system timer tics. */
+#define TIME_BUSY   3
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The number of timer 4 interrupts. */
+static volatile uint16_t _cntIsr = 0;
+
+/** The number of activations of the task of low priority and the largest number of posts,
+    it has processed in one activation. */
+static volatile uint16_t _noActivationsBatch = 0;
+static volatile uint8_t _maxBurst = 0;
+
+/** The number of recognized errors. */
+static volatile uint16_t _noErrors = 0;
+
+
+/*
+ * Function implementation
+ */
+
+
+/**
+ * Count an error if a test condition is not fulfilled.
+ *   @param condition
+ * The expected condition.
+ */
+
+static void check(boolean condition)
+{
+    if(!condition)
+        ++ _noErrors;
+
+} /* End of check */
+
+
+
+
+/**
+ * Callback from RTuinOS: The application interrupt, timer 4 overflow, is configured and
+ * released.
+ */
+
+void enableIRQTimer4()
+{
+#ifdef __AVR_ATmega2560__
+    /* Timer 4 is reconfigured as in test case tc08: Phase and frequency correct PWM mode,
+       WGM4 = %1001, with the CPU clock divided by 1024, CS4 = %101. The frequency is
+       7812.5 Hz/OCR4A. */
+    TCCR4A &= ~0x03; /* Lower half word of WGM */
+    TCCR4A |=  0x01;
+
+    TCCR4B &= ~0x1f; /* Upper half word of WGM and CS */
+    TCCR4B |=  0x15;
+
+    /* We choose 8 as initial value, or f_irq = 976 Hz. This is about double the system
+       clock of RTuinOS in its standard configuration. */
+    OCR4A = 8u;
+
+    TIMSK4 |= 1;    /* Enable overflow interrupt. */
+#else
+# error Modification of code for other AVR CPU required
+#endif
+
+} /* End of enableIRQTimer4 */
+
+
+
+
+/**
+ * The top half of the timer 4 interrupt. It counts the interrupt and posts the counted
+ * event. Counting and posting are a single atomic operation.
+ *   @return
+ * Get the events to post.
+ */
+
+uintEventVec_t onTimer4Overflow()
+{
+    ++ _cntIsr;
+    return EVT_TIMER4;
+
+} /* End of onTimer4Overflow */
+
+
+
+
+/**
+ * Wait until at least one post of the counted event has happened since the previous query
+ * and check the sum of all queried counts against the count of the interrupt.
+ *   @return
+ * Get the number of posts since the previous call.
+ *   @param pSumOfPosts
+ * The sum of all counts so far, it is updated by reference. It is owned by the calling
+ * task.
+ */
+
+static uint8_t waitForPosts(uint16_t *pSumOfPosts)
+{
+    /* Query and suspend atomically. A post between a query, which returned null, and the
+       suspension would otherwise not wake the task. */
+    cli();
+    uint8_t noPosts = rtos_getNoPostedEvents(EVT_TIMER4);
+    if(noPosts == 0)
+    {
+        rtos_waitForEvent(/* eventMask */ EVT_TIMER4, /* all */ false, /* timeout */ 0);
+        cli();
+        noPosts = rtos_getNoPostedEvents(EVT_TIMER4);
+    }
+
+    /* The interrupt can't count meanwhile, its count needs to match exactly. */
+    *pSumOfPosts += noPosts;
+    check(*pSumOfPosts == _cntIsr);
+    sei();
+
+    check(noPosts > 0);
+    return noPosts;
+
+} /* End of waitForPosts */
+
+
+
+
+/**
+ * Task of low priority. It processes the bursts of interrupts, which happen while it is
+ * busy.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskBatch(uintEventVec_t initCondition)
+
+{
+    uint16_t sumOfPosts = 0;
+
+    for(;;)
+    {
+        const uint8_t noPosts = waitForPosts(&sumOfPosts);
+        if(noPosts > _maxBurst)
+            _maxBurst = noPosts;
+        ++ _noActivationsBatch;
+
+        const uintTime_t tiStart = rtos_getTime();
+        while((uintTime_t)(rtos_getTime() - tiStart) < TIME_BUSY)
+            ;
+
+    } /* End for(ever) */
+
+} /* End of taskBatch */
+
+
+
+
+/**
+ * Task of high priority. It is resumed by each interrupt.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskSingle(uintEventVec_t initCondition)
+
+{
+    uint16_t sumOfPosts = 0;
+
+    for(;;)
+        waitForPosts(&sumOfPosts);
+
+} /* End of taskSingle */
+
+
+
+
+/**
+ * The initalization of the RTOS tasks and general board initialization.
+ */
+
+void setup(void)
+{
+    /* Start serial port at 9600 bps. */
+    Serial.begin(9600);
+    Serial.println("\n" RTOS_RTUINOS_STARTUP_MSG);
+
+    ASSERT(EVT_TIMER4 == (RTOS_COUNTED_EVENT_MASK));
+
+} /* End of setup */
+
+
+
+
+/**
+ * The application owned part of the idle task. This routine is repeatedly called whenever
+ * there's some execution time left. It's interrupted by any other task when it becomes
+ * due.
+ *   @remark
+ * Different to all other tasks, the idle task routine may and should return. (The task as
+ * such doesn't terminate). This has been designed in accordance with the meaning of the
+ * original Arduino loop function.
+ */
+
+void loop(void)
+{
+    /* The interrupt is faster than the system timer. The task of low priority needs to see
+       bursts of posts. */
+    if(_noActivationsBatch >= 10)
+        check(_maxBurst > 1);
+
+    Serial.print("Activations: ");
+    Serial.print(_noActivationsBatch);
+    Serial.print(", largest burst: ");
+    Serial.print(_maxBurst);
+    Serial.print(", errors: ");
+    Serial.println(_noErrors);
+
+    delay(1000);
+
+} /* End of loop */
+
+
+
+
@@ -0,0 +1,314 @@
+/**
+ * @file tc24_eventVector32Bit.c
+ *   Test case 24 of RTuinOS. The kernel is configured with 32 Bit event vectors, see
+ * #RTOS_EVENT_VECTOR_WIDTH. The test uses events above Bit 15 and both application
+ * interrupts, whose events are Bit 29 and Bit 28 in this configuration.\n
+ *   Timers 4 and 5 are configured as application interrupts 00 and 01 with about 100 Hz
+ * and 5 Hz. Each of them triggers a task of high priority. The task of interrupt 00 posts
+ * the general purpose event 16 on every tenth interrupt, the task of interrupt 01 posts
+ * event 27 on every interrupt. A task of low priority waits for both events at a time. The
+ * tasks check that they are resumed by exactly the expected event vector, including the
+ * timer event in Bit 31, which starts them.\n
+ *   Observations:\n
+ * The idle task prints the number of interrupts 00 and 01, the number of activations of
+ * the task of low priority and the number of errors. The activations of the task of low
+ * priority need to follow the interrupts 01 and the number of errors needs to stay zero.
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Module interface
+ *   taskIsr00
+ *   taskIsr01
+ *   taskReceiver
+ *   setup
+ *   loop
+ *   rtos_enableIRQUser00
+ *   rtos_enableIRQUser01
+ * Local functions
+ *   check
+ */
+
+/*
+ * Include files
+ */
+
+#include <Arduino.h>
+#include "rtos.h"
+#include "rtos_assert.h"
+
+
+/*
+ * Defines
+ */
+
+/** The events, which are posted by the tasks of the interrupts. */
+#define EVT_FROM_ISR_00 (RTOS_EVT_EVENT_16)
+#define EVT_FROM_ISR_01 (RTOS_EVT_EVENT_27)
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The number of interrupts 00 and 01 and the number of activations of the task of low
+    priority. */
+static volatile uint16_t _cntIsr00 = 0;
+static volatile uint16_t _cntIsr01 = 0;
+static volatile uint16_t _cntReceiver = 0;
+
+/** The number of recognized errors. */
+static volatile uint16_t _noErrors = 0;
+
+
+/*
+ * Function implementation
+ */
+
+
+/**
+ * Count an error if a test condition is not fulfilled.
+ *   @param condition
+ * The expected condition.
+ */
+
+static void check(boolean condition)
+{
+    if(!condition)
+        ++ _noErrors;
+
+} /* End of check */
+
+
+
+
+/**
+ * Callback from RTuinOS: The application interrupt 00, timer 4 overflow, is configured
+ * and released.
+ */
+
+void rtos_enableIRQUser00()
+{
+#ifdef __AVR_ATmega2560__
+    /* Timer 4 is reconfigured as in test case tc08: Phase and frequency correct PWM mode,
+       WGM4 = %1001, with the CPU clock divided by 1024, CS4 = %101. The frequency is
+       7812.5 Hz/OCR4A. */
+    TCCR4A &= ~0x03; /* Lower half word of WGM */
+    TCCR4A |=  0x01;
+
+    TCCR4B &= ~0x1f; /* Upper half word of WGM and CS */
+    TCCR4B |=  0x15;
+
+    /* We choose 78 as initial value, or f_irq = 100 Hz. */
+    OCR4A = 78u;
+
+    TIMSK4 |= 1;    /* Enable overflow interrupt. */
+#else
+# error Modification of code for other AVR CPU required
+#endif
+
+} /* End of rtos_enableIRQUser00 */
+
+
+
+
+/**
+ * Callback from RTuinOS: The application interrupt 01, timer 5 overflow, is configured
+ * and released.
+ */
+
+void rtos_enableIRQUser01()
+{
+#ifdef __AVR_ATmega2560__
+    /* Timer 5 is reconfigured in the same way as timer 4, see rtos_enableIRQUser00. */
+    TCCR5A &= ~0x03; /* Lower half word of WGM */
+    TCCR5A |=  0x01;
+
+    TCCR5B &= ~0x1f; /* Upper half word of WGM and CS */
+    TCCR5B |=  0x15;
+
+    /* We choose 1563 as initial value, or f_irq = 5 Hz. */
+    OCR5A = 1563u;
+
+    TIMSK5 |= 1;    /* Enable overflow interrupt. */
+#else
+# error Modification of code for other AVR CPU required
+#endif
+
+} /* End of rtos_enableIRQUser01 */
+
+
+
+
+/**
+ * Task of high priority, which is triggered by application interrupt 00. It posts event
+ * 16 on every tenth interrupt.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskIsr00(uintEventVec_t initCondition)
+
+{
+    /* The start event is the delay timer in the most significant Bit. */
+    check(initCondition == RTOS_EVT_DELAY_TIMER);
+
+    for(;;)
+    {
+        const uintEventVec_t eventVec =
+                rtos_waitForEvent(/* eventMask */ RTOS_EVT_ISR_USER_00, /* all */ false, 0);
+        check(eventVec == RTOS_EVT_ISR_USER_00);
+
+        if(++_cntIsr00 % 10 == 0)
+            rtos_sendEvent(EVT_FROM_ISR_00);
+
+    } /* End for(ever) */
+
+} /* End of taskIsr00 */
+
+
+
+
+/**
+ * Task of high priority, which is triggered by application interrupt 01. It posts event
+ * 27 on every interrupt.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskIsr01(uintEventVec_t initCondition)
+
+{
+    check(initCondition == RTOS_EVT_DELAY_TIMER);
+
+    for(;;)
+    {
+        const uintEventVec_t eventVec =
+                rtos_waitForEvent(/* eventMask */ RTOS_EVT_ISR_USER_01, /* all */ false, 0);
+        check(eventVec == RTOS_EVT_ISR_USER_01);
+
+        ++ _cntIsr01;
+        rtos_sendEvent(EVT_FROM_ISR_01);
+
+    } /* End for(ever) */
+
+} /* End of taskIsr01 */
+
+
+
+
+/**
+ * Task of low priority, which waits for both events posted by the tasks of the
+ * interrupts.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskReceiver(uintEventVec_t initCondition)
+
+{
+    check(initCondition == RTOS_EVT_DELAY_TIMER);
+
+    for(;;)
+    {
+        const uintEventVec_t eventVec =
+                rtos_waitForEvent( /* eventMask */ EVT_FROM_ISR_00 | EVT_FROM_ISR_01
+                                 , /* all */       true
+                                 , /* timeout */   0
+                                 );
+        check(eventVec == (EVT_FROM_ISR_00 | EVT_FROM_ISR_01));
+        ++ _cntReceiver;
+
+    } /* End for(ever) */
+
+} /* End of taskReceiver */
+
+
+
+
+/**
+ * The initalization of the RTOS tasks and general board initialization.
+ */
+
+void setup(void)
+{
+    /* Start serial port at 9600 bps. */
+    Serial.begin(9600);
+    Serial.println("\n" RTOS_RTUINOS_STARTUP_MSG);
+
+    /* The configuration places the events where this test expects them. */
+    ASSERT(sizeof(uintEventVec_t) == 4);
+    ASSERT(RTOS_EVT_ISR_USER_00 == RTOS_EVT(29)  &&  RTOS_EVT_ISR_USER_01 == RTOS_EVT(28));
+    ASSERT(RTOS_EVT_DELAY_TIMER == 0x80000000ul);
+
+} /* End of setup */
+
+
+
+
+/**
+ * The application owned part of the idle task. This routine is repeatedly called whenever
+ * there's some execution time left. It's interrupted by any other task when it becomes
+ * due.
+ *   @remark
+ * Different to all other tasks, the idle task routine may and should return. (The task as
+ * such doesn't terminate). This has been designed in accordance with the meaning of the
+ * original Arduino loop function.
+ */
+
+void loop(void)
+{
+    cli();
+    const uint16_t cntIsr00 = _cntIsr00
+                 , cntIsr01 = _cntIsr01
+                 , cntReceiver = _cntReceiver;
+    sei();
+
+    /* Event 16 is posted twice between two posts of event 27. Only the very first post of
+       event 27 may come before event 16. */
+    check(cntReceiver <= cntIsr01  &&  cntReceiver + 1 >= cntIsr01);
+
+    Serial.print("Interrupts 00: ");
+    Serial.print(cntIsr00);
+    Serial.print(", interrupts 01: ");
+    Serial.print(cntIsr01);
+    Serial.print(", receiver: ");
+    Serial.print(cntReceiver);
+    Serial.print(", errors: ");
+    Serial.println(_noErrors);
+
+    delay(1000);
+
+} /* End of loop */
+
+
+
+
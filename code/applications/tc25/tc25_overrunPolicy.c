@@ -0,0 +1,336 @@
+/**
+ * @file tc25_overrunPolicy.c
+ *   Test case 25 of RTuinOS. The overrun policies of a regular task are selected with \a
+ * rtos_setTaskOverrunPolicy, see #RTOS_USE_OVERRUN_POLICY.\n
+ *   A worker task of low priority has a period of ten tics. In each activation it is busy
+ * for 25 tics, so it misses the due times of two activations and recognizes an overrun in
+ * its call of \a rtos_suspendTaskTillTime. The activations cycle through the policies:\n
+ *   RTOS_OVERRUN_POLICY_CATCH_UP: The two missed activations are made up without
+ * suspending the task; both calls of \a rtos_suspendTaskTillTime return in the same tic.
+ * The worker is the only due task, it is left and at once becomes the active task again.
+ * The third call suspends the task until the next point in time on its time grid.\n
+ *   RTOS_OVERRUN_POLICY_SKIP: The missed activations are dropped; the task is resumed at
+ * the next point in time on its time grid.\n
+ *   RTOS_OVERRUN_POLICY_DEFAULT combined with RTOS_OVERRUN_CALL_HOOK: The task is resumed
+ * in the next tic. The callback \a rtos_onTaskOverrun is invoked.\n
+ *   RTOS_OVERRUN_POLICY_SKIP combined with RTOS_OVERRUN_SEND_EVENT: A supervisor task of
+ * high priority waits for the event #RTOS_EVT_TASK_OVERRUN. It is resumed before the
+ * worker continues.\n
+ *   The same policy is applied a second time while the supervisor is busy: At the release
+ * of the worker, the supervisor is triggered to do something else until after the
+ * overrun. The event is kept pending and the supervisor gets it when it waits for it
+ * again, still before the worker continues.\n
+ *   The worker checks the time of its resume, the overrun counter and the number of
+ * notifications, which need to be seen only if requested by the policy.\n
+ *   Observations:\n
+ * The idle task prints the number of completed activations of the worker, the number of
+ * notifications and the number of errors. The number of errors needs to stay zero.
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Module interface
+ *   taskWorker
+ *   taskSupervisor
+ *   setup
+ *   loop
+ *   rtos_onTaskOverrun
+ * Local functions
+ *   check
+ */
+
+/*
+ * Include files
+ */
+
+#include <Arduino.h>
+#include "rtos.h"
+#include "rtos_assert.h"
+
+
+/*
+ * Defines
+ */
+
+/** The busy time of the worker task in each activation, in system timer tics. It is more
+    than two periods. */
+#define TIME_BUSY   25
+
+/** The time, which the supervisor task is busy with something else, if it is triggered at
+    the release of the worker task, in system timer tics. It ends after the overrun of the
+    worker and before the worker is resumed on its time grid. */
+#define TIME_SUPERVISOR_BUSY    (TIME_BUSY+2)
+
+/* The expected resume time of policy RTOS_OVERRUN_POLICY_DEFAULT requires the overrunning
+   task to become due in the next tic. */
+#if RTOS_OVERRUN_TASK_IS_IMMEDIATELY_DUE != RTOS_FEATURE_ON
+# error Test case requires RTOS_OVERRUN_TASK_IS_IMMEDIATELY_DUE to be on
+#endif
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The overrun policies, which are applied in turn in the activations of the worker, and
+    whether the supervisor task is busy with something else, when the overrun happens. */
+static const struct
+{
+    uint8_t policy;
+    boolean isSupervisorBusy;
+
+} _policyAry[] =
+    { {RTOS_OVERRUN_POLICY_CATCH_UP, false}
+    , {RTOS_OVERRUN_POLICY_SKIP, false}
+    , {RTOS_OVERRUN_POLICY_DEFAULT | RTOS_OVERRUN_CALL_HOOK, false}
+    , {RTOS_OVERRUN_POLICY_SKIP | RTOS_OVERRUN_SEND_EVENT, false}
+    , {RTOS_OVERRUN_POLICY_SKIP | RTOS_OVERRUN_SEND_EVENT, true}
+    };
+
+/** The number of completed activations of the worker task. */
+static volatile uint16_t _cntWorker = 0;
+
+/** The number of invocations of the overrun callback and the number of overrun events
+    received by the supervisor task. */
+static volatile uint16_t _noHookCalls = 0;
+static volatile uint16_t _noOverrunEvents = 0;
+
+/** The number of recognized errors. */
+static volatile uint16_t _noErrors = 0;
+
+
+/*
+ * Function implementation
+ */
+
+
+/**
+ * Count an error if a test condition is not fulfilled.
+ *   @param condition
+ * The expected condition.
+ */
+
+static void check(boolean condition)
+{
+    if(!condition)
+        ++ _noErrors;
+
+} /* End of check */
+
+
+
+
+/**
+ * Callback from RTuinOS: A task with policy RTOS_OVERRUN_CALL_HOOK has recognized an
+ * overrun. The function is called with globally disabled interrupts.
+ *   @param idxTask
+ * The index of the overrunning task.
+ */
+
+void rtos_onTaskOverrun(uint8_t idxTask)
+{
+    check(idxTask == rtos_idxTask_taskWorker);
+    ++ _noHookCalls;
+
+} /* End of rtos_onTaskOverrun */
+
+
+
+
+/**
+ * Worker task of low priority. Each activation is too long and it applies the next
+ * overrun policy.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskWorker(uintEventVec_t initCondition)
+
+{
+    uint8_t idxPolicy = 0;
+
+    /* The first activation is released by the absolute timer; it defines the time grid. */
+    check(initCondition == RTOS_EVT_ABSOLUTE_TIMER);
+
+    for(;;)
+    {
+        const uint8_t policy = _policyAry[idxPolicy].policy;
+        rtos_setTaskOverrunPolicy(rtos_idxTask_taskWorker, policy);
+        rtos_getTaskOverrunCounter(rtos_idxTask_taskWorker, /* doReset */ true);
+        const uint16_t noHookCalls = _noHookCalls
+                     , noOverrunEvents = _noOverrunEvents;
+
+        /* The task has just been released at a point in time on its time grid. */
+        const uintTime_t tiGrid = rtos_getTime();
+
+        /* The supervisor preempts the worker and becomes busy with something else. It
+           doesn't wait for the overrun event when it is posted. */
+        if(_policyAry[idxPolicy].isSupervisorBusy)
+            rtos_sendEvent(EVT_SUPERVISOR_BUSY);
+
+        while((uintTime_t)(rtos_getTime() - tiGrid) < TIME_BUSY)
+            ;
+
+        uint8_t noOverruns;
+        uintTime_t tiResume;
+        if((policy & RTOS_OVERRUN_POLICY_CATCH_UP) != 0)
+        {
+            /* Both missed activations are made up at once. The task is put into the list
+               of due tasks again, it is the only one and it is not left. */
+            check(rtos_suspendTaskTillTime(/* deltaTimeTillRelease */ TASK_PERIOD)
+                  == RTOS_EVT_ABSOLUTE_TIMER
+                 );
+            check((uintTime_t)(rtos_getTime() - tiGrid) == TIME_BUSY);
+            check(rtos_suspendTaskTillTime(/* deltaTimeTillRelease */ TASK_PERIOD)
+                  == RTOS_EVT_ABSOLUTE_TIMER
+                 );
+            check((uintTime_t)(rtos_getTime() - tiGrid) == TIME_BUSY);
+
+            /* The time grid is kept. */
+            noOverruns = 2;
+            tiResume = 3*TASK_PERIOD;
+        }
+        else if((policy & RTOS_OVERRUN_POLICY_SKIP) != 0)
+        {
+            /* The time grid is kept. */
+            noOverruns = 1;
+            tiResume = 3*TASK_PERIOD;
+        }
+        else
+        {
+            /* The task becomes due in the next tic. The time grid is shifted. */
+            noOverruns = 1;
+            tiResume = TIME_BUSY+1;
+        }
+
+        check(rtos_suspendTaskTillTime(/* deltaTimeTillRelease */ TASK_PERIOD)
+              == RTOS_EVT_ABSOLUTE_TIMER
+             );
+        check((uintTime_t)(rtos_getTime() - tiGrid) == tiResume);
+
+        /* The notifications are seen only if requested by the policy. The event is posted
+           in the tic after the overrun or, if the supervisor is busy, in the tic after the
+           supervisor waits for it again; the supervisor has processed it before the worker
+           is resumed. */
+        check(rtos_getTaskOverrunCounter(rtos_idxTask_taskWorker, /* doReset */ false)
+              == noOverruns
+             );
+        check(_noHookCalls - noHookCalls
+              == ((policy & RTOS_OVERRUN_CALL_HOOK) != 0? noOverruns: 0)
+             );
+        check(_noOverrunEvents - noOverrunEvents
+              == ((policy & RTOS_OVERRUN_SEND_EVENT) != 0? 1: 0)
+             );
+
+        ++ _cntWorker;
+        if(++idxPolicy == sizeof(_policyAry)/sizeof(_policyAry[0]))
+            idxPolicy = 0;
+
+    } /* End for(ever) */
+
+} /* End of taskWorker */
+
+
+
+
+/**
+ * Supervisor task of high priority, which is notified about task overruns. On demand of
+ * the worker, it is busy with something else for a while and doesn't wait for the
+ * notification.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskSupervisor(uintEventVec_t initCondition)
+
+{
+    for(;;)
+    {
+        const uintEventVec_t eventVec =
+                rtos_waitForEvent( /* eventMask */ EVT_TASK_OVERRUN | EVT_SUPERVISOR_BUSY
+                                 , /* all */       false
+                                 , /* timeout */   0
+                                 );
+        if((eventVec & EVT_TASK_OVERRUN) != 0)
+            ++ _noOverrunEvents;
+        if((eventVec & EVT_SUPERVISOR_BUSY) != 0)
+        {
+            /* Being busy means here, waiting for something else than the overrun. */
+            rtos_delay(TIME_SUPERVISOR_BUSY);
+        }
+    } /* End for(ever) */
+
+} /* End of taskSupervisor */
+
+
+
+
+/**
+ * The initalization of the RTOS tasks and general board initialization.
+ */
+
+void setup(void)
+{
+    /* Start serial port at 9600 bps. */
+    Serial.begin(9600);
+    Serial.println("\n" RTOS_RTUINOS_STARTUP_MSG);
+
+} /* End of setup */
+
+
+
+
+/**
+ * The application owned part of the idle task. This routine is repeatedly called whenever
+ * there's some execution time left. It's interrupted by any other task when it becomes
+ * due.
+ *   @remark
+ * Different to all other tasks, the idle task routine may and should return. (The task as
+ * such doesn't terminate). This has been designed in accordance with the meaning of the
+ * original Arduino loop function.
+ */
+
+void loop(void)
+{
+    Serial.print("Activations: ");
+    Serial.print(_cntWorker);
+    Serial.print(", hook calls: ");
+    Serial.print(_noHookCalls);
+    Serial.print(", overrun events: ");
+    Serial.print(_noOverrunEvents);
+    Serial.print(", errors: ");
+    Serial.println(_noErrors);
+
+    delay(1000);
+
+} /* End of loop */
+
+
+
+
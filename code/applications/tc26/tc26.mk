@@ -0,0 +1,33 @@
+# 
+# Makefile for GNU Make 3.81
+#
+# Included makefile fragment, which specifies some application dependent settings.
+#   Test case tc26 lets RTuinOS provide the Arduino time functions millis(), micros() and
+# delay(), see RTOS_PROVIDE_ARDUINO_TIME in rtos.config.h. The linker needs to redirect
+# the calls of these library functions to the substitutes implemented by RTuinOS.
+#   Remark: The name of this makefile fragment needs to be identical to the name of the
+# application folder, which is located in RTuinOS/code/applications. The name extension is
+# mk and the makefile needs to be located in the root of the application folder.
+#
+# Help on the syntax of this makefile is got at
+# http://www.gnu.org/software/make/manual/make.pdf.
+#
+# Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+#
+# This program is free software: you can redistribute it and/or modify it
+# under the terms of the GNU Lesser General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+# FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+# for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+# The Arduino time functions are implemented by RTuinOS. This setting needs to match
+# RTOS_PROVIDE_ARDUINO_TIME in rtos.config.h.
+WRAP_ARDUINO_TIME = 1
+$(info tc26.mk: tc26 lets RTuinOS provide millis(), micros() and delay())
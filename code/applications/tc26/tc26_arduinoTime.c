@@ -0,0 +1,301 @@
+/**
+ * @file tc26_arduinoTime.c
+ *   Test case 26 of RTuinOS. RTuinOS provides the Arduino time functions millis(),
+ * micros() and delay(), see #RTOS_PROVIDE_ARDUINO_TIME and tc26.mk. They are derived from
+ * the built-in CTC system timer.\n
+ *   The substitutes are checked against an independent time reference: Timer 5 is
+ * free-running in normal mode with a prescaler of 64, it counts in units of 4 us. RTuinOS
+ * doesn't touch this timer. A regular task reads the counter of timer 5 and micros() in
+ * each of its cycles. The time, which has elapsed according to micros(), needs to match
+ * the time elapsed according to the reference up to the resolution of the reference. This
+ * is checked for each cycle and for the sum of all cycles; a difference of the sums would
+ * indicate a drift of micros(). Furthermore, the task checks that millis() doesn't drift
+ * away from micros().\n
+ *   The idle task measures the duration of calls of delay() with the reference timer. The
+ * busy wait may be prolonged by the regular task, which can interrupt it at its end, but it
+ * must never be shorter than demanded.\n
+ *   Observations:\n
+ * The console shows the elapsed time according to micros() and according to the reference
+ * timer, the last measured duration of delay() and the numbers of errors, which need to
+ * stay zero.
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Module interface
+ *   taskMeasure
+ *   setup
+ *   loop
+ * Local functions
+ *   readReferenceTimer
+ */
+
+/*
+ * Include files
+ */
+
+#include <Arduino.h>
+#include "rtos.h"
+#include "rtos_assert.h"
+
+
+/*
+ * Defines
+ */
+
+/** The period time of the regular task in system timer tics. It is about 100 ms. This is
+    less than the cycle time of the reference timer, which is about 262 ms. */
+#define TASK_PERIOD ((uintTime_t)(0.1/RTOS_TIC + 0.5))
+
+/** The resolution of the reference timer in us. Timer 5 is operated with prescaler 64. */
+#define US_PER_REF_TIC  (64ul/(F_CPU/1000000ul))
+
+/** The tolerated difference of micros() and the reference timer in us. It is the
+    resolution of the reference plus the resolution of micros(), rounded up. */
+#define TOLERANCE_MICROS    (2*US_PER_REF_TIC)
+
+/** The time to wait in each measurement of delay() in ms. It needs to be less than the
+    cycle time of the reference timer. */
+#define TIME_DELAY          50
+
+/** The tolerated prolongation of delay() in us. The regular task may interrupt the busy
+    wait at its end. */
+#define TOLERANCE_DELAY     1000ul
+
+#if RTOS_PROVIDE_ARDUINO_TIME != RTOS_FEATURE_ON
+# error Test case requires RTOS_PROVIDE_ARDUINO_TIME to be on
+#endif
+
+
+/*
+ * Local type definitions
+ */
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The time elapsed since the start of the measurement according to micros() and
+    according to the reference timer, in us. */
+static volatile uint32_t _tiMicros = 0
+                       , _tiReference = 0;
+
+/** The number of task cycles, in which micros() deviated from the reference timer and in
+    which millis() had drifted away from micros(). */
+static volatile uint16_t _noErrMicros = 0
+                       , _noErrMillis = 0;
+
+/** The last measured duration of delay(TIME_DELAY) in us. */
+static volatile uint32_t _tiDelay = 0;
+
+/** The number of measurements of delay(), which were too short or too long. */
+static volatile uint16_t _noErrDelay = 0;
+
+
+/*
+ * Function implementation
+ */
+
+
+/**
+ * Read the counter of the reference timer, timer 5. The 16 Bit register is read with
+ * globally disabled interrupts, since the interrupts access the 16 Bit registers of the
+ * system timer through the same temporary register of the CPU.
+ *   @return
+ * Get the counter value in units of #US_PER_REF_TIC.
+ */
+
+static uint16_t readReferenceTimer(void)
+{
+    uint16_t cnt;
+
+    cli();
+    cnt = TCNT5;
+    sei();
+
+    return cnt;
+
+} /* End of readReferenceTimer */
+
+
+
+
+/**
+ * The regular task of this test case. It compares micros() and millis() with the
+ * reference timer.
+ *   @param initCondition
+ * Which events made the task run the very first time?
+ *   @remark
+ * A task function must never return; this would cause a reset.
+ */
+
+void taskMeasure(uintEventVec_t initCondition)
+
+{
+    uint16_t cntRefLast;
+    uint32_t tiUsLast;
+
+    /* millis() and micros() continue with the values of the Arduino library at the start
+       of RTuinOS. These are not exactly consistent with one another; we expect a constant
+       offset, which is taken in the first cycle. */
+    int32_t offsetMillis = 0;
+    boolean isFirstCycle = true;
+
+    /* Both clocks are read in the same critical section. micros() doesn't touch the global
+       interrupt enable flag. */
+    cli();
+    cntRefLast = TCNT5;
+    tiUsLast = micros();
+    sei();
+
+    for(;;)
+    {
+        rtos_suspendTaskTillTime(/* deltaTimeTillRelease */ TASK_PERIOD);
+
+        cli();
+        const uint16_t cntRef = TCNT5;
+        const uint32_t tiUs = micros();
+        sei();
+        const uint32_t tiMs = millis();
+
+        /* The elapsed time in this cycle. The cycle is shorter than the cycle time of the
+           reference timer. */
+        const uint32_t deltaRef = (uint16_t)(cntRef - cntRefLast) * US_PER_REF_TIC
+                     , deltaUs = tiUs - tiUsLast;
+        cntRefLast = cntRef;
+        tiUsLast = tiUs;
+
+        /* The sums are cyclic, but their difference is not affected by a wrap-around. */
+        const uint32_t tiReference = _tiReference + deltaRef
+                     , tiMicros = _tiMicros + deltaUs;
+        const int32_t drift = (int32_t)(tiMicros - tiReference);
+        if(deltaUs + TOLERANCE_MICROS < deltaRef  ||  deltaUs > deltaRef + TOLERANCE_MICROS
+           ||  drift < -(int32_t)TOLERANCE_MICROS  ||  drift > (int32_t)TOLERANCE_MICROS
+          )
+        {
+            ++ _noErrMicros;
+        }
+        cli();
+        _tiReference = tiReference;
+        _tiMicros = tiMicros;
+        sei();
+
+        /* micros() is read first, millis() can have advanced meanwhile by at most a unit.
+           The difference is computed in us to be robust against the wrap-around of
+           micros(). */
+        const int32_t offset = (int32_t)(tiUs - tiMs*1000u) / 1000;
+        if(isFirstCycle)
+        {
+            offsetMillis = offset;
+            isFirstCycle = false;
+        }
+        else if(offset < offsetMillis-1  ||  offset > offsetMillis+1)
+            ++ _noErrMillis;
+
+    } /* End for(ever) */
+
+} /* End of taskMeasure */
+
+
+
+
+/**
+ * The initalization of the RTOS tasks and general board initialization.
+ */
+
+void setup(void)
+{
+    /* Start serial port at 9600 bps. */
+    Serial.begin(9600);
+    Serial.println("\n" RTOS_RTUINOS_STARTUP_MSG);
+
+    /* The Arduino library has configured timer 5 for PWM. It becomes the free-running
+       reference timer: normal mode, prescaler 64, no interrupts. */
+    TIMSK5 = 0;
+    TCCR5A = 0;
+    TCCR5B = _BV(CS51) | _BV(CS50);
+
+} /* End of setup */
+
+
+
+
+/**
+ * The application owned part of the idle task. This routine is repeatedly called whenever
+ * there's some execution time left. It's interrupted by any other task when it becomes
+ * due.
+ *   @remark
+ * Different to all other tasks, the idle task routine may and should return. (The task as
+ * such doesn't terminate). This has been designed in accordance with the meaning of the
+ * original Arduino loop function.
+ */
+
+void loop(void)
+{
+    uint32_t tiMicros, tiReference;
+
+    /* Measure the duration of delay() with the reference timer. */
+    const uint16_t cntStart = readReferenceTimer();
+    delay(TIME_DELAY);
+    const uint32_t tiDelay = (uint16_t)(readReferenceTimer() - cntStart) * US_PER_REF_TIC;
+    if(tiDelay + US_PER_REF_TIC < TIME_DELAY*1000ul
+       ||  tiDelay > TIME_DELAY*1000ul + TOLERANCE_DELAY
+      )
+    {
+        ++ _noErrDelay;
+    }
+    _tiDelay = tiDelay;
+
+    cli();
+    tiMicros = _tiMicros;
+    tiReference = _tiReference;
+    sei();
+
+    Serial.print("Elapsed time [us] micros(): ");
+    Serial.print(tiMicros);
+    Serial.print(", reference: ");
+    Serial.println(tiReference);
+
+    Serial.print("Duration of delay(");
+    Serial.print(TIME_DELAY);
+    Serial.print(") [us]: ");
+    Serial.println(_tiDelay);
+
+    Serial.print("Errors of micros(): ");
+    Serial.print(_noErrMicros);
+    Serial.print(", millis(): ");
+    Serial.print(_noErrMillis);
+    Serial.print(", delay(): ");
+    Serial.println(_noErrDelay);
+
+    Serial.print("Task overruns: ");
+    Serial.println(rtos_getTaskOverrunCounter( /* idxTask */ rtos_idxTask_taskMeasure
+                                             , /* doReset */ false
+                                             )
+                  );
+
+    delay(1000);
+
+} /* End of loop */
+
+
+
+
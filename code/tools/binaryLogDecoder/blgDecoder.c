@@ -0,0 +1,434 @@
+/**
+ * @file blgDecoder.c
+ *   Host side decoder of the binary log, which is written by module blg_binaryLog.c of an
+ * RTuinOS application. The log records contain the flash ROM address of a printf format
+ * string and the raw bytes of the arguments. This program reads the format strings from
+ * the ELF file of the application, which has been produced by the build, and renders the
+ * log as text. All bytes outside of log records are passed as they are, so plain text
+ * output of the application may be interleaved with the log.\n
+ *   This is a program for the host computer, it is not part of an RTuinOS application.
+ * Compile it with any C compiler, e.g. gcc -o blgDecoder blgDecoder.c.\n
+ *   Usage: blgDecoder <applicationElfFile> [<binaryLogFile>]\n
+ * If no log file is given, the log is read from stdin. The output is written to stdout.
+ *
+ * Copyright (C) 2013 Peter Vranken (mailto:Peter_Vranken@Yahoo.de)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Module interface
+ *   main
+ * Local functions
+ *   readLE
+ *   loadElfFile
+ *   getFormatString
+ *   readArg
+ *   renderRecord
+ */
+
+/*
+ * Include files
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+ * Defines
+ */
+
+/** The byte, which starts each record in the log. Needs to be identical to the definition
+    in blg_binaryLog.h. */
+#define BLG_RECORD_START        0xa5
+
+/** Addresses at and above this boundary don't belong to the flash ROM in an AVR ELF
+    file. */
+#define AVR_RAM_ADDRESS_OFFSET  0x800000ul
+
+/** The ELF section type of sections with program data. */
+#define SHT_PROGBITS            1
+
+/** The ELF section flag of sections, which occupy memory in the target. */
+#define SHF_ALLOC               0x2
+
+
+/*
+ * Local type definitions
+ */
+
+/** A section of the ELF file, which is loaded into the flash ROM. */
+typedef struct
+{
+    /** The address of the section in flash ROM. */
+    unsigned long address;
+
+    /** The size of the section in Byte. */
+    unsigned long size;
+
+    /** The contents of the section. */
+    unsigned char *data;
+
+} section_t;
+
+
+/*
+ * Local prototypes
+ */
+
+
+/*
+ * Data definitions
+ */
+
+/** The flash ROM sections of the ELF file. */
+static section_t _sectionAry[64];
+
+/** The number of used elements of _sectionAry. */
+static unsigned int _noSections = 0;
+
+
+/*
+ * Function implementation
+ */
+
+/**
+ * Read an unsigned little endian integer.
+ *   @return
+ * Get the value.
+ *   @param p
+ * The address of the first byte.
+ *   @param noBytes
+ * The number of bytes of the integer, 1..4.
+ */
+
+static unsigned long readLE(const unsigned char *p, unsigned int noBytes)
+{
+    unsigned long value = 0;
+    while(noBytes-- > 0)
+        value = (value << 8) | p[noBytes];
+    return value;
+
+} /* End of readLE */
+
+
+
+
+/**
+ * Load the ELF file of the application and keep all sections, which are loaded into the
+ * flash ROM.
+ *   @return
+ * Get 0 if the file could be loaded, -1 otherwise. An error message has been printed.
+ *   @param fileName
+ * The name of the ELF file.
+ */
+
+static int loadElfFile(const char *fileName)
+{
+    FILE *hFile = fopen(fileName, "rb");
+    if(hFile == NULL)
+    {
+        fprintf(stderr, "Can't open ELF file %s\n", fileName);
+        return -1;
+    }
+
+    fseek(hFile, 0, SEEK_END);
+    long sizeOfFile = ftell(hFile);
+    fseek(hFile, 0, SEEK_SET);
+    unsigned char *elf = malloc(sizeOfFile > 0? (size_t)sizeOfFile: 1);
+    if(elf == NULL  ||  fread(elf, 1, (size_t)sizeOfFile, hFile) != (size_t)sizeOfFile)
+    {
+        fprintf(stderr, "Can't read ELF file %s\n", fileName);
+        fclose(hFile);
+        return -1;
+    }
+    fclose(hFile);
+
+    /* Only 32 Bit little endian ELF files are supported, which is what avr-gcc produces. */
+    if(sizeOfFile < 0x34  ||  memcmp(elf, "\x7f" "ELF", 4) != 0  ||  elf[4] != 1
+       ||  elf[5] != 1
+      )
+    {
+        fprintf(stderr, "%s is not a 32 Bit little endian ELF file\n", fileName);
+        return -1;
+    }
+
+    const unsigned long offSectionTable = readLE(elf+0x20, 4)
+                      , sizeOfSectionHeader = readLE(elf+0x2e, 2)
+                      , noSectionHeaders = readLE(elf+0x30, 2);
+    unsigned long idxSection;
+    for(idxSection=0; idxSection<noSectionHeaders; ++idxSection)
+    {
+        const unsigned long offHeader = offSectionTable + idxSection*sizeOfSectionHeader;
+        if(offHeader + 0x28 > (unsigned long)sizeOfFile)
+            break;
+
+        const unsigned char *pHeader = elf + offHeader;
+        const unsigned long type = readLE(pHeader+0x04, 4)
+                          , flags = readLE(pHeader+0x08, 4)
+                          , address = readLE(pHeader+0x0c, 4)
+                          , offset = readLE(pHeader+0x10, 4)
+                          , size = readLE(pHeader+0x14, 4);
+
+        if(type == SHT_PROGBITS  &&  (flags & SHF_ALLOC) != 0
+           &&  address < AVR_RAM_ADDRESS_OFFSET  &&  offset + size <= (unsigned long)sizeOfFile
+           &&  _noSections < sizeof(_sectionAry)/sizeof(_sectionAry[0])
+          )
+        {
+            _sectionAry[_noSections].address = address;
+            _sectionAry[_noSections].size = size;
+            _sectionAry[_noSections].data = elf + offset;
+            ++ _noSections;
+        }
+    }
+
+    if(_noSections == 0)
+    {
+        fprintf(stderr, "%s doesn't contain any flash ROM section\n", fileName);
+        return -1;
+    }
+
+    return 0;
+
+} /* End of loadElfFile */
+
+
+
+
+/**
+ * Look up a format string in the flash ROM sections of the ELF file.
+ *   @return
+ * Get the format string or NULL if the address doesn't point to a null terminated string
+ * in the flash ROM.
+ *   @param address
+ * The flash ROM address as found in the log record.
+ */
+
+static const char *getFormatString(unsigned long address)
+{
+    unsigned int u;
+    for(u=0; u<_noSections; ++u)
+    {
+        const section_t *pS = &_sectionAry[u];
+        if(address >= pS->address  &&  address < pS->address + pS->size)
+        {
+            const unsigned long offset = address - pS->address;
+            if(memchr(pS->data + offset, '\0', pS->size - offset) != NULL)
+                return (const char*)pS->data + offset;
+            else
+                return NULL;
+        }
+    }
+    return NULL;
+
+} /* End of getFormatString */
+
+
+
+
+/**
+ * Read the next byte(s) of an argument from the log stream.
+ *   @return
+ * Get 0 if all bytes could be read, -1 at end of file.
+ *   @param hLog
+ * The log stream.
+ *   @param pValue
+ * The unsigned value of the argument is returned by reference.
+ *   @param noBytes
+ * The size of the argument in the log, 2 or 4 Byte.
+ */
+
+static int readArg(FILE *hLog, unsigned long *pValue, unsigned int noBytes)
+{
+    unsigned char buf[4];
+    if(fread(buf, 1, noBytes, hLog) != noBytes)
+        return -1;
+    *pValue = readLE(buf, noBytes);
+    return 0;
+
+} /* End of readArg */
+
+
+
+
+/**
+ * Render a single record: The conversions of the format string are done one by one with
+ * the printf of the host. The size of the arguments in the log is the one of the AVR
+ * target: int has 16 Bit, long and float have 32 Bit and double is identical to float.
+ *   @return
+ * Get 0 if the record could be rendered, -1 at end of file.
+ *   @param hLog
+ * The log stream. Its position is behind the address of the format string.
+ *   @param fmtString
+ * The format string of the record.
+ */
+
+static int renderRecord(FILE *hLog, const char *fmtString)
+{
+    const char *p = fmtString;
+    while(*p != '\0')
+    {
+        if(*p != '%')
+        {
+            putchar(*p++);
+            continue;
+        }
+
+        /* Isolate the next conversion specification. */
+        char spec[32];
+        unsigned int lenSpec = 0
+                   , noLongModifiers = 0;
+        spec[lenSpec++] = *p++;
+        while(*p != '\0'  &&  strchr("-+ #0123456789.hl", *p) != NULL
+              &&  lenSpec < sizeof(spec)-3
+             )
+        {
+            if(*p == 'l')
+                ++ noLongModifiers;
+            if(*p != 'l'  &&  *p != 'h')
+                spec[lenSpec++] = *p;
+            ++ p;
+        }
+        if(*p == '\0')
+            break;
+
+        const char conversion = *p++;
+        unsigned long value;
+        if(conversion == '%')
+        {
+            putchar('%');
+            continue;
+        }
+        else if(strchr("diouxXc", conversion) != NULL)
+        {
+            const unsigned int size = noLongModifiers > 0? 4: 2;
+            if(readArg(hLog, &value, size) != 0)
+                return -1;
+
+            spec[lenSpec++] = 'l';
+            spec[lenSpec++] = conversion;
+            spec[lenSpec] = '\0';
+            if(conversion == 'd'  ||  conversion == 'i')
+            {
+                long sValue = size == 4? (long)(value ^ 0x80000000ul) - 0x80000000l
+                                       : (long)(value ^ 0x8000ul) - 0x8000l;
+                printf(spec, sValue);
+            }
+            else if(conversion == 'c')
+                putchar((int)(value & 0xff));
+            else
+                printf(spec, value);
+        }
+        else if(strchr("eEfFgG", conversion) != NULL)
+        {
+            /* The AVR float is an IEEE 754 single precision number. */
+            float f;
+            unsigned char bytes[4];
+            if(readArg(hLog, &value, 4) != 0)
+                return -1;
+            bytes[0] = (unsigned char)value;
+            bytes[1] = (unsigned char)(value >> 8);
+            bytes[2] = (unsigned char)(value >> 16);
+            bytes[3] = (unsigned char)(value >> 24);
+            memcpy(&f, bytes, sizeof(f));
+
+            spec[lenSpec++] = conversion;
+            spec[lenSpec] = '\0';
+            printf(spec, (double)f);
+        }
+        else if(conversion == 's'  ||  conversion == 'p')
+        {
+            /* Only the RAM address of the object has been logged. */
+            if(readArg(hLog, &value, 2) != 0)
+                return -1;
+            printf("<0x%04lx>", value);
+        }
+        else
+        {
+            /* Unsupported conversion; the remainder of the record can't be decoded. */
+            printf("<bad conversion %%%c>", conversion);
+            return 0;
+        }
+    }
+
+    return 0;
+
+} /* End of renderRecord */
+
+
+
+
+/**
+ * Entry point of the decoder.
+ *   @return
+ * Get 0 on success, 1 in case of errors.
+ *   @param argc
+ * The number of command line arguments.
+ *   @param argv
+ * The command line arguments: ELF file and optional log file.
+ */
+
+int main(int argc, const char *argv[])
+{
+    if(argc < 2  ||  argc > 3)
+    {
+        fprintf(stderr, "Usage: blgDecoder <applicationElfFile> [<binaryLogFile>]\n");
+        return 1;
+    }
+
+    if(loadElfFile(argv[1]) != 0)
+        return 1;
+
+    FILE *hLog = stdin;
+    if(argc == 3)
+    {
+        hLog = fopen(argv[2], "rb");
+        if(hLog == NULL)
+        {
+            fprintf(stderr, "Can't open log file %s\n", argv[2]);
+            return 1;
+        }
+    }
+
+    int c;
+    while((c = getc(hLog)) != EOF)
+    {
+        if(c != BLG_RECORD_START)
+        {
+            /* Plain text of the application. */
+            putchar(c);
+            continue;
+        }
+
+        unsigned long address;
+        if(readArg(hLog, &address, 2) != 0)
+            break;
+
+        const char *fmtString = getFormatString(address);
+        if(fmtString == NULL)
+            printf("<unknown record 0x%04lx>\n", address);
+        else if(renderRecord(hLog, fmtString) != 0)
+            break;
+    }
+
+    if(hLog != stdin)
+        fclose(hLog);
+
+    return 0;
+
+} /* End of main */
+
+
+
+
@@ -75,6 +75,11 @@
 # format characters like %f. This reduces the size of the code by about 1.5kByte, the RAM
 # size is not affected. By default this falg is set to 1 and full support of printf & co is
 # ensured.
+#   WRAP_ARDUINO_TIME: If this flag is 1 the linker redirects the calls of the Arduino
+# library functions millis(), micros() and delay() to the substitutes implemented by
+# RTuinOS. The flag needs to be set if and only if the application configures
+# RTOS_PROVIDE_ARDUINO_TIME in its rtos.config.h; a mismatch is reported by the linker. The
+# flag is usually set in the application owned makefile fragment <applicationName>.mk.
 #
 # Input Files
 # ===========
@@ -138,7 +143,7 @@ endif
 # in this file.
 .PHONY: h help targets usage
 h help targets usage:
-	$(info Usage: make [-s] APP=<myRTuinOSApplication> [CONFIG=<configuration>] [COM_PORT=<portName>] [IO_FLOAT_LIB=1] {<target>})
+	$(info Usage: make [-s] APP=<myRTuinOSApplication> [CONFIG=<configuration>] [COM_PORT=<portName>] [IO_FLOAT_LIB=1] [WRAP_ARDUINO_TIME=1] {<target>})
 	$(info <myRTuinOSApplication> is the name of the source code folder of your application,)
 	$(info located at code/applications.)
 	$(info <configuration> is one out of DEBUG (default) or PRODUCTION.)
@@ -148,6 +153,8 @@ h help targets usage:
 	$(info The switch IO_FLOAT_LIB=1 may be used to link against the printf library with)
 	$(info floating point support. By default (IO_FLOAT_LIB=0) your application is linked)
 	$(info against the standard Arduino printf library without floating point support.)
+	$(info The switch WRAP_ARDUINO_TIME=1 is required by applications, which let RTuinOS)
+	$(info provide the Arduino time functions, see RTOS_PROVIDE_ARDUINO_TIME.)
 	$(info Available targets are:)
 	$(info   - build: Build the hex files for flashing onto the micro controller)
 	$(info   - clean: Delete all application files generated by the build process)
@@ -287,6 +294,9 @@ lFlags := -Wl,--gc-sections,--relax,--cref -mmcu=$(targetMicroController)
 ifeq ($(IO_FLOAT_LIB),1)
     lFlags += -Wl,-u,vfprintf -lprintf_flt
 endif
+ifeq ($(WRAP_ARDUINO_TIME),1)
+    lFlags += -Wl,--wrap=millis,--wrap=micros,--wrap=delay
+endif
 $(targetDir)$(project).elf: $(coreDir)core.a $(objListWithPath) 
 	$(info Linking project. Ouput is redirected to $(targetDir)$(project).map)
 	$(avr-gcc) $(lFlags) -o $@ -Wl,--start-group $^ -Wl,--end-group -lm   		        \